@@ -22,6 +22,8 @@
 
 #include <unistd.h>
 
+#include <algorithm>
+#include <cerrno>
 #include <iostream>
 #include <thread>
 
@@ -34,6 +36,17 @@ namespace finalcut
 // class EventLoop
 //----------------------------------------------------------------------
 
+// destructor
+//----------------------------------------------------------------------
+EventLoop::~EventLoop() noexcept  // destructor
+{
+#if defined(USE_EPOLL)
+  if ( epoll_fd != -1 )
+    ::close(epoll_fd);
+#endif
+}
+
+
 // public methods of EventLoop
 //----------------------------------------------------------------------
 auto EventLoop::run() -> int
@@ -49,6 +62,20 @@ auto EventLoop::run() -> int
   return 0;
 }
 
+//----------------------------------------------------------------------
+auto EventLoop::processEvents (int timeout) -> bool
+{
+  // Waits up to timeout milliseconds for events of the active monitors
+  // and dispatches them once. This allows an external main loop to
+  // wait for its own file descriptors and the monitors together.
+
+  const bool was_running = running;
+  running = true;
+  const bool result = processNextEvents(timeout);
+  running = was_running && running;
+  return result;
+}
+
 
 // private methods of EventLoop
 //----------------------------------------------------------------------
@@ -59,43 +86,58 @@ inline void EventLoop::nonPollWaiting() const
 }
 
 //----------------------------------------------------------------------
-inline auto EventLoop::processNextEvents() -> bool
+inline auto EventLoop::processNextEvents (int timeout) -> bool
 {
-  nfds_t fd_count = 0;
   monitors_changed = false;
+  applyMonitorChanges();
 
-  for (Monitor* monitor : monitors)
-  {
-    if ( monitor->isActive() )
-    {
-      fds[fd_count] = { monitor->getFileDescriptor(), monitor->getEvents(), 0 };
-      lookup_table[fd_count] = monitor;
-      fd_count++;
-    }
+#if defined(USE_EPOLL)
+  if ( epoll_count == 0 && fds.empty() )
+    return false;
+#else
+  if ( fds.empty() )
+    return false;
+#endif
 
-    if ( fd_count >= MAX_MONITORS )
-      break;
-  }
+  const int wait_result = waitForEvents(timeout);
 
-  if ( fd_count == 0 )
+  if ( wait_result <= 0 )
     return false;
 
-  int poll_result{};
+#if defined(USE_EPOLL)
+  if ( fds.empty() )
+  {
+    // Dispatch events waiting in epoll_events
+    dispatchEpollEvents(wait_result);
+    return true;
+  }
+#endif
+
+  // Dispatch events waiting in fds
+  dispatcher(wait_result, nfds_t(fds.size()));
+  return true;
+}
+
+//----------------------------------------------------------------------
+inline auto EventLoop::waitForEvents (int timeout) -> int
+{
+  int wait_result{};
 
   while ( true )
   {
-    poll_result = poll(fds.data(), fd_count, WAIT_INDEFINITELY);
+#if defined(USE_EPOLL)
+    if ( fds.empty() )
+      wait_result = ::epoll_wait ( epoll_fd, epoll_events.data()
+                                 , int(epoll_events.size()), timeout );
+    else
+#endif
+      wait_result = ::poll(fds.data(), nfds_t(fds.size()), timeout);
 
-    if ( poll_result != -1 || errno != EINTR )
+    if ( wait_result != -1 || errno != EINTR )
       break;
   }
 
-  if ( poll_result <= 0 )
-    return false;
-
-  // Dispatch events waiting in fds
-  dispatcher(poll_result, fd_count);
-  return true;
+  return wait_result;
 }
 
 //----------------------------------------------------------------------
@@ -108,20 +150,39 @@ inline void EventLoop::dispatcher (int poll_result, nfds_t fd_count)
   {
     const pollfd& current_fd = fds[index];
 
-    if ( current_fd.revents == 0
-      || ! (current_fd.revents & current_fd.events) )
+    if ( current_fd.revents == 0 )
       continue;
 
-    // Call the event handler for current_fd
-    lookup_table[index]->trigger(current_fd.revents);
     ++processed_fds;
 
+#if defined(USE_EPOLL)
+    if ( ! lookup_table[index] )
+    {
+      // The epoll file descriptor has events for registered monitors
+      const int epoll_result = ::epoll_wait ( epoll_fd, epoll_events.data()
+                                            , int(epoll_events.size()), 0 );
+
+      if ( epoll_result > 0 && ! dispatchEpollEvents(epoll_result) )
+        break;
+    }
+    else
+#endif
+      // Call the event handler for current_fd
+      triggerMonitor (lookup_table[index], current_fd.revents);
+
     if ( monitors_changed || ! running
       || int(processed_fds) == poll_result )
       break;
   }
 }
 
+//----------------------------------------------------------------------
+inline void EventLoop::triggerMonitor (Monitor* monitor, short revents) const
+{
+  if ( monitor->isActive() && (revents & monitor->getEvents()) )
+    monitor->trigger(revents);
+}
+
 //----------------------------------------------------------------------
 void EventLoop::addMonitor (Monitor* monitor)
 {
@@ -133,7 +194,194 @@ void EventLoop::addMonitor (Monitor* monitor)
 void EventLoop::removeMonitor (Monitor* monitor)
 {
   monitors.remove(monitor);
+
+  if ( monitor->change_pending )
+  {
+    changed_monitors.erase ( std::remove( changed_monitors.begin()
+                                        , changed_monitors.end()
+                                        , monitor )
+                           , changed_monitors.end() );
+    monitor->change_pending = false;
+  }
+
+#if defined(USE_EPOLL)
+  if ( monitor->registered_fd != Monitor::NO_FILE_DESCRIPTOR )
+    unregisterMonitor(monitor);
+#endif
+
+  if ( monitor->use_poll )
+  {
+    monitor->use_poll = false;
+    poll_set_changed = true;
+  }
+
   monitors_changed = true;
 }
 
+//----------------------------------------------------------------------
+void EventLoop::updateMonitor (Monitor* monitor)
+{
+  // Remembers a monitor whose state has changed
+
+  monitor->change_pending = true;
+  changed_monitors.push_back(monitor);
+}
+
+//----------------------------------------------------------------------
+inline void EventLoop::applyMonitorChanges()
+{
+  // Only monitors that have changed since the last wait are updated
+
+  for (Monitor* monitor : changed_monitors)
+  {
+    monitor->change_pending = false;
+    applyMonitorChange(monitor);
+  }
+
+  changed_monitors.clear();
+
+  if ( poll_set_changed )
+    rebuildPollSet();
+}
+
+//----------------------------------------------------------------------
+void EventLoop::applyMonitorChange (Monitor* monitor)
+{
+#if defined(USE_EPOLL)
+  const bool wanted = monitor->isActive()
+                   && monitor->getFileDescriptor() != Monitor::NO_FILE_DESCRIPTOR;
+
+  if ( monitor->registered_fd != Monitor::NO_FILE_DESCRIPTOR )
+  {
+    if ( wanted
+      && monitor->registered_fd == monitor->getFileDescriptor()
+      && monitor->registered_events == monitor->getEvents() )
+      return;  // Registration is up to date
+
+    unregisterMonitor(monitor);
+  }
+
+  if ( monitor->use_poll )
+  {
+    monitor->use_poll = false;
+    poll_set_changed = true;
+  }
+
+  if ( wanted && ! registerMonitor(monitor) )
+  {
+    // Fallback to poll() (e.g. for regular files)
+    monitor->use_poll = true;
+    poll_set_changed = true;
+  }
+#else
+  monitor->use_poll = monitor->isActive();
+  poll_set_changed = true;
+#endif
+}
+
+//----------------------------------------------------------------------
+void EventLoop::rebuildPollSet()
+{
+  fds.clear();
+  lookup_table.clear();
+  poll_set_changed = false;
+
+#if defined(USE_EPOLL)
+  const auto has_poll_monitor = std::any_of ( monitors.cbegin()
+                                            , monitors.cend()
+                                            , [] (const Monitor* monitor)
+                                              {
+                                                return monitor->use_poll;
+                                              } );
+
+  if ( ! has_poll_monitor )
+    return;
+
+  if ( epoll_count > 0 )
+  {
+    // The epoll file descriptor becomes readable
+    // when a registered monitor has an event
+    fds.push_back({ epoll_fd, POLLIN, 0 });
+    lookup_table.push_back(nullptr);
+  }
+#endif
+
+  for (Monitor* monitor : monitors)
+  {
+    if ( ! monitor->use_poll )
+      continue;
+
+    fds.push_back({ monitor->getFileDescriptor(), monitor->getEvents(), 0 });
+    lookup_table.push_back(monitor);
+  }
+}
+
+#if defined(USE_EPOLL)
+//----------------------------------------------------------------------
+auto EventLoop::registerMonitor (Monitor* monitor) -> bool
+{
+  // Registers the file descriptor of the monitor persistently
+  // in the epoll instance
+
+  if ( epoll_fd == -1 )
+    epoll_fd = ::epoll_create1(EPOLL_CLOEXEC);
+
+  if ( epoll_fd == -1 )
+    return false;
+
+  // The poll event bits have the same values as the epoll event bits
+  struct epoll_event event{};
+  event.events = uint32_t(static_cast<unsigned short>(monitor->getEvents()));
+  event.data.ptr = monitor;
+
+  if ( ::epoll_ctl ( epoll_fd, EPOLL_CTL_ADD
+                   , monitor->getFileDescriptor(), &event ) != 0 )
+    return false;  // Regular file or file descriptor already registered
+
+  monitor->registered_fd = monitor->getFileDescriptor();
+  monitor->registered_events = monitor->getEvents();
+  epoll_count++;
+
+  if ( epoll_events.size() < epoll_count )
+    epoll_events.resize(epoll_count);
+
+  if ( epoll_count == 1 )
+    poll_set_changed = true;
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void EventLoop::unregisterMonitor (Monitor* monitor)
+{
+  // The file descriptor may already be closed
+  struct epoll_event event{};
+  ::epoll_ctl (epoll_fd, EPOLL_CTL_DEL, monitor->registered_fd, &event);
+  monitor->registered_fd = Monitor::NO_FILE_DESCRIPTOR;
+  monitor->registered_events = 0;
+  epoll_count--;
+
+  if ( epoll_count == 0 )
+    poll_set_changed = true;
+}
+
+//----------------------------------------------------------------------
+auto EventLoop::dispatchEpollEvents (int event_count) -> bool
+{
+  // Dispatching events that are waiting in epoll_events
+
+  for (int index{0}; index < event_count; index++)
+  {
+    const auto& event = epoll_events[std::size_t(index)];
+    auto monitor = static_cast<Monitor*>(event.data.ptr);
+    triggerMonitor (monitor, short(event.events & 0xffff));
+
+    if ( monitors_changed || ! running )
+      return false;
+  }
+
+  return true;
+}
+#endif  // defined(USE_EPOLL)
+
 }  // namespace finalcut
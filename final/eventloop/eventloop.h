@@ -31,9 +31,15 @@
 #ifndef EVENTLOOP_H
 #define EVENTLOOP_H
 
-#include <list>
+#if defined(__linux__)
+  #define USE_EPOLL
+  #include <sys/epoll.h>
+#endif
+
 #include <poll.h>
-#include <array>
+
+#include <list>
+#include <vector>
 
 #include "final/eventloop/monitor.h"
 #include "final/util/fstring.h"
@@ -51,31 +57,64 @@ class EventLoop
     // Constructor
     EventLoop() = default;
 
+    // Disable copy constructor
+    EventLoop (const EventLoop&) = delete;
+
+    // Disable move constructor
+    EventLoop (EventLoop&&) noexcept = delete;
+
+    // Destructor
+    ~EventLoop() noexcept;
+
+    // Disable copy assignment operator (=)
+    auto operator = (const EventLoop&) -> EventLoop& = delete;
+
+    // Disable move assignment operator (=)
+    auto operator = (EventLoop&&) noexcept -> EventLoop& = delete;
+
     // Accessor
     auto getClassName() const -> FString;
 
     // Methods
     auto run() -> int;
     void leave();
+    auto processEvents (int) -> bool;
 
-  private:
-    // Constants
-    static constexpr nfds_t MAX_MONITORS{50};
+    // Constant
     static constexpr int WAIT_INDEFINITELY{-1};
 
+  private:
     // Methods
     void nonPollWaiting() const;
-    auto processNextEvents() -> bool;
+    auto processNextEvents (int = WAIT_INDEFINITELY) -> bool;
+    auto waitForEvents (int) -> int;
     void dispatcher (int, nfds_t);
+    void triggerMonitor (Monitor*, short) const;
     void addMonitor (Monitor*);
     void removeMonitor (Monitor*);
+    void updateMonitor (Monitor*);
+    void applyMonitorChanges();
+    void applyMonitorChange (Monitor*);
+    void rebuildPollSet();
+#if defined(USE_EPOLL)
+    auto registerMonitor (Monitor*) -> bool;
+    void unregisterMonitor (Monitor*);
+    auto dispatchEpollEvents (int) -> bool;
+#endif
 
     // Data members
     bool running{false};
     bool monitors_changed{false};
-    std::list<Monitor*>  monitors{};
-    std::array<struct pollfd, MAX_MONITORS> fds{};
-    std::array<Monitor*, MAX_MONITORS>      lookup_table{};
+    bool poll_set_changed{false};
+    std::list<Monitor*>         monitors{};
+    std::vector<Monitor*>       changed_monitors{};
+    std::vector<struct pollfd>  fds{};
+    std::vector<Monitor*>       lookup_table{};
+#if defined(USE_EPOLL)
+    int                             epoll_fd{-1};
+    std::size_t                     epoll_count{0};
+    std::vector<struct epoll_event> epoll_events{};
+#endif
 
     // Friend classes
     friend class Monitor;
@@ -52,4 +52,16 @@ Monitor::~Monitor()  // destructor
     eventloop->removeMonitor(this);
 }
 
+
+// private methods of Monitor
+//----------------------------------------------------------------------
+void Monitor::notifyEventLoop()
+{
+  // The event loop updates its registration of this monitor
+  // before the next wait
+
+  if ( eventloop && ! change_pending )
+    eventloop->updateMonitor(this);
+}
+
 }  // namespace finalcut
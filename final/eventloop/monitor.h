@@ -136,6 +136,9 @@ class Monitor
     // Using-declaration
     using FDataAccessPtr = std::shared_ptr<FDataAccess>;
 
+    // Method
+    void         notifyEventLoop();
+
     // Data member
     bool           active{false};
     EventLoop*     eventloop{};
@@ -145,6 +148,12 @@ class Monitor
     FDataAccessPtr user_context{nullptr};
     bool           monitor_initialized{false};
 
+    // Registration state maintained by the event loop
+    int            registered_fd{NO_FILE_DESCRIPTOR};
+    short          registered_events{0};
+    bool           change_pending{false};
+    bool           use_poll{false};
+
     // Friend classes
     friend class EventLoop;
 };
@@ -178,11 +187,17 @@ inline auto Monitor::isActive() const -> bool
 
 //----------------------------------------------------------------------
 inline void Monitor::resume()
-{ active = true; }
+{
+  active = true;
+  notifyEventLoop();
+}
 
 //----------------------------------------------------------------------
 inline void Monitor::suspend()
-{ active = false; }
+{
+  active = false;
+  notifyEventLoop();
+}
 
 //----------------------------------------------------------------------
 inline void Monitor::trigger (short return_events)
@@ -193,11 +208,17 @@ inline void Monitor::trigger (short return_events)
 
 //----------------------------------------------------------------------
 inline void Monitor::setFileDescriptor (int file_descriptor)
-{ fd = file_descriptor; }
+{
+  fd = file_descriptor;
+  notifyEventLoop();
+}
 
 //----------------------------------------------------------------------
 inline void Monitor::setEvents (short ev)
-{ events = ev; }
+{
+  events = ev;
+  notifyEventLoop();
+}
 
 //----------------------------------------------------------------------
 inline void Monitor::setHandler (handler_t&& hdl)
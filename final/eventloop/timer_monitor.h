@@ -23,24 +23,24 @@
 /*  Inheritance diagram
  *  ═══════════════════
  *
- *                          ▕▔▔▔▔▔▔▔▔▔▏
- *                          ▕ Monitor ▏
- *                          ▕▁▁▁▁▁▁▁▁▁▏
- *                               ▲
- *                               │
- *                      ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
- *                      ▕ TimerMonitorImpl ▏
- *                      ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
- *                        ▲              ▲
- *                        │              │
- * ▕▔▔▔▔▔▔▔▔▔▔▏1   1▕▔▔▔▔▔▔▔▔▔▔▔▔▏ ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
- * ▕ PipeData ▏- - -▕ PosixTimer ▏ ▕ KqueueTimer ▏ (platform-specific)
- * ▕▁▁▁▁▁▁▁▁▁▁▏     ▕▁▁▁▁▁▁▁▁▁▁▁▁▏ ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
- *                           ▲         ▲
- *                           │         │
- *                         ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
- *                         ▕ TimerMonitor ▏
- *                         ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *                                  ▕▔▔▔▔▔▔▔▔▔▏
+ *                                  ▕ Monitor ▏
+ *                                  ▕▁▁▁▁▁▁▁▁▁▏
+ *                                       ▲
+ *                                       │
+ *                              ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *                              ▕ TimerMonitorImpl ▏
+ *                              ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *                          ▲            ▲            ▲
+ *                          │            │            │
+ * ▕▔▔▔▔▔▔▔▔▔▔▏1   1▕▔▔▔▔▔▔▔▔▔▔▔▔▏ ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏ ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ PipeData ▏- - -▕ PosixTimer ▏ ▕ TimerFdTimer ▏ ▕ KqueueTimer ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▏     ▕▁▁▁▁▁▁▁▁▁▁▁▁▏ ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏ ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *                          ▲            ▲            ▲
+ *                          │            │            │  (platform-specific)
+ *                                 ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *                                 ▕ TimerMonitor ▏
+ *                                 ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  */
 
 #ifndef TIMER_MONITOR_H
@@ -55,6 +55,10 @@
   #define USE_POSIX_TIMER
 #endif
 
+#if defined(__linux__)
+  #define USE_TIMERFD_TIMER
+#endif
+
 #include <ctime>
 
 #include <chrono>
@@ -151,6 +155,60 @@ inline void PosixTimer::init (handler_t hdl, T&& uc)
 #endif  // defined(USE_POSIX_TIMER)
 
 
+//----------------------------------------------------------------------
+// class TimerFdTimer
+//----------------------------------------------------------------------
+
+class TimerFdTimer : public TimerMonitorImpl
+{
+  public:
+    // Using-declaration
+    using TimerMonitorImpl::TimerMonitorImpl;
+
+    // Constructor
+    explicit TimerFdTimer (EventLoop*);
+
+    // Disable copy constructor
+    TimerFdTimer (const TimerFdTimer&) = delete;
+
+    // Disable move constructor
+    TimerFdTimer (TimerFdTimer&&) noexcept = delete;
+
+    // Destructor
+    ~TimerFdTimer() noexcept override;
+
+    // Disable copy assignment operator (=)
+    auto operator = (const TimerFdTimer&) -> TimerFdTimer& = delete;
+
+    // Disable move assignment operator (=)
+    auto operator = (TimerFdTimer&&) noexcept -> TimerFdTimer& = delete;
+
+    // Methods
+    template <typename T>
+    void init (handler_t, T&&);
+    void setInterval ( std::chrono::nanoseconds
+                     , std::chrono::nanoseconds ) override;
+    void trigger(short) override;
+
+  private:
+    void init();
+};
+
+#if defined(USE_TIMERFD_TIMER)
+//----------------------------------------------------------------------
+template <typename T>
+inline void TimerFdTimer::init (handler_t hdl, T&& uc)
+{
+  if ( isInitialized() )
+    throw monitor_error{"This instance has already been initialised."};
+
+  setHandler (std::move(hdl));
+  setUserContext (std::forward<T>(uc));
+  init();
+}
+#endif  // defined(USE_TIMERFD_TIMER)
+
+
 //----------------------------------------------------------------------
 // class KqueueTimer
 //----------------------------------------------------------------------
@@ -236,6 +294,8 @@ struct TimerClass
     using type = KqueueTimer;
   #elif defined(__OpenBSD__)
     using type = KqueueTimer;
+  #elif defined(__linux__)
+    using type = TimerFdTimer;
   #else
     using type = PosixTimer;
   #endif
@@ -0,0 +1,120 @@
+/***********************************************************************
+* timerfd_timer.cpp - Time monitoring object with a Linux timerfd      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#if defined(__linux__)
+  #define USE_TIMERFD_TIMER
+#endif
+
+#if defined(USE_TIMERFD_TIMER)
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <system_error>
+
+#include "final/eventloop/eventloop.h"
+#include "final/eventloop/timer_monitor.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+static auto nanosecondsToTimespec (std::chrono::nanoseconds duration) -> timespec
+{
+  const auto seconds{std::chrono::duration_cast<std::chrono::seconds>(duration)};
+  duration -= seconds;
+
+  return timespec{ static_cast<time_t>(seconds.count())
+                 , static_cast<long>(duration.count()) };
+}
+
+
+//----------------------------------------------------------------------
+// class TimerFdTimer
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+TimerFdTimer::TimerFdTimer (EventLoop* eloop)
+  : TimerMonitorImpl(eloop)
+{ }
+
+//----------------------------------------------------------------------
+TimerFdTimer::~TimerFdTimer() noexcept  // destructor
+{
+  if ( getFileDescriptor() != NO_FILE_DESCRIPTOR )
+    ::close (getFileDescriptor());
+}
+
+
+// public methods of TimerFdTimer
+//----------------------------------------------------------------------
+void TimerFdTimer::setInterval ( std::chrono::nanoseconds first,
+                                 std::chrono::nanoseconds periodic )
+{
+  struct itimerspec timer_spec { nanosecondsToTimespec(periodic)
+                               , nanosecondsToTimespec(first) };
+
+  if ( ::timerfd_settime(getFileDescriptor(), 0, &timer_spec, nullptr) != -1 )
+    return;
+
+  const int error = errno;
+  std::error_code err_code{error, std::generic_category()};
+  std::system_error sys_err{err_code, strerror(error)};
+  throw sys_err;
+}
+
+//----------------------------------------------------------------------
+void TimerFdTimer::trigger (short return_events)
+{
+  // Reading resets the number of expirations
+  uint64_t expirations{0};
+
+  if ( ::read(getFileDescriptor(), &expirations, sizeof(expirations)) <= 0 )
+    return;  // Timer was rearmed in the meantime
+
+  Monitor::trigger(return_events);
+}
+
+// private methods of TimerFdTimer
+//----------------------------------------------------------------------
+void TimerFdTimer::init()
+{
+  // The expirations are delivered directly through a file descriptor
+  // without a signal handler and a pipe
+  const int timer_fd = ::timerfd_create ( CLOCK_MONOTONIC
+                                        , TFD_NONBLOCK | TFD_CLOEXEC );
+
+  if ( timer_fd == -1 )
+    throw monitor_error{"No timerfd timer could be created."};
+
+  setFileDescriptor (timer_fd);
+  setEvents (POLLIN);
+  setInitialized();
+}
+
+}  // namespace finalcut
+
+#endif  // defined(USE_TIMERFD_TIMER)
@@ -20,15 +20,19 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <algorithm>
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <string>
 #include <thread>
 
 #include "final/dialog/fmessagebox.h"
+#include "final/eventloop/eventloop.h"
+#include "final/eventloop/io_monitor.h"
 #include "final/fapplication.h"
 #include "final/fevent.h"
 #include "final/fstartoptions.h"
@@ -36,6 +40,7 @@
 #include "final/input/fmouse.h"
 #include "final/menu/fmenubar.h"
 #include "final/menu/fmenu.h"
+#include "final/output/tty/fterm.h"
 #include "final/output/tty/ftermdata.h"
 #include "final/output/tty/ftermios.h"
 #include "final/output/tty/ftermxterminal.h"
@@ -151,6 +156,16 @@ auto FApplication::getLog() -> FLogPtr&
   return *logger;
 }
 
+//----------------------------------------------------------------------
+auto FApplication::getEventLoop() -> EventLoop&
+{
+  // The monitors of this event loop are polled in the application
+  // main loop together with the terminal input
+
+  static EventLoop event_loop{};
+  return event_loop;
+}
+
 //----------------------------------------------------------------------
 void FApplication::setLog (const FLogPtr& log)
 {
@@ -199,6 +214,9 @@ auto FApplication::enterLoop() -> int  // event loop
   const bool old_app_exit_loop = internal::var::exit_loop;
   internal::var::exit_loop = false;
 
+  if ( ! input_monitor )
+    initEventMonitors();
+
   while ( ! (quit_now || internal::var::exit_loop) )
     processNextEvent();
 
@@ -421,14 +439,17 @@ void FApplication::init()
   auto cmd2 = [this] () { this->keyReleased(); };
   auto cmd3 = [this] () { this->escapeKeyPressed(); };
   auto cmd4 = [this] () { this->mouseTracking(); };
+  auto cmd_paste = [this] () { this->textPasted(); };
   FKeyboardCommand key_cmd1 (cmd1);
   FKeyboardCommand key_cmd2 (cmd2);
   FKeyboardCommand key_cmd3 (cmd3);
   FKeyboardCommand key_cmd4 (cmd4);
+  FKeyboardCommand paste_cmd (cmd_paste);
   keyboard.setPressCommand (key_cmd1);
   keyboard.setReleaseCommand (key_cmd2);
   keyboard.setEscPressedCommand (key_cmd3);
   keyboard.setMouseTrackingCommand (key_cmd4);
+  keyboard.setPasteCommand (paste_cmd);
   // Set the keyboard keypress timeout
   keyboard.setKeypressTimeout (key_timeout);
 
@@ -453,6 +474,7 @@ void FApplication::init()
   registerMouseHandler (FApplication::determineClickedWidget);
   registerMouseHandler (FApplication::determineWheelWidget);
   registerMouseHandler (FApplication::unsetMoveResizeMode);
+  registerMouseHandler (FApplication::setMoveCoalescing);
 
   // Initialize logging
   if ( ! getStartOptions().logfile_stream.is_open() )
@@ -497,6 +519,8 @@ inline auto FApplication::getLongOptions() -> const std::vector<CmdOption>&
     {"no-terminal-focus-events", no_argument,       nullptr,  'f' },
     {"no-color-change",          no_argument,       nullptr,  'c' },
     {"no-sgr-optimizer",         no_argument,       nullptr,  's' },
+    {"no-synchronized-output",   no_argument,       nullptr,  'S' },
+    {"no-keyboard-protocol",     no_argument,       nullptr,  'k' },
     {"vgafont",                  no_argument,       nullptr,  'v' },
     {"newfont",                  no_argument,       nullptr,  'n' },
     {"dark-theme",               no_argument,       nullptr,  't' },
@@ -538,6 +562,10 @@ inline void FApplication::setCmdOptionsMap (CmdMap& cmd_map)
   cmd_map['c'] = [opt] (const auto&) { opt().color_change = false; };
   // --no-sgr-optimizer
   cmd_map['s'] = [opt] (const auto&) { opt().sgr_optimizer = false; };
+  // --no-synchronized-output
+  cmd_map['S'] = [opt] (const auto&) { opt().synchronized_output = false; };
+  // --no-keyboard-protocol
+  cmd_map['k'] = [opt] (const auto&) { opt().keyboard_protocol = false; };
   // --vgafont
   cmd_map['v'] = [opt] (const auto&) { opt().vgafont = true; };
   // --newfont
@@ -630,6 +658,10 @@ void FApplication::showParameterUsage()
     << "    Do not redefine the color palette\n"
     << "  --no-sgr-optimizer        "
     << "    Do not optimize SGR sequences\n"
+    << "  --no-synchronized-output  "
+    << "    Do not bracket screen updates with DEC mode 2026\n"
+    << "  --no-keyboard-protocol    "
+    << "    Do not use the progressive keyboard enhancement\n"
     << "  --vgafont                 "
     << "    Set the standard vga 8x16 font\n"
     << "  --newfont                 "
@@ -723,6 +755,12 @@ void FApplication::mouseTracking() const
   performMouseAction();
 }
 
+//----------------------------------------------------------------------
+void FApplication::textPasted() const
+{
+  performPasteAction();
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::performKeyboardAction()
 {
@@ -771,6 +809,20 @@ inline void FApplication::performMouseAction() const
   queuingMouseInput();
 }
 
+//----------------------------------------------------------------------
+inline void FApplication::performPasteAction() const
+{
+  static const auto& keyboard = FKeyboard::getInstance();
+  const FString text{keyboard.getPasteText()};
+
+  if ( text.isEmpty() )
+    return;
+
+  // Widgets without paste support receive the text as single keys
+  if ( ! sendPasteEvent (keyboard_widget, text) )
+    sendPasteKeyEvents (keyboard_widget, text);
+}
+
 //----------------------------------------------------------------------
 void FApplication::mouseEvent (const FMouseData& md) const
 {
@@ -819,6 +871,37 @@ inline auto FApplication::sendKeyUpEvent (FWidget* widget) const -> bool
   return k_up_ev.isAccepted();
 }
 
+//----------------------------------------------------------------------
+inline auto FApplication::sendPasteEvent ( FWidget* widget
+                                         , const FString& text ) const -> bool
+{
+  // Send paste event
+  FPasteEvent paste_ev (Event::Paste, text);
+  sendEvent (widget, &paste_ev);
+  return paste_ev.isAccepted();
+}
+
+//----------------------------------------------------------------------
+void FApplication::sendPasteKeyEvents ( FWidget* widget
+                                      , const FString& text ) const
+{
+  // Send the pasted text character by character as key events
+
+  for (const auto& ch : text)
+  {
+    if ( quit_now || internal::var::exit_loop )
+      return;
+
+    const auto key = ( ch == 127 ) ? FKey::Backspace : FKey(ch);
+    FKeyEvent k_down_ev (Event::KeyDown, key);
+    sendEvent (widget, &k_down_ev);
+    FKeyEvent k_press_ev (Event::KeyPress, key);
+    sendEvent (widget, &k_press_ev);
+    FKeyEvent k_up_ev (Event::KeyUp, key);
+    sendEvent (widget, &k_up_ev);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FApplication::sendKeyboardAccelerator() const
 {
@@ -863,7 +946,9 @@ void FApplication::queuingKeyboardInput() const
   keyboard.escapeKeyHandling();  // special case: Esc key
   keyboard.clearKeyBufferOnTimeout();
 
-  if ( isKeyPressed() )
+  // With event monitors, poll() has already waited for the input,
+  // so that it is read here without blocking
+  if ( input_monitor || isKeyPressed() )
     keyboard.fetchKeyCode();
 }
 
@@ -1088,6 +1173,17 @@ void FApplication::unsetMoveResizeMode (const FMouseData&)
   w->redraw();
 }
 
+//----------------------------------------------------------------------
+void FApplication::setMoveCoalescing (const FMouseData&)
+{
+  // Mouse moves are sent to the clicked widget. A widget that
+  // needs every mouse position can switch off the coalescing.
+
+  static auto& mouse = FMouseControl::getInstance();
+  const auto widget = FWidget::getClickedWidget();
+  mouse.setMoveCoalescing (! widget || widget->hasMoveCoalescing());
+}
+
 //----------------------------------------------------------------------
 void FApplication::sendMouseEvent (const FMouseData& md) const
 {
@@ -1370,12 +1466,28 @@ void FApplication::processLogger() const
   logger->flush();
 }
 
+//----------------------------------------------------------------------
+void FApplication::processPendingOutput()
+{
+  // Continues writing output that the terminal could not yet accept
+
+  auto foutput_ptr = FVTerm::getFOutput();
+
+  if ( foutput_ptr->hasPendingOutput() )
+    foutput_ptr->flushPendingOutput();
+
+  // The frame pacing uses one backlog sample per event loop pass
+  foutput_ptr->measureOutputBacklog();
+}
+
 //----------------------------------------------------------------------
 auto FApplication::processNextEvent() -> bool
 {
   uInt num_events{0};
+  processPendingOutput();
 
-  if ( hasDataInQueue() || hasTerminalResized() || isNextEventTimeout() )
+  if ( hasDataInQueue() || hasTerminalResized()
+    || hasPendingUpdates() || isNextEventTimeout() )
   {
     time_last_event = FObjectTimer::getCurrentTime();
     num_events += processTimerEvent();
@@ -1384,11 +1496,12 @@ auto FApplication::processNextEvent() -> bool
     processCloseWidget();
     sendQueuedEvents();
     processDialogResizeMove();
+    processUpdates();  // Paint widgets invalidated by update()
     processTerminalUpdate();  // for changed areas on the terminal
     flush();  // Flush output buffer (via an instance of FOutput)
     processLogger();
   }
-  else if ( isKeyPressed(next_event_wait) )
+  else if ( waitForNextEvent() )
   {
     time_last_event = TimeValue{};
   }
@@ -1397,6 +1510,94 @@ auto FApplication::processNextEvent() -> bool
   return ( num_events > 0 );
 }
 
+//----------------------------------------------------------------------
+void FApplication::initEventMonitors()
+{
+  // Terminal input, signals and writable output wake up the main loop
+
+  static auto& mouse = FMouseControl::getInstance();
+
+  if ( mouse.isGpmMouseEnabled() )  // GPM waits with its own select()
+    return;
+
+  auto& event_loop = getEventLoop();
+  auto wake_up = [] (const Monitor*, short) { };  // Nothing more to do
+  input_monitor = std::make_unique<IoMonitor>(&event_loop);
+  input_monitor->init (FTermios::getStdIn(), POLLIN, wake_up, nullptr);
+  input_monitor->resume();
+  output_monitor = std::make_unique<IoMonitor>(&event_loop);
+  output_monitor->init (FTermios::getStdOut(), POLLOUT, wake_up, nullptr);
+  const int signal_fd = FTerm::getSignalFileDescriptor();
+
+  if ( signal_fd == -1 )
+    return;
+
+  signal_monitor = std::make_unique<IoMonitor>(&event_loop);
+  signal_monitor->init ( signal_fd, POLLIN
+                       , [] (const Monitor*, short)
+                         {
+                           FTerm::clearSignalNotification();
+                         }
+                       , nullptr );
+  signal_monitor->resume();
+}
+
+//----------------------------------------------------------------------
+auto FApplication::getNextEventWaitTime() const -> int
+{
+  // Returns the time in milliseconds until the next timer expires
+  // or the next terminal flush is due
+
+  static const auto& keyboard = FKeyboard::getInstance();
+
+  if ( keyboard.hasPendingInput() )
+    return 0;
+
+  const auto now = FObjectTimer::getCurrentTime();
+  auto deadline = std::min ( FObjectTimer::getNextTimeout()
+                           , FVTerm::getFOutput()->getFlushDeadline() );
+
+  // Incomplete key sequences and queued events
+  if ( keyboard.hasUnprocessedInput() || eventInQueue() )
+    deadline = now;
+
+  if ( deadline == TimeValue::max() )  // Nothing to do
+    return EventLoop::WAIT_INDEFINITELY;
+
+  // Limits the event processing to the rate of next_event_wait
+  deadline = std::max ( deadline
+                      , time_last_event + std::chrono::microseconds(next_event_wait) );
+
+  if ( deadline <= now )
+    return 0;
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  const int64_t usec = duration_cast<microseconds>(deadline - now).count();
+  const int64_t msec = (usec + 999) / 1000;  // Round up
+  return int(std::min(msec, int64_t(std::numeric_limits<int>::max())));
+}
+
+//----------------------------------------------------------------------
+auto FApplication::waitForNextEvent() -> bool
+{
+  // Sleeps until input arrives, a signal is received, a monitor
+  // of the event loop becomes ready, a timer expires or the
+  // terminal output has to be flushed
+
+  if ( ! input_monitor )
+    return isKeyPressed(next_event_wait);
+
+  // Waiting for a writable terminal if output is still pending
+  if ( FVTerm::getFOutput()->hasPendingOutput() )
+    output_monitor->resume();
+  else
+    output_monitor->suspend();
+
+  getEventLoop().processEvents(getNextEventWaitTime());
+  return true;
+}
+
 //----------------------------------------------------------------------
 void FApplication::performTimerAction (FObject* receiver, FEvent* event)
 {
@@ -1411,6 +1612,12 @@ inline auto FApplication::hasTerminalResized() -> bool
   return has_terminal_resized;
 }
 
+//----------------------------------------------------------------------
+inline auto FApplication::hasPendingUpdates() -> bool
+{
+  return getWidgetUpdateList() && ! getWidgetUpdateList()->empty();
+}
+
 //----------------------------------------------------------------------
 auto FApplication::isEventProcessable ( FObject* receiver
                                       , const FEvent* event ) -> bool
@@ -1431,11 +1638,12 @@ auto FApplication::isEventProcessable ( FObject* receiver
       && ! window->getFlags().visibility.modal
       && ! window->isMenuWidget() )
     {
-      constexpr std::array<const Event, 13> blocked_events
+      constexpr std::array<const Event, 14> blocked_events
       {{
         Event::KeyPress,
         Event::KeyUp,
         Event::KeyDown,
+        Event::Paste,
         Event::MouseDown,
         Event::MouseUp,
         Event::MouseDoubleClick,
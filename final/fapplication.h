@@ -74,11 +74,13 @@ namespace finalcut
 {
 
 // class forward declaration
+class EventLoop;
 class FAccelEvent;
 class FCloseEvent;
 class FEvent;
 class FFocusEvent;
 class FKeyEvent;
+class IoMonitor;
 class FLog;
 class FMouseData;
 class FMouseEvent;
@@ -125,6 +127,7 @@ class FApplication : public FWidget
     static auto  getApplicationObject() -> FApplication*;
     static auto  getKeyboardWidget() -> FWidget*;
     static auto  getLog() -> FLogPtr&;
+    static auto  getEventLoop() -> EventLoop&;
 
     // Mutator
     static void  setLog (const FLogPtr&);
@@ -167,6 +170,7 @@ class FApplication : public FWidget
     using FEventQueue = std::deque<EventPair>;
     using FMouseHandlerList = std::vector<FMouseHandler>;
     using CmdMap = std::unordered_map<int, std::function<void(char*)>>;
+    using IoMonitorPtr = std::unique_ptr<IoMonitor>;
 
     // Methods
     void         init();
@@ -183,13 +187,17 @@ class FApplication : public FWidget
     void         keyReleased() const;
     void         escapeKeyPressed() const;
     void         mouseTracking() const;
+    void         textPasted() const;
     void         performKeyboardAction();
     void         performMouseAction() const;
+    void         performPasteAction() const;
     void         mouseEvent (const FMouseData&) const;
     void         sendEscapeKeyPressEvent() const;
     auto         sendKeyDownEvent (FWidget*) const -> bool;
     auto         sendKeyPressEvent (FWidget*) const -> bool;
     auto         sendKeyUpEvent (FWidget*) const -> bool;
+    auto         sendPasteEvent (FWidget*, const FString&) const -> bool;
+    void         sendPasteKeyEvents (FWidget*, const FString&) const;
     void         sendKeyboardAccelerator() const;
     auto         hasDataInQueue() const -> bool;
     void         queuingKeyboardInput() const;
@@ -205,6 +213,7 @@ class FApplication : public FWidget
     static auto  isNonActivatingMouseEvent (const FMouseData&) -> bool;
     static auto  isWheelEvent (const FMouseData&) -> bool;
     static void  unsetMoveResizeMode (const FMouseData&);
+    static void  setMoveCoalescing (const FMouseData&);
     void         sendMouseEvent (const FMouseData&) const;
     void         sendMouseWheelEvent (const FMouseData&) const;
     void         sendMouseMoveEvent ( const FMouseData&
@@ -231,9 +240,14 @@ class FApplication : public FWidget
     void         processCloseWidget();
     void         processDialogResizeMove() const;
     void         processLogger() const;
+    static void  processPendingOutput();
     auto         processNextEvent() -> bool;
+    void         initEventMonitors();
+    auto         getNextEventWaitTime() const -> int;
+    auto         waitForNextEvent() -> bool;
     void         performTimerAction (FObject*, FEvent*) override;
     auto         hasTerminalResized() -> bool;
+    static auto  hasPendingUpdates() -> bool;
     static auto  isEventProcessable (FObject*, const FEvent*) -> bool;
     static auto  isNextEventTimeout() -> bool;
 
@@ -244,6 +258,9 @@ class FApplication : public FWidget
     std::streambuf*   default_clog_rdbuf{std::clog.rdbuf()};
     FEventQueue       event_queue{};
     FMouseHandlerList mouse_handler_list{};
+    IoMonitorPtr      input_monitor{};
+    IoMonitorPtr      signal_monitor{};
+    IoMonitorPtr      output_monitor{};
     bool              has_terminal_resized{false};
     static uInt64     next_event_wait;
     static TimeValue  time_last_event;
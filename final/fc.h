@@ -57,6 +57,7 @@ enum class Event
   KeyPress,          // Key pressed
   KeyUp,             // Key released
   KeyDown,           // Key pressed
+  Paste,             // Text pasted
   MouseDown,         // Mouse button pressed
   MouseUp,           // Mouse button released
   MouseDoubleClick,  // Mouse button double click
@@ -701,6 +702,7 @@ enum class FKey : uInt32
   Shift_Ctrl_Meta_menu       = 0x01600007,  // Shifted control-M-Menu
   Term_Focus_In              = 0x01900000,  // Terminal focus-in event
   Term_Focus_Out             = 0x01900001,  // Terminal focus-out event
+  Bracketed_paste            = 0x01900002,  // Bracketed paste start
   Escape_mintty              = 0x0200001b,  // Mintty Esc
   X11mouse                   = 0x02000020,  // Xterm mouse
   Extended_mouse             = 0x02000021,  // SGR extended mouse
@@ -1409,6 +1411,14 @@ enum class CursorMode
   Overwrite
 };
 
+// Frame pacing of the terminal output
+enum class FramePacing
+{
+  Adaptive,    // Follows the throughput of the terminal
+  TargetRate,  // Fixed number of frames per second
+  Unthrottled  // Every terminal update is written immediately
+};
+
 // Xterm cursor style
 enum class XTermCursorStyle
 {
@@ -1544,6 +1554,13 @@ enum class Termcap
   t_cursor_style,
   t_scroll_forward,
   t_scroll_reverse,
+  t_parm_index,
+  t_parm_rindex,
+  t_change_scroll_region,
+  t_insert_line,
+  t_parm_insert_line,
+  t_delete_line,
+  t_parm_delete_line,
   t_enter_ca_mode,
   t_exit_ca_mode,
   t_enable_acs,
@@ -73,6 +73,32 @@ void FKeyEvent::ignore()
 { accpt = false; }
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+FPasteEvent::FPasteEvent (Event ev_type, const FString& str)  // constructor
+  : FEvent{ev_type}
+  , text{str}
+{ }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::getText() const & -> const FString&
+{ return text; }
+
+//----------------------------------------------------------------------
+auto FPasteEvent::isAccepted() const -> bool
+{ return accpt; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::accept()
+{ accpt = true; }
+
+//----------------------------------------------------------------------
+void FPasteEvent::ignore()
+{ accpt = false; }
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
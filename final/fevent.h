@@ -33,6 +33,10 @@
  *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▏
  *      │
  *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *      ├─────▏FPasteEvent ▏
+ *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *      │
+ *      │    ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
  *      ├─────▏FMouseEvent ▏
  *      │    ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
  *      │
@@ -87,6 +91,7 @@
 #include "final/ftypes.h"
 #include "final/util/fdata.h"
 #include "final/util/fpoint.h"
+#include "final/util/fstring.h"
 
 namespace finalcut
 {
@@ -137,6 +142,26 @@ class FKeyEvent : public FEvent  // keyboard event
 };
 
 
+//----------------------------------------------------------------------
+// class FPasteEvent
+//----------------------------------------------------------------------
+
+class FPasteEvent : public FEvent  // paste event
+{
+  public:
+    FPasteEvent (Event, const FString&);
+
+    auto getText() const & -> const FString&;
+    auto isAccepted() const -> bool;
+    void accept();
+    void ignore();
+
+  private:
+    FString text{};
+    bool    accpt{false};  // reject by default
+};
+
+
 //----------------------------------------------------------------------
 // class FMouseEvent
 //----------------------------------------------------------------------
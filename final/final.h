@@ -57,6 +57,8 @@
 #include <final/output/fcolorpalette.h>
 #include <final/output/foutput.h>
 #include <final/output/tty/fcharmap.h>
+#include <final/output/tty/fframepacer.h>
+#include <final/output/tty/fheadlessoutput.h>
 #include <final/output/tty/foptiattr.h>
 #include <final/output/tty/foptimove.h>
 #include <final/output/tty/ftermcap.h>
@@ -80,6 +82,9 @@
 #include <final/util/fstring.h>
 #include <final/util/fsystem.h>
 #include <final/vterm/fcolorpair.h>
+#include <final/vterm/fframeprofiler.h>
+#include <final/vterm/flinediff.h>
+#include <final/vterm/frowbandcompositor.h>
 #include <final/vterm/fstyle.h>
 #include <final/vterm/fvtermbuffer.h>
 #include <final/vterm/fvterm.h>
@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+#
+# Generates the column width table unicodewidth.h
+#
+# The widths come from the Unicode character database of the Python
+# module unicodedata (general category and East Asian width).
+# The rules follow the wcwidth() of the GNU C library, so that the
+# table gives the same results on every platform:
+#
+#   0  Control characters, unassigned code points, surrogates,
+#      non-spacing and enclosing marks, format characters,
+#      line and paragraph separators and Hangul jungseong/jongseong
+#   2  East Asian wide and fullwidth characters (includes the
+#      emoji presentation characters)
+#   1  All other characters, also the East Asian ambiguous width
+#      characters and the NewFont characters in the private use area
+
+import sys
+import unicodedata
+
+MAX_CODE_POINT = 0x110000
+BLOCK_SHIFT = 8
+BLOCK_SIZE = 1 << BLOCK_SHIFT
+INCLUDE_GUARD = "FUNICODEWIDTH_H"
+
+# Format characters with a visible glyph
+# (Unicode property Prepended_Concatenation_Mark)
+prepended_concatenation_marks = \
+  set(range(0x0600, 0x0606)) | {0x06dd, 0x070f, 0x0890, 0x0891, 0x08e2,
+                                0x110bd, 0x110cd}
+
+# Characters that glibc shows as wide
+glibc_wide_ranges = ((0x3248, 0x324f), (0x4dc0, 0x4dff))
+
+# FINAL CUT NewFont characters (NF_rev_left_arrow2 ... NF_check_mark)
+newfont_range = (0xe1b4, 0xe1fb)
+
+
+def char_width(code):
+  char = chr(code)
+  category = unicodedata.category(char)
+
+  if newfont_range[0] <= code <= newfont_range[1]:
+    return 1
+
+  if category in ("Cc", "Cs", "Cn", "Zl", "Zp"):
+    return 0
+
+  if code == 0x00ad or code in prepended_concatenation_marks:
+    return 1  # Soft hyphen and prepended concatenation marks
+
+  if category in ("Mn", "Me", "Cf"):
+    return 0
+
+  if 0x1160 <= code <= 0x11ff or 0xd7b0 <= code <= 0xd7ff:
+    return 0  # Hangul jungseong and jongseong
+
+  if any(first <= code <= last for first, last in glibc_wide_ranges):
+    return 2
+
+  if unicodedata.east_asian_width(char) in ("W", "F"):
+    return 2
+
+  return 1  # Narrow, halfwidth, neutral and ambiguous
+
+
+def create_tables():
+  stage1 = []
+  stage2 = []
+  blocks = {}
+
+  for start in range(0, MAX_CODE_POINT, BLOCK_SIZE):
+    block = bytes(char_width(code) for code in range(start, start + BLOCK_SIZE))
+
+    if block not in blocks:
+      blocks[block] = len(blocks)
+      # Four widths with 2 bits each per byte
+      for i in range(0, BLOCK_SIZE, 4):
+        stage2.append( block[i]
+                     | block[i + 1] << 2
+                     | block[i + 2] << 4
+                     | block[i + 3] << 6 )
+
+    stage1.append(blocks[block])
+
+  if len(blocks) > 256:
+    sys.exit("Error: More than 256 blocks")
+
+  return stage1, stage2
+
+
+def write_array(out, name, values, per_line):
+  out.write("constexpr std::array<uInt8, %d> %s =\n{{\n" % (len(values), name))
+
+  for pos in range(0, len(values), per_line):
+    line = ", ".join("0x%02x" % v for v in values[pos:pos + per_line])
+    separator = "," if pos + per_line < len(values) else ""
+    out.write("  %s%s\n" % (line, separator))
+
+  out.write("}};\n")
+
+
+def main():
+  stage1, stage2 = create_tables()
+  out = sys.stdout
+  out.write("// unicodewidth.h\n")
+  out.write("//\n")
+  out.write("// Generated by unicodewidth.py from the Unicode %s character\n"
+            % unicodedata.unidata_version)
+  out.write("// database - do not edit\n\n")
+  out.write("#ifndef %s\n#define %s\n\n" % (INCLUDE_GUARD, INCLUDE_GUARD))
+  out.write("#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)\n")
+  out.write("  #error \"Only <final/final.h> can be included directly.\"\n")
+  out.write("#endif\n\n")
+  out.write("#include <array>\n\n")
+  out.write("#include \"final/ftypes.h\"\n\n")
+  out.write("namespace finalcut\n{\n\nnamespace fc\n{\n\n")
+  out.write("constexpr uInt32 unicode_width_limit = 0x%x;\n" % MAX_CODE_POINT)
+  out.write("constexpr uInt32 unicode_width_block_shift = %d;\n\n" % BLOCK_SHIFT)
+  out.write("// Block number for every %d code points\n" % BLOCK_SIZE)
+  write_array(out, "unicode_width_stage1", stage1, 12)
+  out.write("\n// %d blocks with 2 bits per code point\n" % (len(stage2) * 4 // BLOCK_SIZE))
+  write_array(out, "unicode_width_stage2", stage2, 12)
+  out.write("\n}  // namespace fc\n\n}  // namespace finalcut\n\n")
+  out.write("#endif  // %s\n" % INCLUDE_GUARD)
+
+
+if __name__ == "__main__":
+  main()
@@ -52,6 +52,8 @@ FStartOptions::FStartOptions()
 #endif
   , dark_theme{false}
   , color_change{true}
+  , synchronized_output{true}
+  , keyboard_protocol{true}
 { }
 
 
@@ -75,6 +77,8 @@ void FStartOptions::setDefault()
   encoding = Encoding::Unknown;
   dark_theme = false;
   terminal_focus_events = true;
+  synchronized_output = true;
+  keyboard_protocol = true;
 
 #if defined(__FreeBSD__) || defined(__DragonFly__) || defined(UNIT_TEST)
   meta_sends_escape = true;
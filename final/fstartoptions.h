@@ -83,7 +83,9 @@ class FStartOptions final
 
     uInt16 dark_theme           : 1;
     uInt16 color_change         : 1;
-    uInt16                      : 14;  // padding bits
+    uInt16 synchronized_output  : 1;
+    uInt16 keyboard_protocol    : 1;
+    uInt16                      : 12;  // padding bits
 
     Encoding      encoding{Encoding::Unknown};
     std::ofstream logfile_stream{};
@@ -39,7 +39,10 @@
 #include <algorithm>
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <shared_mutex>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "final/fevent.h"
@@ -90,6 +93,8 @@ class FTimer
       return system_clock::now();  // Get the current time
     }
 
+    auto  getNextTimeout() const & -> TimeValue;
+
     // Inquiries
     auto  isTimeout (const TimeValue&, uInt64) -> bool;
 
@@ -108,8 +113,40 @@ class FTimer
       ObjectT*     object;
     };
 
+    // Binary min-heap of all timers ordered by timeout
+    // with an index for the timer identifier number
+    class FTimerList
+    {
+      public:
+        // Accessors
+        auto size() const noexcept -> std::size_t;
+        auto top() const -> const FTimerData&;
+
+        // Inquiry
+        auto empty() const noexcept -> bool;
+
+        // Methods
+        void insert (const FTimerData&);
+        auto erase (int) -> bool;
+        template <typename PredicateT>
+        void eraseIf (PredicateT);
+        void rescheduleTop (const TimeValue&);
+        void clear();
+
+      private:
+        // Methods
+        void place (std::size_t, FTimerData&&);
+        void siftUp (std::size_t);
+        void siftDown (std::size_t);
+        void removeAt (std::size_t);
+        void makeHeap();
+
+        // Data members
+        std::vector<FTimerData>              heap{};
+        std::unordered_map<int, std::size_t> position{};
+    };
+
     // Using-declaration
-    using FTimerList = std::vector<FTimerData>;
     using FTimerListUniquePtr = std::unique_ptr<FTimerList>;
 
     // Accessor
@@ -151,6 +188,22 @@ inline auto FTimer<ObjectT>::isTimeout (const TimeValue& time, uInt64 timeout) -
   return diff_usec > timeout;
 }
 
+//----------------------------------------------------------------------
+template <typename ObjectT>
+auto FTimer<ObjectT>::getNextTimeout() const & -> TimeValue
+{
+  // Returns the expiration time of the next timer
+  // or TimeValue::max() if there is no active timer
+
+  std::shared_lock<std::shared_timed_mutex> lock(internal::timer_var::mutex);
+  const auto& timer_list = globalTimerList();
+
+  if ( ! timer_list || timer_list->empty() )
+    return TimeValue::max();
+
+  return timer_list->top().timeout;
+}
+
 //----------------------------------------------------------------------
 template <typename ObjectT>
 auto FTimer<ObjectT>::addTimer (ObjectT* object, int interval) & -> int
@@ -163,18 +216,7 @@ auto FTimer<ObjectT>::addTimer (ObjectT* object, int interval) & -> int
   int id = getNextId();
   const auto time_interval = milliseconds(interval);
   const auto timeout = getCurrentTime() + time_interval;
-  FTimerData timedata{ id, time_interval, timeout, object };
-
-  // Insert in list sorted by timeout
-  timer_list->insert( std::lower_bound( timer_list->cbegin()
-                                      , timer_list->cend()
-                                      , timedata
-                                      , [] (const auto& a, const auto& b)
-                                        {
-                                          return a.timeout < b.timeout;
-                                        }
-                                      )
-                    , timedata);
+  timer_list->insert({ id, time_interval, timeout, object });
   return id;
 }
 
@@ -193,19 +235,7 @@ auto FTimer<ObjectT>::delTimer (int id) const & -> bool
   if ( ! timer_list || timer_list->empty() )
     return false;
 
-  auto iter = std::find_if ( timer_list->cbegin()
-                           , timer_list->cend()
-                           , [id] (const auto& timer)
-                             {
-                               return timer.id == id;
-                             }
-                           );
-
-  if ( iter == timer_list->cend() )
-    return false;
-
-  timer_list->erase(iter);
-  return true;
+  return timer_list->erase(id);
 }
 
 //----------------------------------------------------------------------
@@ -220,14 +250,10 @@ auto FTimer<ObjectT>::delOwnTimers(const ObjectT* object) const & -> bool
   if ( ! timer_list || timer_list->empty() )
     return false;
 
-  timer_list->erase ( std::remove_if( timer_list->begin()
-                                    , timer_list->end()
-                                    , [&object] (const auto& timer)
-                                      {
-                                        return timer.object == object;
-                                      }
-                                    )
-                    , timer_list->end() );
+  timer_list->eraseIf ( [&object] (const auto& timer)
+                        {
+                          return timer.object == object;
+                        } );
   return true;
 }
 
@@ -244,7 +270,6 @@ auto FTimer<ObjectT>::delAllTimers() const & -> bool
     return false;
 
   timer_list->clear();
-  timer_list->shrink_to_fit();
   return true;
 }
 
@@ -254,8 +279,11 @@ template <typename ObjectT>
 template <typename CallbackT>
 auto FTimer<ObjectT>::processTimerEvent (CallbackT callback) -> uInt
 {
+  // Only the expired timers at the top of the heap are visited,
+  // so the costs are O(expired · log n)
+
   uInt activated{0};
-  std::shared_lock<std::shared_timed_mutex> lock ( internal::timer_var::mutex
+  std::unique_lock<std::shared_timed_mutex> lock ( internal::timer_var::mutex
                                                  , std::defer_lock );
 
   if ( ! lock.try_lock() )
@@ -268,21 +296,29 @@ auto FTimer<ObjectT>::processTimerEvent (CallbackT callback) -> uInt
 
   const auto& currentTime = getCurrentTime();
 
-  for (auto&& timer : *timer_list)
+  while ( ! timer_list->empty()
+       && timer_list->top().timeout <= currentTime )
   {
-    if ( ! timer.id
-      || ! timer.object
-      || currentTime < timer.timeout )  // Timer not expired
-      continue;
+    const auto timer = timer_list->top();
+    auto timeout = timer.timeout + timer.interval;
 
-    timer.timeout += timer.interval;
+    if ( timeout <= currentTime )
+    {
+      // A timer is triggered at most once per call
+      timeout = ( timer.interval > microseconds(0) )
+              ? currentTime + timer.interval
+              : currentTime + TimeValue::duration(1);
+    }
 
-    if ( timer.timeout < currentTime )
-      timer.timeout = currentTime + timer.interval;
+    timer_list->rescheduleTop(timeout);
+
+    if ( ! timer.id || ! timer.object )
+      continue;
 
     if ( timer.interval > microseconds(0) )
       ++activated;
 
+    // The callback may add or delete timers
     lock.unlock();
     FTimerEvent t_ev(Event::Timer, timer.id);
     callback (timer.object, &t_ev);
@@ -301,6 +337,179 @@ auto FTimer<ObjectT>::globalTimerList() -> const FTimerListUniquePtr&
   return timer_list;
 }
 
+
+//----------------------------------------------------------------------
+// class FTimer::FTimerList
+//----------------------------------------------------------------------
+
+// public methods of FTimer::FTimerList
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline auto FTimer<ObjectT>::FTimerList::size() const noexcept -> std::size_t
+{
+  return heap.size();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline auto FTimer<ObjectT>::FTimerList::top() const -> const FTimerData&
+{
+  return heap.front();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline auto FTimer<ObjectT>::FTimerList::empty() const noexcept -> bool
+{
+  return heap.empty();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimer<ObjectT>::FTimerList::insert (const FTimerData& timedata)
+{
+  heap.push_back(timedata);
+  position[timedata.id] = heap.size() - 1;
+  siftUp (heap.size() - 1);
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+auto FTimer<ObjectT>::FTimerList::erase (int id) -> bool
+{
+  const auto iter = position.find(id);
+
+  if ( iter == position.end() )
+    return false;
+
+  removeAt (iter->second);
+  return true;
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+template <typename PredicateT>
+void FTimer<ObjectT>::FTimerList::eraseIf (PredicateT predicate)
+{
+  const auto old_size = heap.size();
+  heap.erase ( std::remove_if(heap.begin(), heap.end(), predicate)
+             , heap.end() );
+
+  if ( heap.size() != old_size )
+    makeHeap();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimer<ObjectT>::FTimerList::rescheduleTop (const TimeValue& timeout)
+{
+  // The timeout of the top element can only increase
+
+  heap.front().timeout = timeout;
+  siftDown (0);
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimer<ObjectT>::FTimerList::clear()
+{
+  std::vector<FTimerData>().swap(heap);  // Release the memory
+  std::unordered_map<int, std::size_t>().swap(position);
+}
+
+
+// private methods of FTimer::FTimerList
+//----------------------------------------------------------------------
+template <typename ObjectT>
+inline void FTimer<ObjectT>::FTimerList::place (std::size_t index, FTimerData&& timedata)
+{
+  position[timedata.id] = index;
+  heap[index] = std::move(timedata);
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimer<ObjectT>::FTimerList::siftUp (std::size_t index)
+{
+  auto timedata = std::move(heap[index]);
+
+  while ( index > 0 )
+  {
+    const std::size_t parent = (index - 1) / 2;
+
+    if ( ! (timedata.timeout < heap[parent].timeout) )
+      break;
+
+    place (index, std::move(heap[parent]));
+    index = parent;
+  }
+
+  place (index, std::move(timedata));
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimer<ObjectT>::FTimerList::siftDown (std::size_t index)
+{
+  const std::size_t length = heap.size();
+  auto timedata = std::move(heap[index]);
+
+  while ( 2 * index + 1 < length )
+  {
+    std::size_t child = 2 * index + 1;
+
+    if ( child + 1 < length
+      && heap[child + 1].timeout < heap[child].timeout )
+      ++child;
+
+    if ( ! (heap[child].timeout < timedata.timeout) )
+      break;
+
+    place (index, std::move(heap[child]));
+    index = child;
+  }
+
+  place (index, std::move(timedata));
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimer<ObjectT>::FTimerList::removeAt (std::size_t index)
+{
+  position.erase(heap[index].id);
+  const std::size_t last = heap.size() - 1;
+
+  if ( index != last )
+  {
+    // Move the last element into the gap and restore the heap order
+    const auto old_timeout = heap[index].timeout;
+    place (index, std::move(heap[last]));
+    heap.pop_back();
+
+    if ( heap[index].timeout < old_timeout )
+      siftUp (index);
+    else
+      siftDown (index);
+  }
+  else
+    heap.pop_back();
+}
+
+//----------------------------------------------------------------------
+template <typename ObjectT>
+void FTimer<ObjectT>::FTimerList::makeHeap()
+{
+  // Rebuilds the heap and the position index in O(n)
+
+  position.clear();
+
+  for (std::size_t index{0}; index < heap.size(); index++)
+    position[heap[index].id] = index;
+
+  for (std::size_t index = heap.size() / 2; index > 0; index--)
+    siftDown (index - 1);
+}
+
 // class forward declaration
 class FObject;
 
@@ -331,6 +540,11 @@ class FObjectTimer
       return timer->getCurrentTime();
     }
 
+    static inline auto getNextTimeout() -> TimeValue
+    {
+      return timer->getNextTimeout();
+    }
+
     // Inquiries
     static auto isTimeout (const TimeValue& time, uInt64 timeout) -> bool
     {
@@ -32,6 +32,7 @@
 #include "final/output/tty/ftermdata.h"
 #include "final/util/flog.h"
 #include "final/util/fstring.h"
+#include "final/vterm/fframeprofiler.h"
 #include "final/widget/fstatusbar.h"
 #include "final/widget/fwindow.h"
 
@@ -58,6 +59,7 @@ FWidget*              FWidget::redraw_root_widget{nullptr};
 FWidget::FWidgetList* FWidget::dialog_list{nullptr};
 FWidget::FWidgetList* FWidget::always_on_top_list{nullptr};
 FWidget::FWidgetList* FWidget::close_widget_list{nullptr};
+FWidget::FWidgetList* FWidget::update_widget_list{nullptr};
 bool                  FWidget::init_terminal{false};
 bool                  FWidget::init_desktop{false};
 uInt                  FWidget::modal_dialog_counter{};
@@ -113,6 +115,13 @@ FWidget::~FWidget()  // destructor
   delCallback();
   removeQueuedEvent();
 
+  // remove a pending update
+  if ( update_widget_list )
+  {
+    auto& list = *update_widget_list;
+    list.erase (std::remove(list.begin(), list.end(), this), list.end());
+  }
+
   // unset clicked widget
   if ( this == getClickedWidget() )
     setClickedWidget(nullptr);
@@ -812,9 +821,14 @@ void FWidget::redraw()
 {
   // Redraw the widget immediately unless it is hidden.
 
+  FFrameProfiler::ScopedPhase draw_phase{FFrameProfiler::Phase::Draw};
+
   if ( ! redraw_root_widget )
     redraw_root_widget = this;
 
+  // A complete redraw satisfies a pending update()
+  update_region = FRect{};
+
   if ( isRootWidget() )
   {
     startDrawing();
@@ -840,6 +854,35 @@ void FWidget::redraw()
     redraw_root_widget = nullptr;
 }
 
+//----------------------------------------------------------------------
+void FWidget::update()
+{
+  update (FRect{FPoint{1, 1}, getSize()});
+}
+
+//----------------------------------------------------------------------
+void FWidget::update (const FRect& box)
+{
+  // Marks the given widget region (in widget coordinates) as dirty.
+  // All dirty widgets are painted once before the next terminal update.
+
+  if ( ! update_widget_list )
+    return;
+
+  const auto region = box.intersect(FRect{FPoint{1, 1}, getSize()});
+
+  if ( region.getX2() < region.getX1() || region.getY2() < region.getY1() )
+    return;  // Outside the widget
+
+  if ( update_region.isEmpty() )
+  {
+    update_region = region;
+    update_widget_list->push_back(this);
+  }
+  else
+    update_region = update_region.combined(region);
+}
+
 //----------------------------------------------------------------------
 void FWidget::resize()
 {
@@ -1348,6 +1391,13 @@ void FWidget::onKeyDown (FKeyEvent*)
   // to receive key down events for the widget
 }
 
+//----------------------------------------------------------------------
+void FWidget::onPaste (FPasteEvent*)
+{
+  // This event handler can be reimplemented in a subclass
+  // to receive pasted text for the widget
+}
+
 //----------------------------------------------------------------------
 void FWidget::onMouseDown (FMouseEvent*)
 {
@@ -1524,6 +1574,12 @@ inline void FWidget::mapKeyEvents()
       {
         KeyDownEvent(static_cast<FKeyEvent*>(ev));
       }
+    },
+    { Event::Paste,
+      [this] (FEvent* ev)
+      {
+        PasteEvent(static_cast<FPasteEvent*>(ev));
+      }
     }
   } );
 }
@@ -1675,6 +1731,7 @@ void FWidget::initRootWidget()
     dialog_list        = new FWidgetList();
     always_on_top_list = new FWidgetList();
     close_widget_list  = new FWidgetList();
+    update_widget_list = new FWidgetList();
   }
   catch (const std::bad_alloc&)
   {
@@ -1726,11 +1783,48 @@ inline void FWidget::initDesktopOnShown() const
   internal::var::root_widget->initDesktop();
 }
 
+//----------------------------------------------------------------------
+void FWidget::processUpdates()
+{
+  // Paints the widgets marked by update() in window layer order
+  // and from parent to child. A parent redraw also redraws its
+  // children, so their pending updates are dropped.
+
+  if ( ! update_widget_list )
+    return;
+
+  FFrameProfiler::ScopedPhase draw_phase{FFrameProfiler::Phase::Draw};
+  auto& list = *update_widget_list;
+  // Updates requested while painting beyond this count wait for the next frame
+  auto count = list.size();
+
+  while ( ! list.empty() && count > 0 )
+  {
+    const auto iter = std::min_element(list.begin(), list.end(), isUpdateOrderLess);
+    auto widget = *iter;
+    list.erase(iter);
+    count--;
+
+    if ( widget->update_region.isEmpty() )
+      continue;  // Already redrawn
+
+    if ( ! widget->isShown() )
+      widget->update_region = FRect{};
+    else if ( widget->isRootWidget()
+           && widget->update_region != FRect{FPoint{1, 1}, widget->getSize()} )
+      widget->drawUpdateRegion();
+    else
+      widget->redraw();
+  }
+}
+
 //----------------------------------------------------------------------
 void FWidget::finish()
 {
   delete close_widget_list;
   close_widget_list = nullptr;
+  delete update_widget_list;
+  update_widget_list = nullptr;
   delete dialog_list;
   dialog_list = nullptr;
   delete always_on_top_list;
@@ -1890,6 +1984,24 @@ void FWidget::KeyDownEvent (FKeyEvent* kev)
   }
 }
 
+//----------------------------------------------------------------------
+void FWidget::PasteEvent (FPasteEvent* pev)
+{
+  FWidget* widget(this);
+
+  while ( widget )
+  {
+    widget->onPaste(pev);
+
+    if ( pev->isAccepted()
+      || widget->isRootWidget()
+      || widget->getFlags().visibility.modal )
+      break;
+
+    widget = widget->getParentWidget();
+  }
+}
+
 //----------------------------------------------------------------------
 void FWidget::emitWheelCallback (const FWheelEvent* ev) const
 {
@@ -2142,6 +2254,63 @@ void FWidget::drawChildren()
   }
 }
 
+//----------------------------------------------------------------------
+void FWidget::drawUpdateRegion()
+{
+  // Repaints only the dirty desktop region. Windows have their
+  // own virtual windows and do not need to be redrawn.
+
+  const auto region = update_region;
+  update_region = FRect{};
+  startDrawing();
+  auto color_theme_term = getColorTheme()->term;
+  setColor (color_theme_term.fg, color_theme_term.bg);
+  const FString blank_line(region.getWidth(), L' ');
+
+  for (auto y = region.getY1(); y <= region.getY2(); y++)
+    print() << FPoint{region.getX1(), y} << blank_line;
+
+  draw();
+
+  for (auto* child : getChildren())
+  {
+    if ( ! child->isWidget() )
+      continue;
+
+    auto widget = static_cast<FWidget*>(child);
+
+    if ( widget->isShown() && ! widget->isWindowWidget()
+      && region.overlap(widget->getGeometry()) )
+      widget->redraw();
+  }
+
+  finishDrawing();
+}
+
+//----------------------------------------------------------------------
+auto FWidget::isUpdateOrderLess (const FWidget* lhs, const FWidget* rhs) -> bool
+{
+  // Lower window layers first, then parents before their children
+
+  auto get_depth = [] (const FWidget* widget)
+  {
+    std::size_t depth{0};
+
+    while ( widget && (widget = widget->getParentWidget()) )
+      depth++;
+
+    return depth;
+  };
+
+  const auto lhs_layer = FWindow::getWindowLayer(const_cast<FWidget*>(lhs));
+  const auto rhs_layer = FWindow::getWindowLayer(const_cast<FWidget*>(rhs));
+
+  if ( lhs_layer != rhs_layer )
+    return lhs_layer < rhs_layer;
+
+  return get_depth(lhs) < get_depth(rhs);
+}
+
 //----------------------------------------------------------------------
 inline void FWidget::adjustWidget()
 {
@@ -221,6 +221,8 @@ class FWidget : public FVTerm
     void  unsetFocusable();
     auto  ignorePadding (bool = true) -> bool;    // ignore padding from
     auto  acceptPadding() -> bool;                // the parent widget
+    void  setMoveCoalescing (bool = true);        // combine mouse moves
+    void  unsetMoveCoalescing();                  // of this widget
     virtual void setForegroundColor (FColor);
     virtual void setBackgroundColor (FColor);
     virtual void resetColors();
@@ -270,6 +272,7 @@ class FWidget : public FVTerm
     auto  hasFocus() const -> bool;
     auto  acceptFocus() const -> bool;  // is focusable
     auto  isPaddingIgnored() const -> bool;
+    auto  hasMoveCoalescing() const -> bool;
 
     // Methods
     auto  childWidgetAt (const FPoint&) & -> FWidget*;
@@ -287,6 +290,8 @@ class FWidget : public FVTerm
     virtual void delAccelerator (FWidget*) &;
     virtual void flushChanges();
     virtual void redraw();
+    void  update();
+    void  update (const FRect&);
     virtual void resize();
     virtual void show();
     virtual void hide();
@@ -307,6 +312,7 @@ class FWidget : public FVTerm
     static auto getDialogList() -> FWidgetList*&;
     static auto getAlwaysOnTopList() -> FWidgetList*&;
     static auto getWidgetCloseList() -> FWidgetList*&;
+    static auto getWidgetUpdateList() -> FWidgetList*&;
     void  addPreprocessingHandler ( const FVTerm*
                                   , FPreprocessingFunction&& ) override;
     void  delPreprocessingHandler (const FVTerm*) override;
@@ -329,12 +335,14 @@ class FWidget : public FVTerm
     virtual void adjustSize();
     void  adjustSizeGlobal();
     void  hideArea (const FSize&);
+    static void  processUpdates();
 
     // Event handlers
     auto  event (FEvent*) -> bool override;
     virtual void onKeyPress (FKeyEvent*);
     virtual void onKeyUp (FKeyEvent*);
     virtual void onKeyDown (FKeyEvent*);
+    virtual void onPaste (FPasteEvent*);
     virtual void onMouseDown (FMouseEvent*);
     virtual void onMouseUp (FMouseEvent*);
     virtual void onMouseDoubleClick (FMouseEvent*);
@@ -448,6 +456,7 @@ class FWidget : public FVTerm
     void  insufficientSpaceAdjust();
     void  KeyPressEvent (FKeyEvent*);
     void  KeyDownEvent (FKeyEvent*);
+    void  PasteEvent (FPasteEvent*);
     void  emitWheelCallback (const FWheelEvent*) const;
     void  setWindowFocus (bool = true);
     auto  searchForwardForWidget ( const FWidget*
@@ -464,6 +473,8 @@ class FWidget : public FVTerm
     virtual void draw();
     void  drawWindows() const;
     void  drawChildren();
+    void  drawUpdateRegion();
+    static auto  isUpdateOrderLess (const FWidget*, const FWidget*) -> bool;
     void  adjustWidget();
     void  adjustSizeWithinArea (FRect&) const;
     void  adjustChildWidgetSizes();
@@ -492,6 +503,8 @@ class FWidget : public FVTerm
     FRect                woffset{};
     // offset of the widget client area
     FRect                wclient_offset{};
+    // pending update() region in widget coordinates
+    FRect                update_region{};
     // widget shadow size (on the right and bottom side)
     FSize                wshadow{0, 0};
 
@@ -516,6 +529,7 @@ class FWidget : public FVTerm
     static FWidgetList*  dialog_list;
     static FWidgetList*  always_on_top_list;
     static FWidgetList*  close_widget_list;
+    static FWidgetList*  update_widget_list;
     static uInt          modal_dialog_counter;
     static bool          init_terminal;
     static bool          init_desktop;
@@ -810,6 +824,14 @@ inline auto FWidget::ignorePadding (bool enable) -> bool
 inline auto FWidget::acceptPadding() -> bool
 { return (flags.feature.ignore_padding = false); }
 
+//----------------------------------------------------------------------
+inline void FWidget::setMoveCoalescing (bool enable)
+{ flags.feature.no_coalescing = ! enable; }
+
+//----------------------------------------------------------------------
+inline void FWidget::unsetMoveCoalescing()
+{ flags.feature.no_coalescing = true; }
+
 //----------------------------------------------------------------------
 inline void FWidget::setForegroundColor (FColor color)
 {
@@ -945,6 +967,10 @@ inline auto FWidget::acceptFocus() const -> bool  // is focusable
 inline auto FWidget::isPaddingIgnored() const -> bool
 { return flags.feature.ignore_padding; }
 
+//----------------------------------------------------------------------
+inline auto FWidget::hasMoveCoalescing() const -> bool
+{ return ! flags.feature.no_coalescing; }
+
 //----------------------------------------------------------------------
 inline void FWidget::clearStatusbarMessage()
 { statusbar_message.clear(); }
@@ -1012,6 +1038,10 @@ inline auto FWidget::getAlwaysOnTopList() -> FWidgetList*&
 inline auto FWidget::getWidgetCloseList() -> FWidgetList*&
 { return close_widget_list; }
 
+//----------------------------------------------------------------------
+inline auto FWidget::getWidgetUpdateList() -> FWidgetList*&
+{ return update_widget_list; }
+
 //----------------------------------------------------------------------
 inline auto FWidget::setModalDialogCounter() -> uInt&
 { return modal_dialog_counter; }
@@ -43,7 +43,8 @@ struct FWidgetFeature
   uInt16 no_border      : 1;
   uInt16 no_underline   : 1;
   uInt16 ignore_padding : 1;
-  uInt16                : 8;  // padding bits
+  uInt16 no_coalescing  : 1;
+  uInt16                : 7;  // padding bits
 };
 
 struct FWidgetVisibility
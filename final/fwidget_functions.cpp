@@ -74,7 +74,6 @@ struct TransparentShadowData
   uInt       shadow_height{};
   FChar      transparent_char{};
   FChar      color_overlay_char{};
-  FChar*     area_ptr{};
 };
 
 
@@ -411,8 +410,7 @@ void drawTransparentShadow (FWidget* w)
       { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
       { { wc_shadow.fg, wc_shadow.bg } },
       { { 0x00, 0x40, 0x00, 0x00} }  // byte 0..3 (byte 1 = 0x64 = color_overlay)
-    },
-    &area.getFChar(area.size.width, 0)
+    }
   };
 
   drawRightShadow(data);
@@ -428,21 +426,20 @@ inline void drawRightShadow (TransparentShadowData& d)
 {
   if ( d.shadow_width > 0 )  // Draw right shadow
   {
-    std::fill (d.area_ptr, d.area_ptr + d.shadow_width, d.transparent_char);
+    auto* area_ptr = &d.area.getFChar(int(d.width), 0);
+    std::fill (area_ptr, area_ptr + d.shadow_width, d.transparent_char);
     d.area.changes[0].xmin = std::min(d.area.changes[0].xmin, d.width);
     d.area.changes[0].xmax = d.width + d.shadow_width - 1;
     d.area.changes[0].trans_count += d.shadow_width;
 
     for (std::size_t y{1}; y < d.height; y++)
     {
-      d.area_ptr += d.shadow_width + d.width;
+      area_ptr = &d.area.getFChar(int(d.width), int(y));
       d.area.changes[y].xmin = std::min(d.area.changes[y].xmin, d.width);
       d.area.changes[y].xmax = d.width + d.shadow_width - 1;
       d.area.changes[y].trans_count += d.shadow_width;
-      std::fill (d.area_ptr, d.area_ptr + d.shadow_width, d.color_overlay_char);
+      std::fill (area_ptr, area_ptr + d.shadow_width, d.color_overlay_char);
     }
-
-    d.area_ptr += d.shadow_width;
   }
 }
 
@@ -454,10 +451,10 @@ inline void drawBottomShadow (TransparentShadowData& d)
     d.area.changes[y].xmin = 0;
     d.area.changes[y].xmax = d.width + d.shadow_width - 1;
     d.area.changes[y].trans_count += d.width + d.shadow_width;
-    std::fill (d.area_ptr, d.area_ptr + d.shadow_width, d.transparent_char);
-    d.area_ptr += d.shadow_width;
-    std::fill (d.area_ptr, d.area_ptr + d.width, d.color_overlay_char);
-    d.area_ptr += d.width;
+    auto* area_ptr = &d.area.getFChar(0, int(y));
+    std::fill (area_ptr, area_ptr + d.shadow_width, d.transparent_char);
+    area_ptr += d.shadow_width;
+    std::fill (area_ptr, area_ptr + d.width, d.color_overlay_char);
   }
 }
 
@@ -64,8 +64,8 @@ class FKeyMap final
 
     // Using-declaration
     using KeyCapMapType = std::array<KeyCapMap, 190>;
-    using KeyMapType = std::array<KeyMap, 234>;
-    using KeyNameType = std::array<KeyName, 390>;
+    using KeyMapType = std::array<KeyMap, 235>;
+    using KeyNameType = std::array<KeyName, 391>;
 
     // Constructors
     FKeyMap() = default;
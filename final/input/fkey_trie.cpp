@@ -0,0 +1,122 @@
+/***********************************************************************
+* fkey_trie.cpp - Prefix tree for key sequences                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include "final/input/fkey_trie.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FKeyTrie
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FKeyTrie::FKeyTrie()
+{
+  clear();
+}
+
+
+// public methods of FKeyTrie
+//----------------------------------------------------------------------
+void FKeyTrie::clear()
+{
+  nodes.clear();
+  transitions.clear();
+  nodes.emplace_back();  // Root node (empty input)
+}
+
+//----------------------------------------------------------------------
+auto FKeyTrie::insert (const char* string, std::size_t length, FKey key) -> bool
+{
+  // Adds a key sequence. An already existing sequence keeps
+  // its key, so the first inserted table has priority.
+
+  if ( ! string || length == 0 )
+    return false;
+
+  uInt32 node{0};
+
+  for (std::size_t n{0}; n < length; n++)
+  {
+    const auto index = getTransitionIndex(node, string[n]);
+    const auto iter = transitions.find(index);
+
+    if ( iter != transitions.end() )
+    {
+      node = iter->second;
+      continue;
+    }
+
+    const auto new_node = uInt32(nodes.size());
+    nodes.emplace_back();
+    nodes[node].children++;
+    transitions[index] = new_node;
+    node = new_node;
+  }
+
+  if ( nodes[node].key != FKey::None )
+    return false;
+
+  nodes[node].key = key;
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FKeyTrie::advance (Cursor& cursor, char ch) const -> Match
+{
+  // Processes the next input byte
+
+  if ( cursor.match == Match::None )
+    return Match::None;
+
+  const auto iter = transitions.find(getTransitionIndex(cursor.node, ch));
+
+  if ( iter == transitions.end() )
+  {
+    cursor.match = Match::None;
+    return cursor.match;
+  }
+
+  cursor.node = iter->second;
+  cursor.depth++;
+  cursor.match = ( nodes[cursor.node].children > 0 ) ? Match::Prefix
+                                                     : Match::Complete;
+  return cursor.match;
+}
+
+//----------------------------------------------------------------------
+auto FKeyTrie::find (const char* string, std::size_t length) const -> FKey
+{
+  // Returns the key of the complete sequence or FKey::None
+
+  Cursor cursor{};
+
+  for (std::size_t n{0}; n < length; n++)
+    if ( advance(cursor, string[n]) == Match::None )
+      return FKey::None;
+
+  return getKey(cursor);
+}
+
+}  // namespace finalcut
@@ -0,0 +1,125 @@
+/***********************************************************************
+* fkey_trie.h - Prefix tree for key sequences                          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FKeyTrie ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The key trie is a deterministic automaton for the key sequences
+ *  of the termcap and the built-in key tables. A cursor advances
+ *  one byte at a time and reports after each byte whether the input
+ *  is a complete key sequence, the prefix of a longer sequence, or
+ *  no key sequence at all.
+ */
+
+#ifndef FKEYTRIE_H
+#define FKEYTRIE_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <unordered_map>
+#include <vector>
+
+#include "final/fc.h"
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FKeyTrie
+//----------------------------------------------------------------------
+
+class FKeyTrie final
+{
+  public:
+    // Enumeration
+    enum class Match : uInt8
+    {
+      None,      // No key sequence starts with the input
+      Prefix,    // The input can be continued to a longer sequence
+      Complete   // The input is a key sequence without continuation
+    };
+
+    struct Cursor
+    {
+      uInt32      node{0};            // Current trie node
+      std::size_t depth{0};           // Number of processed bytes
+      Match       match{Match::Prefix};
+    };
+
+    // Constructor
+    FKeyTrie();
+
+    // Accessors
+    static auto getClassName() -> FString;
+    auto getNodeCount() const noexcept -> std::size_t;
+    auto getKey (const Cursor&) const noexcept -> FKey;
+
+    // Methods
+    void clear();
+    auto insert (const char*, std::size_t, FKey) -> bool;
+    auto advance (Cursor&, char) const -> Match;
+    auto find (const char*, std::size_t) const -> FKey;
+
+  private:
+    struct Node
+    {
+      FKey   key{FKey::None};  // Key of the sequence up to this node
+      uInt32 children{0};      // Number of continuations
+    };
+
+    // Methods
+    static auto getTransitionIndex (uInt32, char) noexcept -> uInt64;
+
+    // Data members
+    std::vector<Node>                  nodes{};
+    std::unordered_map<uInt64, uInt32> transitions{};
+};
+
+// FKeyTrie inline functions
+//----------------------------------------------------------------------
+inline auto FKeyTrie::getClassName() -> FString
+{ return "FKeyTrie"; }
+
+//----------------------------------------------------------------------
+inline auto FKeyTrie::getNodeCount() const noexcept -> std::size_t
+{ return nodes.size(); }
+
+//----------------------------------------------------------------------
+inline auto FKeyTrie::getKey (const Cursor& cursor) const noexcept -> FKey
+{ return nodes[cursor.node].key; }
+
+//----------------------------------------------------------------------
+inline auto FKeyTrie::getTransitionIndex (uInt32 node, char ch) noexcept -> uInt64
+{ return (uInt64(node) << 8) | uInt8(ch); }
+
+}  // namespace finalcut
+
+#endif  // FKEYTRIE_H
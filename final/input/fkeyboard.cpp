@@ -21,6 +21,7 @@
 ***********************************************************************/
 
 #include <fcntl.h>
+#include <poll.h>
 #include <sys/ioctl.h>
 
 #if defined(__CYGWIN__)
@@ -29,6 +30,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstring>
 #include <string>
 
 #include "final/fapplication.h"
@@ -78,6 +80,9 @@ FKeyboard::FKeyboard()
                 return lhs.length < rhs.length;
               }
             );
+
+  // Compile the known key sequences
+  buildKeyTrie();
 }
 
 
@@ -192,6 +197,7 @@ void FKeyboard::clearKeyBuffer() noexcept
   fkey = FKey::None;
   key = FKey::None;
   fifo_buf.clear();
+  key_cursor = {};
 }
 
 //----------------------------------------------------------------------
@@ -201,6 +207,17 @@ void FKeyboard::clearKeyBufferOnTimeout()
 
   if ( fifo_buf.hasData() && isKeypressTimeout() )
     clearKeyBuffer();
+
+  // A paste without an end sequence ends on timeout
+
+  if ( paste_mode
+    && ! hasReadBufferData()
+    && ! fkey_queue.isFull()
+    && isKeypressTimeout() )
+  {
+    queuePasteText (paste_buf.size());
+    paste_mode = false;
+  }
 }
 
 //----------------------------------------------------------------------
@@ -214,11 +231,15 @@ void FKeyboard::escapeKeyHandling()
     && isKeypressTimeout() )
   {
     fifo_buf.clear();
+    key_cursor = {};
     escapeKeyPressedCommand();
   }
 
   // Handling of keys that are substrings of other keys
   substringKeyHandling();
+
+  // Handling of meta key combinations without a key code
+  unknownMetaKeyHandling();
 }
 
 //----------------------------------------------------------------------
@@ -226,20 +247,38 @@ void FKeyboard::processQueuedInput()
 {
   while ( ! fkey_queue.isEmpty() )
   {
-    key = fkey_queue.front();
+    const auto state = fkey_queue.front().state;
+    key = fkey_queue.front().key;
     fkey_queue.pop();
 
-    if ( key > FKey::None )
+    if ( key == FKey::Bracketed_paste && ! paste_queue.empty() )
     {
-      keyPressedCommand();
+      paste_text = std::move(paste_queue.front());
+      paste_queue.pop();
+      pasteCommand();
+      paste_text.clear();
+      key = FKey::None;
 
       if ( FApplication::isQuit() )
         return;
+    }
+    else if ( key > FKey::None )
+    {
+      if ( state != KeyState::Released )
+      {
+        keyPressedCommand();
 
-      keyReleasedCommand();
+        if ( FApplication::isQuit() )
+          return;
+      }
 
-      if ( FApplication::isQuit() )
-        return;
+      if ( state != KeyState::Held )
+      {
+        keyReleasedCommand();
+
+        if ( FApplication::isQuit() )
+          return;
+      }
 
       key = FKey::None;
     }
@@ -283,52 +322,221 @@ inline auto FKeyboard::getMouseProtocolKey() const -> FKey
 }
 
 //----------------------------------------------------------------------
-inline auto FKeyboard::getTermcapKey() -> FKey
+inline auto FKeyboard::getSequenceKey() -> FKey
 {
-  // Looking for termcap key strings in the buffer
+  // Looking for termcap and known key strings in the buffer.
+  // The key trie only processes the bytes added since the last call.
 
   static_assert ( FIFO_BUF_SIZE > 0, "FIFO buffer too small" );
+  const auto buf_len = fifo_buf.getSize();
+
+  if ( key_cursor.depth > buf_len )
+    key_cursor = {};
 
-  if ( key_cap_ptr.use_count() == 0 )
+  while ( key_cursor.depth < buf_len
+       && key_cursor.match != FKeyTrie::Match::None )
+  {
+    key_trie.advance (key_cursor, fifo_buf[key_cursor.depth]);
+  }
+
+  if ( key_cursor.match == FKeyTrie::Match::None )
     return NOT_SET;
 
-  const auto buf_len = fifo_buf.getSize();
-  auto found_key = fkeyhashmap::getTermcapKey(fifo_buf);
+  const auto found_key = key_trie.getKey(key_cursor);
 
-  if ( found_key != FKey::None )  // found
+  if ( found_key == FKey::None )  // Prefix of a longer key sequence
+    return isKeypressTimeout() ? NOT_SET : FKey::Incomplete;
+
+  if ( buf_len == 2
+    && ( fifo_buf[1] == 'O'
+      || fifo_buf[1] == '['
+      || fifo_buf[1] == ']' )
+    && ! isKeypressTimeout() )
   {
-    fifo_buf.pop(buf_len);  // Remove founded entry
-    return found_key;
+    return FKey::Incomplete;
   }
 
-  return NOT_SET;
+  fifo_buf.pop(buf_len);  // Remove founded entry
+  key_cursor = {};
+  return found_key;
 }
 
 //----------------------------------------------------------------------
-inline auto FKeyboard::getKnownKey() -> FKey
+auto FKeyboard::getKeyboardProtocolKey() -> FKey
 {
-  // Looking for a known key strings in the buffer
+  // Looking for a key event of the progressive keyboard enhancement
+  // protocol: CSI code[:alternates] [; modifiers[:event type]] final
+
+  if ( ! keyboard_protocol )
+    return NOT_SET;
 
-  static_assert ( FIFO_BUF_SIZE > 0, "FIFO buffer too small" );
   const auto buf_len = fifo_buf.getSize();
-  auto found_key = fkeyhashmap::getKnownKey(fifo_buf);
 
-  if ( found_key != FKey::None )  // found
+  if ( buf_len < 3 || fifo_buf[1] != '[' )
+    return NOT_SET;
+
+  const auto final_char = fifo_buf[buf_len - 1];
+  static constexpr char final_chars[] = "u~ABCDEFHPQS";
+
+  if ( final_char == '\0' || ! std::strchr(final_chars, final_char) )
+    return NOT_SET;
+
+  // Parameters: key code, modifiers (1 + bit mask), event type
+  std::array<uInt32, 3> param{{0, 1, 1}};
+  std::size_t field{0};
+  std::size_t sub_field{0};
+  bool first_digit{true};
+
+  for (std::size_t n{2}; n < buf_len - 1; n++)
   {
-    if ( buf_len == 2
-      && ( fifo_buf[1] == 'O'
-        || fifo_buf[1] == '['
-        || fifo_buf[1] == ']' )
-      && ! isKeypressTimeout() )
+    const auto ch = fifo_buf[n];
+    uInt32* value{nullptr};
+
+    if ( ch == ';' )
     {
-      return FKey::Incomplete;
+      field++;
+      sub_field = 0;
+      first_digit = true;
+    }
+    else if ( ch == ':' )
+    {
+      sub_field++;
+      first_digit = true;
     }
+    else if ( ch < '0' || ch > '9' )
+      return NOT_SET;  // Private or intermediate bytes
+    else if ( field == 0 && sub_field == 0 )
+      value = &param[0];
+    else if ( field == 1 && sub_field < 2 )
+      value = &param[1 + sub_field];
 
-    fifo_buf.pop(buf_len);  // Remove founded entry
-    return found_key;
+    if ( ! value )
+      continue;
+
+    if ( first_digit )
+      *value = 0;
+
+    first_digit = false;
+    *value = *value * 10 + uInt32(ch - '0');
+
+    if ( *value > 0x10ffff )
+      return NOT_SET;
   }
 
-  return NOT_SET;
+  // Caps lock (64) and num lock (128) are states and not modifiers.
+  // Super (8), hyper (16) and meta (32) have no legacy encoding.
+  constexpr uInt32 legacy_modifiers{0x07};  // Shift, alt and ctrl
+  const auto modifiers = ( param[1] > 0 )
+                       ? (param[1] - 1) & legacy_modifiers
+                       : 0;
+  const auto keycode = ( final_char == 'u' )
+                     ? getProtocolTextKey (param[0], modifiers)
+                     : getProtocolFunctionKey (param[0], modifiers, final_char);
+  fifo_buf.pop(buf_len);  // Remove founded entry
+
+  if ( ! key_release_events )
+    key_state = KeyState::Pressed;
+  else if ( param[2] == 3 )
+    key_state = KeyState::Released;
+  else if ( final_char == 'u'
+         && (param[0] == 9 || param[0] == 13 || param[0] == 127) )
+    key_state = KeyState::Pressed;  // Tab, Enter and Backspace are
+                                    // reported without a key release
+  else
+    key_state = KeyState::Held;
+
+  return keycode;
+}
+
+//----------------------------------------------------------------------
+auto FKeyboard::getProtocolTextKey (uInt32 code, uInt32 modifiers) const -> FKey
+{
+  // Converts a CSI u key code into the key of the legacy encoding
+
+  constexpr uInt32 shift{1};
+  constexpr uInt32 alt{2};
+  constexpr uInt32 ctrl{4};
+
+  if ( code == 27 )
+    return FKey::Escape;
+
+  if ( code == 9 && (modifiers & shift) )
+    return FKey::Back_tab;
+
+  if ( code < 0x20 && code != 9 && code != 13 )
+    return FKey::None;
+
+  if ( code >= 0xe000 && code <= 0xf8ff )
+    return FKey::None;  // Functional keys in the private use area
+
+  if ( (modifiers & shift) && code >= 'a' && code <= 'z' )
+    code -= 0x20;  // Upper case letter
+
+  if ( (modifiers & ctrl)
+    && ((code >= '@' && code <= '_') || (code >= 'a' && code <= 'z')) )
+    code &= 0x1f;  // Control character
+  else if ( (modifiers & ctrl) && code == ' ' )
+    code = 0;
+
+  if ( (modifiers & alt) && code < 0x80 )
+  {
+    // Meta key sequence (ESC prefix)
+    const std::array<char, 2> meta_seq{{ESC[0], char(code)}};
+    const auto meta_key = key_trie.find(meta_seq.data(), meta_seq.size());
+
+    if ( meta_key != FKey::None )
+      return meta_key;
+  }
+
+  if ( code == 0 )
+    return FKey::Ctrl_space;
+
+  if ( code == 127 )
+    return FKey::Backspace;
+
+  return FKey(code);
+}
+
+//----------------------------------------------------------------------
+auto FKeyboard::getProtocolFunctionKey ( uInt32 number, uInt32 modifiers
+                                       , char final_char ) const -> FKey
+{
+  // Searches the legacy sequence without the event type
+  // (e.g. CSI 1;5:3A → CSI 1;5A) in the key trie
+
+  std::string seq{ESC};
+
+  if ( modifiers == 0 && final_char != '~' )
+  {
+    // F1, F2 and F4 without modifiers use SS3 (ESC O)
+    const bool ss3 = ( final_char == 'P'
+                    || final_char == 'Q'
+                    || final_char == 'S' );
+    seq += ss3 ? 'O' : '[';
+  }
+  else if ( final_char == '~' )
+  {
+    seq += '[' + std::to_string(number);
+  }
+  else
+  {
+    seq += "[1";
+  }
+
+  if ( modifiers != 0 )
+    seq += ';' + std::to_string(modifiers + 1);
+
+  seq += final_char;
+  auto keycode = key_trie.find(seq.data(), seq.size());
+
+  if ( keycode == FKey::None && number == 13 && final_char == '~' && modifiers != 0 )
+  {
+    // F3 with modifiers (CSI 1;<modifiers>R)
+    seq = std::string{CSI "1;"} + std::to_string(modifiers + 1) + 'R';
+    keycode = key_trie.find(seq.data(), seq.size());
+  }
+
+  return keycode;
 }
 
 //----------------------------------------------------------------------
@@ -389,6 +597,117 @@ inline auto FKeyboard::isKeypressTimeout() -> bool
   return FObjectTimer::isTimeout (time_keypressed, key_timeout);
 }
 
+//----------------------------------------------------------------------
+auto FKeyboard::isIncompleteControlSequence() const -> bool
+{
+  // A control sequence (ESC [) ends with a byte from 0x40 to 0x7e.
+  // Parameter and intermediate bytes are in the range 0x20 to 0x3f.
+
+  const auto buf_len = fifo_buf.getSize();
+
+  if ( buf_len < 2 || fifo_buf[0] != ESC[0] || fifo_buf[1] != '[' )
+    return false;
+
+  for (std::size_t n{2}; n < buf_len; n++)
+  {
+    const auto ch = uChar(fifo_buf[n]);
+
+    if ( ch < 0x20 || ch > 0x3f )
+      return false;
+  }
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FKeyboard::isCompleteControlSequence() const -> bool
+{
+  // A control sequence (ESC [) or a SS3 sequence (ESC O) is complete
+  // with a final byte from 0x40 to 0x7e after the parameter and
+  // intermediate bytes
+
+  const auto buf_len = fifo_buf.getSize();
+
+  if ( buf_len < 3
+    || fifo_buf[0] != ESC[0]
+    || (fifo_buf[1] != '[' && fifo_buf[1] != 'O') )
+    return false;
+
+  for (std::size_t n{2}; n < buf_len - 1; n++)
+  {
+    const auto ch = uChar(fifo_buf[n]);
+
+    if ( ch < 0x20 || ch > 0x3f )
+      return false;
+  }
+
+  const auto final_byte = uChar(fifo_buf[buf_len - 1]);
+  return final_byte >= 0x40 && final_byte <= 0x7e;
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::discardUnknownSequence()
+{
+  // Drops a complete control sequence without a key assignment.
+  // The following input remains in the read buffer.
+
+  fifo_buf.clear();
+  key_cursor = {};
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::buildKeyTrie()
+{
+  // Compiles the termcap and the known key sequences into the key
+  // trie. Termcap entries take precedence over the known keys.
+
+  key_trie.clear();
+  key_cursor = {};
+
+  if ( key_cap_ptr )
+  {
+    for (auto iter = key_cap_ptr->cbegin(); iter != key_cap_end; ++iter)
+      if ( iter->string && iter->length != 0 )
+        key_trie.insert (iter->string, iter->length, iter->num);
+  }
+
+  for (const auto& item : FKeyMap::getKeyMap())
+    if ( item.length != 0 )
+      key_trie.insert (item.string.data(), item.length, item.num);
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::queueKeyEvent()
+{
+  // A reported key release is only passed on for a held key
+
+  if ( key_state == KeyState::Pressed )
+  {
+    fkey_queue.emplace(fkey);
+    return;
+  }
+
+  const auto iter = std::find(held_keys.cbegin(), held_keys.cend(), fkey);
+
+  if ( key_state == KeyState::Held )
+  {
+    if ( iter == held_keys.cend() )
+    {
+      if ( held_keys.size() >= MAX_QUEUE_SIZE )  // Lost key releases
+        held_keys.erase(held_keys.cbegin());
+
+      held_keys.push_back(fkey);
+    }
+
+    fkey_queue.emplace(fkey, KeyState::Held);
+  }
+  else if ( iter != held_keys.cend() )
+  {
+    held_keys.erase(iter);
+    fkey_queue.emplace(fkey, KeyState::Released);
+  }
+}
+
 //----------------------------------------------------------------------
 auto FKeyboard::UTF8decode (const std::size_t len) const noexcept -> FKey
 {
@@ -438,31 +757,59 @@ auto FKeyboard::UTF8decode (const std::size_t len) const noexcept -> FKey
 }
 
 //----------------------------------------------------------------------
-inline auto FKeyboard::readKey() -> ssize_t
+inline auto FKeyboard::readKeys() -> ssize_t
 {
-  setNonBlockingInput();
-  const ssize_t bytes = read(FTermios::getStdIn(), &read_character, 1);
-  unsetNonBlockingInput();
+  // Reads all available input bytes with a single system call.
+  // Stdin shares its open file description with stdout on a tty
+  // and therefore stays in blocking mode. The read only takes
+  // place when poll() reports waiting input.
+
+  struct pollfd fds{FTermios::getStdIn(), POLLIN, 0};
+
+  if ( poll(&fds, 1, 0) <= 0 )
+    return 0;  // No input available
+
+  const ssize_t bytes = read(FTermios::getStdIn(), read_buf.data(), read_buf.size());
+  read_pos = 0;
+  read_len = ( bytes > 0 ) ? std::size_t(bytes) : 0;
+
+  if ( bytes > 0 )
+    time_keypressed = FObjectTimer::getCurrentTime();
+
   return bytes;
 }
 
 //----------------------------------------------------------------------
 void FKeyboard::parseKeyBuffer()
 {
-  while ( readKey() > 0 )
+  while ( hasReadBufferData() || readKeys() > 0 )
   {
-    time_keypressed = FObjectTimer::getCurrentTime();
     has_pending_input = false;
+    const auto read_character = read_buf[read_pos];
+    read_pos++;
 
-    if ( ! fifo_buf.isFull() )
+    if ( paste_mode )
+      parsePasteInput (read_character);
+    else if ( ! fifo_buf.isFull() )
       fifo_buf.push(read_character);
 
     // Read the rest from the fifo buffer
     while ( fifo_buf.hasData() && fkey != FKey::Incomplete )
     {
       fkey = parseKeyString();
+
+      if ( fkey != FKey::Incomplete )
+        key_cursor = {};  // The buffer start has changed
+
       fkey = keyCorrection(fkey);
 
+      if ( fkey == FKey::Bracketed_paste )
+      {
+        // The following input is collected as pasted text
+        paste_mode = true;
+        break;
+      }
+
       if ( fkey == FKey::X11mouse
         || fkey == FKey::Extended_mouse
         || fkey == FKey::Urxvt_mouse )
@@ -472,8 +819,8 @@ void FKeyboard::parseKeyBuffer()
         break;
       }
 
-      if ( fkey != FKey::Incomplete )
-        fkey_queue.emplace(fkey);
+      if ( fkey != FKey::Incomplete && fkey != FKey::None )
+        queueKeyEvent();
     }
 
     fkey = FKey::None;
@@ -481,12 +828,60 @@ void FKeyboard::parseKeyBuffer()
     if ( fkey_queue.isFull() )
       break;
   }
+
+  // Bytes that are already read are processed with the next call
+  has_pending_input = hasReadBufferData();
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::parsePasteInput (char ch)
+{
+  // Collects the pasted text up to the end sequence (ESC [ 2 0 1 ~)
+
+  static constexpr std::array<char, 6> paste_end{{'\033', '[', '2', '0', '1', '~'}};
+  paste_buf.push_back(ch);
+
+  if ( paste_buf.size() >= paste_end.size() && ch == paste_end.back() )
+  {
+    const auto start = paste_buf.size() - paste_end.size();
+
+    if ( paste_buf.compare(start, paste_end.size(), paste_end.data(), paste_end.size()) == 0 )
+    {
+      paste_buf.resize(start);
+      queuePasteText (start);
+      paste_mode = false;
+      return;
+    }
+  }
+
+  if ( paste_buf.size() >= MAX_PASTE_SIZE )
+  {
+    // Passes a large paste in parts. The tail stays in the buffer
+    // for a split end sequence or UTF-8 character.
+    auto length = paste_buf.size() - paste_end.size() + 1;
+
+    while ( length > 0 && (uChar(paste_buf[length]) & 0xc0) == 0x80 )
+      length--;
+
+    queuePasteText (length);
+  }
+}
+
+//----------------------------------------------------------------------
+void FKeyboard::queuePasteText (std::size_t length)
+{
+  // Queues the first length bytes of the collected paste text
+
+  paste_queue.emplace(paste_buf, 0, length);
+  paste_buf.erase(0, length);
+  fkey_queue.emplace(FKey::Bracketed_paste);
 }
 
 //----------------------------------------------------------------------
 auto FKeyboard::parseKeyString() -> FKey
 {
   const auto& firstchar = fifo_buf.front();
+  key_state = KeyState::Pressed;
 
   if ( firstchar != ESC[0] )
     return getSingleKey();
@@ -499,17 +894,32 @@ auto FKeyboard::parseKeyString() -> FKey
   if ( keycode != NOT_SET )
     return keycode;
 
-  keycode = getTermcapKey();
+  keycode = getSequenceKey();
 
   if ( keycode != NOT_SET )
     return keycode;
 
-  keycode = getKnownKey();
+  keycode = getKeyboardProtocolKey();
 
   if ( keycode != NOT_SET )
     return keycode;
 
-  return isKeypressTimeout() ? getSingleKey() : FKey::Incomplete;
+  if ( isKeypressTimeout() )
+    return getSingleKey();
+
+  if ( key_cursor.match != FKeyTrie::Match::None
+    || isIncompleteControlSequence() )
+    return FKey::Incomplete;
+
+  if ( isCompleteControlSequence() )
+  {
+    // No key is assigned to this control sequence
+    discardUnknownSequence();
+    return FKey::None;
+  }
+
+  // Other input (e.g. meta + UTF-8 character) after the keypress timeout
+  return FKey::Incomplete;
 }
 
 //----------------------------------------------------------------------
@@ -554,9 +964,40 @@ void FKeyboard::substringKeyHandling()
 
     fkey_queue.emplace(fkey);
     fifo_buf.clear();
+    key_cursor = {};
   }
 }
 
+//----------------------------------------------------------------------
+void FKeyboard::unknownMetaKeyHandling()
+{
+  // A meta key combination without a key code (e.g. meta + UTF-8
+  // character) passes the following characters after a timeout
+
+  if ( fifo_buf.getSize() < 2
+    || fifo_buf[0] != 0x1b
+    || fifo_buf[1] == 'O' || fifo_buf[1] == '[' || fifo_buf[1] == ']'
+    || ! isKeypressTimeout() )
+    return;
+
+  fifo_buf.pop(1);  // Remove the escape prefix
+  key_cursor = {};
+
+  while ( fifo_buf.hasData() && ! fkey_queue.isFull() )
+  {
+    fkey = keyCorrection(parseKeyString());
+    key_cursor = {};
+
+    if ( fkey == FKey::Incomplete )
+      break;
+
+    if ( fkey != FKey::None )
+      queueKeyEvent();
+  }
+
+  fkey = FKey::None;
+}
+
 //----------------------------------------------------------------------
 void FKeyboard::keyPressedCommand() const
 {
@@ -581,4 +1022,10 @@ void FKeyboard::mouseTrackingCommand() const
   mouse_tracking_cmd.execute();
 }
 
+//----------------------------------------------------------------------
+void FKeyboard::pasteCommand() const
+{
+  paste_cmd.execute();
+}
+
 }  // namespace finalcut
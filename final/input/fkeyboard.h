@@ -41,12 +41,15 @@
 #include <array>
 #include <functional>
 #include <memory>
+#include <queue>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "final/ftypes.h"
 #include "final/input/fkey_hashmap.h"
 #include "final/input/fkey_map.h"
+#include "final/input/fkey_trie.h"
 #include "final/util/char_ringbuffer.h"
 #include "final/util/fstring.h"
 
@@ -116,6 +119,7 @@ class FKeyboard final
     auto  getKey() const noexcept -> FKey;
     auto  getKeyName (const FKey) const -> FString;
     auto  getKeyBuffer() & noexcept -> keybuffer&;
+    auto  getPasteText() const & noexcept -> const std::string&;
     auto  getKeyPressedTime() const noexcept -> TimeValue;
     static auto  getKeypressTimeout() noexcept -> uInt64;
     static auto  getReadBlockingTime() noexcept -> uInt64;
@@ -133,12 +137,19 @@ class FKeyboard final
     void  disableUTF8() noexcept;
     void  enableMouseSequences() noexcept;
     void  disableMouseSequences() noexcept;
+    void  enableKeyboardProtocol() noexcept;
+    void  disableKeyboardProtocol() noexcept;
+    void  enableKeyReleaseEvents() noexcept;
     void  setPressCommand (const FKeyboardCommand&);
     void  setReleaseCommand (const FKeyboardCommand&);
     void  setEscPressedCommand (const FKeyboardCommand&);
     void  setMouseTrackingCommand (const FKeyboardCommand&);
+    void  setPasteCommand (const FKeyboardCommand&);
 
     // Inquiry
+    auto  isInPasteMode() const noexcept -> bool;
+    auto  hasKeyboardProtocol() const noexcept -> bool;
+    auto  hasKeyReleaseEvents() const noexcept -> bool;
     auto  hasPendingInput() const noexcept -> bool;
     auto  hasDataInQueue() const -> bool;
 
@@ -155,39 +166,76 @@ class FKeyboard final
     // Constants
     static constexpr FKey NOT_SET = static_cast<FKey>(-2);
     static constexpr std::size_t MAX_QUEUE_SIZE = 32;
+    static constexpr std::size_t READ_BUF_SIZE = 4096;
+    static constexpr std::size_t MAX_PASTE_SIZE = 1024 * 1024;
+
+    // Enumeration
+    enum class KeyState : uInt8
+    {
+      Pressed,   // Key press with an immediate key release
+      Held,      // The terminal reports the key release later
+      Released   // Reported key release
+    };
+
+    struct KeyEvent
+    {
+      KeyEvent() = default;
+      KeyEvent (FKey k, KeyState s = KeyState::Pressed) noexcept
+        : key{k}
+        , state{s}
+      { }
+
+      FKey     key{FKey::None};
+      KeyState state{KeyState::Pressed};
+    };
 
     // Using-declaration
     using FKeyMapPtr = std::shared_ptr<FKeyMap::KeyCapMapType>;
     using KeyMapEnd = FKeyMap::KeyCapMapType::const_iterator;
-    using KeyQueue = FRingBuffer<FKey, MAX_QUEUE_SIZE>;
+    using KeyQueue = FRingBuffer<KeyEvent, MAX_QUEUE_SIZE>;
+    using ReadBuffer = std::array<char, READ_BUF_SIZE>;
+    using PasteQueue = std::queue<std::string>;
 
     // Accessors
     auto  getMouseProtocolKey() const -> FKey;
-    auto  getTermcapKey() -> FKey;
-    auto  getKnownKey() -> FKey;
+    auto  getSequenceKey() -> FKey;
+    auto  getKeyboardProtocolKey() -> FKey;
+    auto  getProtocolTextKey (uInt32, uInt32) const -> FKey;
+    auto  getProtocolFunctionKey (uInt32, uInt32, char) const -> FKey;
     auto  getSingleKey() -> FKey;
 
     // Inquiry
     static auto isKeypressTimeout() -> bool;
     static auto isIntervalTimeout() -> bool;
+    auto  hasReadBufferData() const noexcept -> bool;
+    auto  isIncompleteControlSequence() const -> bool;
 
     // Methods
+    auto  isCompleteControlSequence() const -> bool;
+    void  discardUnknownSequence();
+    void  buildKeyTrie();
+    void  queueKeyEvent();
     auto  UTF8decode (const std::size_t) const noexcept -> FKey;
-    auto  readKey() -> ssize_t;
+    auto  readKeys() -> ssize_t;
     void  parseKeyBuffer();
+    void  parsePasteInput (char);
+    void  queuePasteText (std::size_t);
     auto  parseKeyString() -> FKey;
     auto  keyCorrection (const FKey&) const -> FKey;
     void  substringKeyHandling();
+    void  unknownMetaKeyHandling();
     void  keyPressedCommand() const;
     void  keyReleasedCommand() const;
     void  escapeKeyPressedCommand() const;
     void  mouseTrackingCommand() const;
+    void  pasteCommand() const;
 
     // Data members
     FKeyboardCommand  keypressed_cmd{};
     FKeyboardCommand  keyreleased_cmd{};
     FKeyboardCommand  escape_key_cmd{};
     FKeyboardCommand  mouse_tracking_cmd{};
+    FKeyboardCommand  paste_cmd{};
 
     static TimeValue  time_keypressed;
     static uInt64     read_blocking_time;
@@ -196,17 +244,29 @@ class FKeyboard final
     static bool       non_blocking_input_support;
     FKeyMapPtr        key_cap_ptr{};
     KeyMapEnd         key_cap_end{};
+    FKeyTrie          key_trie{};
+    FKeyTrie::Cursor  key_cursor{};
     keybuffer         fifo_buf{};
     KeyQueue          fkey_queue{};
+    ReadBuffer        read_buf{};
+    std::size_t       read_pos{0};
+    std::size_t       read_len{0};
+    std::string       paste_buf{};
+    std::string       paste_text{};
+    PasteQueue        paste_queue{};
+    std::vector<FKey> held_keys{};
     FKey              fkey{FKey::None};
     FKey              key{FKey::None};
+    KeyState          key_state{KeyState::Pressed};
     int               stdin_status_flags{0};
-    char              read_character{};
     bool              has_pending_input{false};
+    bool              paste_mode{false};
     bool              fifo_in_use{false};
     bool              utf8_input{false};
     bool              mouse_support{true};
     bool              non_blocking_stdin{false};
+    bool              keyboard_protocol{false};
+    bool              key_release_events{false};
 };
 
 // FKeyboard inline functions
@@ -222,6 +282,10 @@ inline auto FKeyboard::getKey() const noexcept -> FKey
 inline auto FKeyboard::getKeyBuffer() & noexcept -> keybuffer&
 { return fifo_buf; }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::getPasteText() const & noexcept -> const std::string&
+{ return paste_text; }
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::getKeyPressedTime() const noexcept -> TimeValue
 { return time_keypressed; }
@@ -240,7 +304,7 @@ inline void FKeyboard::setTermcapMap (const T& keymap)
 {
   key_cap_ptr = std::make_shared<T>(keymap);
   key_cap_end = key_cap_ptr->cend();
-  fkeyhashmap::setKeyCapMap<keybuffer>(key_cap_ptr->cbegin(), key_cap_end);
+  buildKeyTrie();
 }
 
 //----------------------------------------------------------------------
@@ -254,7 +318,7 @@ inline void FKeyboard::setTermcapMap()
                              , [] (const FKeyMap::KeyCapMap& entry)
                                { return entry.length == 0; }
                              );
-  fkeyhashmap::setKeyCapMap<keybuffer>(key_cap_ptr->cbegin(), key_cap_end);
+  buildKeyTrie();
 }
 
 //----------------------------------------------------------------------
@@ -273,6 +337,18 @@ inline void FKeyboard::setNonBlockingInputSupport (bool enable) noexcept
 inline void FKeyboard::unsetNonBlockingInput() noexcept
 { setNonBlockingInput(false); }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::isInPasteMode() const noexcept -> bool
+{ return paste_mode; }
+
+//----------------------------------------------------------------------
+inline auto FKeyboard::hasKeyboardProtocol() const noexcept -> bool
+{ return keyboard_protocol; }
+
+//----------------------------------------------------------------------
+inline auto FKeyboard::hasKeyReleaseEvents() const noexcept -> bool
+{ return key_release_events; }
+
 //----------------------------------------------------------------------
 inline auto FKeyboard::hasPendingInput() const noexcept -> bool
 { return has_pending_input; }
@@ -281,6 +357,10 @@ inline auto FKeyboard::hasPendingInput() const noexcept -> bool
 inline auto FKeyboard::hasDataInQueue() const -> bool
 { return ! fkey_queue.isEmpty(); }
 
+//----------------------------------------------------------------------
+inline auto FKeyboard::hasReadBufferData() const noexcept -> bool
+{ return read_pos < read_len; }
+
 //----------------------------------------------------------------------
 inline void FKeyboard::enableUTF8() noexcept
 { utf8_input = true; }
@@ -297,6 +377,22 @@ inline void FKeyboard::enableMouseSequences() noexcept
 inline void FKeyboard::disableMouseSequences() noexcept
 { mouse_support = false; }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::enableKeyboardProtocol() noexcept
+{ keyboard_protocol = true; }
+
+//----------------------------------------------------------------------
+inline void FKeyboard::disableKeyboardProtocol() noexcept
+{
+  keyboard_protocol = false;
+  key_release_events = false;
+  held_keys.clear();
+}
+
+//----------------------------------------------------------------------
+inline void FKeyboard::enableKeyReleaseEvents() noexcept
+{ key_release_events = keyboard_protocol; }
+
 //----------------------------------------------------------------------
 inline void FKeyboard::setPressCommand (const FKeyboardCommand& cmd)
 { keypressed_cmd = cmd; }
@@ -313,6 +409,10 @@ inline void FKeyboard::setEscPressedCommand (const FKeyboardCommand& cmd)
 inline void FKeyboard::setMouseTrackingCommand (const FKeyboardCommand& cmd)
 { mouse_tracking_cmd = cmd; }
 
+//----------------------------------------------------------------------
+inline void FKeyboard::setPasteCommand (const FKeyboardCommand& cmd)
+{ paste_cmd = cmd; }
+
 }  // namespace finalcut
 
 #endif  // FKEYBOARD_H
@@ -185,6 +185,27 @@ auto FMouseData::isMoved() const noexcept -> bool
   return getButtonState().mouse_moved;
 }
 
+//----------------------------------------------------------------------
+auto FMouseData::isSameMove (const FMouseData& md) const noexcept -> bool
+{
+  // Both are mouse moves with the same button and modifier key state
+
+  const auto& b1 = getButtonState();
+  const auto& b2 = md.getButtonState();
+
+  return b1.mouse_moved && b2.mouse_moved
+      && b1.left_button == b2.left_button
+      && b1.right_button == b2.right_button
+      && b1.middle_button == b2.middle_button
+      && b1.shift_button == b2.shift_button
+      && b1.control_button == b2.control_button
+      && b1.meta_button == b2.meta_button
+      && b1.wheel_up == b2.wheel_up
+      && b1.wheel_down == b2.wheel_down
+      && b1.wheel_left == b2.wheel_left
+      && b1.wheel_right == b2.wheel_right;
+}
+
 //----------------------------------------------------------------------
 void FMouseData::clearButtonState() noexcept
 {
@@ -1764,7 +1785,7 @@ void FMouseControl::processQueuedInput()
     FMouseDataPtr md(std::move(fmousedata_queue.front()));
     fmousedata_queue.pop();
 
-    if ( md )
+    if ( md && ! isReplacedByNextMove(*md) )
     {
       setCurrentMouseEvent (md);
       event_cmd.execute(*md);
@@ -1892,4 +1913,18 @@ void FMouseControl::resetCurrentMouseEvent()
   getCurrentMouseEvent() = nullptr;
 }
 
+//----------------------------------------------------------------------
+inline auto FMouseControl::isReplacedByNextMove (const FMouseData& md) const -> bool
+{
+  // Consecutive mouse moves with the same button state are combined
+  // into the last position. Clicks, releases and wheel events always
+  // keep their order.
+
+  if ( ! move_coalescing || fmousedata_queue.isEmpty() )
+    return false;
+
+  const auto& next = fmousedata_queue.front();
+  return next && md.isSameMove(*next);
+}
+
 }  // namespace finalcut
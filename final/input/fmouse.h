@@ -130,6 +130,7 @@ class FMouseData
     auto isWheelLeft() const noexcept -> bool;
     auto isWheelRight() const noexcept -> bool;
     auto isMoved() const noexcept -> bool;
+    auto isSameMove (const FMouseData&) const noexcept -> bool;
 
     // Methods
     void clearButtonState() noexcept;
@@ -610,6 +611,8 @@ class FMouseControl
     void  setDisableXTermMouseCommand (const FMouseCommand&);
     void  useGpmMouse (bool = true);
     void  useXtermMouse (bool = true);
+    void  setMoveCoalescing (bool = true) noexcept;
+    void  unsetMoveCoalescing() noexcept;
 
     // Inquiries
     auto  hasData() -> bool;
@@ -632,6 +635,7 @@ class FMouseControl
     auto  hasUnprocessedInput() const -> bool;
     auto  hasDataInQueue() const -> bool;
     auto  isGpmMouseEnabled() noexcept -> bool;
+    auto  hasMoveCoalescing() const noexcept -> bool;
 
     // Methods
     void  enable();
@@ -664,6 +668,9 @@ class FMouseControl
     static void  setCurrentMouseEvent (const FMouseDataPtr&);
     static void  resetCurrentMouseEvent();
 
+    // Inquiry
+    auto  isReplacedByNextMove (const FMouseData&) const -> bool;
+
     // Data member
     FMouseProtocol  mouse_protocol{};
     FMouseCommand   event_cmd{};
@@ -673,6 +680,7 @@ class FMouseControl
     FPoint          zero_point{0, 0};
     bool            use_gpm_mouse{false};
     bool            use_xterm_mouse{false};
+    bool            move_coalescing{true};
 };
 
 // FMouseControl inline functions
@@ -692,6 +700,18 @@ inline void FMouseControl::setEnableXTermMouseCommand (const FMouseCommand& cmd)
 inline void FMouseControl::setDisableXTermMouseCommand (const FMouseCommand& cmd)
 { disable_xterm_mouse_cmd = cmd; }
 
+//----------------------------------------------------------------------
+inline void FMouseControl::setMoveCoalescing (bool enable) noexcept
+{ move_coalescing = enable; }
+
+//----------------------------------------------------------------------
+inline void FMouseControl::unsetMoveCoalescing() noexcept
+{ move_coalescing = false; }
+
+//----------------------------------------------------------------------
+inline auto FMouseControl::hasMoveCoalescing() const noexcept -> bool
+{ return move_coalescing; }
+
 //----------------------------------------------------------------------
 inline auto FMouseControl::hasDataInQueue() const -> bool
 { return ! fmousedata_queue.isEmpty(); }
@@ -79,6 +79,8 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     virtual auto getMaxColor() const -> int = 0;
     virtual auto getEncoding() const -> Encoding = 0;
     virtual auto getKeyName (FKey) const -> FString = 0;
+    virtual auto getFlushDeadline() const -> TimeValue = 0;
+    virtual auto getFramePacing() const -> FramePacing;
 
     // Mutators
     virtual void setCursor (FPoint) = 0;
@@ -89,6 +91,8 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     virtual auto setVGAFont() -> bool = 0;
     virtual auto setNewFont() -> bool = 0;
     virtual void setNonBlockingRead (bool = true) = 0;
+    virtual void setFramePacing (FramePacing);
+    virtual void setTargetFrameRate (uInt);
     template <typename ClassT>
     void         setColorPaletteTheme() const;
     template <typename ClassT>
@@ -106,6 +110,7 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     virtual auto hasHalfBlockCharacter() const -> bool = 0;
     virtual auto hasShadowCharacter() const -> bool = 0;
     virtual auto areMetaAndArrowKeysSupported() const -> bool = 0;
+    virtual auto hasPendingOutput() const -> bool = 0;
 
     // Methods
     virtual void initTerminal (FVTerm::FTermArea*) = 0;
@@ -120,6 +125,8 @@ class FOutput : public std::enable_shared_from_this<FOutput>
     virtual void clearTerminalState() = 0;
     virtual auto clearTerminal (wchar_t = L' ') -> bool = 0;
     virtual void flush() = 0;
+    virtual void flushPendingOutput() = 0;
+    virtual void measureOutputBacklog();
     virtual void beep() const = 0;
 
   private:
@@ -144,6 +151,22 @@ inline auto FOutput::getClassName() const -> FString
 inline auto FOutput::getFVTerm() const & -> const FVTerm&
 { return fvterm; }
 
+//----------------------------------------------------------------------
+inline auto FOutput::getFramePacing() const -> FramePacing
+{ return FramePacing::Unthrottled; }  // No frame pacer
+
+//----------------------------------------------------------------------
+inline void FOutput::setFramePacing (FramePacing)
+{ }
+
+//----------------------------------------------------------------------
+inline void FOutput::setTargetFrameRate (uInt)
+{ }
+
+//----------------------------------------------------------------------
+inline void FOutput::measureOutputBacklog()
+{ }
+
 //----------------------------------------------------------------------
 template <typename ClassT>
 inline void FOutput::setColorPaletteTheme() const
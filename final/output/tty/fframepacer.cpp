@@ -0,0 +1,225 @@
+/***********************************************************************
+* fframepacer.cpp - Frame pacing of the terminal output                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <stdexcept>
+
+#include "final/output/tty/fframepacer.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr uInt64      FFramePacer::MIN_FRAME_TIME;
+constexpr uInt64      FFramePacer::MAX_FRAME_TIME;
+constexpr uInt        FFramePacer::DEFAULT_FRAME_RATE;
+constexpr std::size_t FFramePacer::MIN_BACKLOG;
+
+
+//----------------------------------------------------------------------
+// class FFramePacer
+//----------------------------------------------------------------------
+
+// public methods of FFramePacer
+//----------------------------------------------------------------------
+auto FFramePacer::getFrameTime() const -> uInt64
+{
+  // Returns the minimum time between two frames in microseconds
+
+  if ( pacing == FramePacing::Unthrottled )
+    return 0;
+
+  if ( pacing == FramePacing::TargetRate )
+    return 1'000'000 / uInt64(target_rate);
+
+  // Adaptive pacing: A frame must not be shorter than the time
+  // it takes to send it or to empty the backlog after writing
+  uInt64 frame_time{MIN_FRAME_TIME};
+
+  if ( throughput > 0 )
+    frame_time = std::max(frame_time, bytes_per_frame * 1'000'000 / throughput);
+
+  frame_time = std::max(frame_time, write_latency);
+  return std::min(frame_time, MAX_FRAME_TIME);
+}
+
+//----------------------------------------------------------------------
+auto FFramePacer::getNextFrameTime() const -> TimeValue
+{
+  // Returns the earliest time at which the next frame can be written
+
+  auto next = last_frame + std::chrono::microseconds(getFrameTime());
+
+  if ( ! isBehind(last_backlog) )
+    return next;
+
+  // Estimate when the backlog has been reduced to one frame
+  const auto limit = std::max(std::size_t(bytes_per_frame), MIN_BACKLOG);
+  uInt64 drain_time{MIN_FRAME_TIME};
+
+  if ( throughput > 0 )
+  {
+    drain_time = uInt64(last_backlog - limit) * 1'000'000 / throughput;
+    drain_time = std::max(std::min(drain_time, MAX_FRAME_TIME), MIN_FRAME_TIME);
+  }
+
+  return std::max(next, last_measure + std::chrono::microseconds(drain_time));
+}
+
+//----------------------------------------------------------------------
+void FFramePacer::setTargetFrameRate (uInt rate)
+{
+  if ( rate == 0 )
+    throw std::invalid_argument{"The frame rate must be at least 1 Hz"};
+
+  target_rate = rate;
+  pacing = FramePacing::TargetRate;
+}
+
+//----------------------------------------------------------------------
+auto FFramePacer::isBehind (std::size_t backlog) const -> bool
+{
+  // The link falls behind if more than one frame is still waiting
+
+  if ( pacing == FramePacing::Unthrottled )
+    return false;
+
+  return backlog > std::max(std::size_t(bytes_per_frame), MIN_BACKLOG);
+}
+
+//----------------------------------------------------------------------
+auto FFramePacer::isFrameDue (const TimeValue& now) const -> bool
+{
+  // Decides with the last backlog sample
+
+  if ( pacing == FramePacing::Unthrottled )
+    return true;
+
+  if ( now < last_frame + std::chrono::microseconds(getFrameTime()) )
+    return false;
+
+  return ! isBehind(last_backlog);
+}
+
+//----------------------------------------------------------------------
+void FFramePacer::recordBacklog (const TimeValue& now, std::size_t backlog)
+{
+  // Takes a new backlog sample while a frame is waiting and counts
+  // the frame as dropped if the backlog holds it back
+
+  measure (now, backlog);
+
+  // Only one dropped frame is counted per frame time
+  if ( isBehind(backlog) && now >= drop_deadline
+    && now >= last_frame + std::chrono::microseconds(getFrameTime()) )
+  {
+    dropped_frames++;
+    drop_deadline = now + std::chrono::microseconds(getFrameTime());
+  }
+}
+
+//----------------------------------------------------------------------
+void FFramePacer::measure (const TimeValue& now, std::size_t backlog)
+{
+  // Estimates the throughput and the write latency from the change
+  // of the output backlog since the last sample
+
+  if ( last_measure != TimeValue{} && now > last_measure )
+  {
+    const auto usec = getMicroseconds(last_measure, now);
+
+    if ( last_backlog > backlog && usec > 0 )
+    {
+      const auto rate = uInt64(last_backlog - backlog) * 1'000'000 / usec;
+
+      if ( backlog > 0 )
+        smooth (throughput, rate);  // The link was busy all the time
+      else if ( rate > throughput )
+        throughput = rate;  // Lower bound of the throughput
+    }
+
+    if ( last_backlog > 0 && backlog == 0 && usec <= MAX_FRAME_TIME )
+      smooth (write_latency, getMicroseconds(last_frame, now));
+  }
+
+  last_measure = now;
+  last_backlog = backlog;
+}
+
+//----------------------------------------------------------------------
+void FFramePacer::frameWritten ( const TimeValue& now
+                               , std::size_t bytes
+                               , std::size_t backlog )
+{
+  smooth (bytes_per_frame, bytes);
+
+  if ( backlog == 0 )
+    smooth (write_latency, 0);  // The terminal took the frame at once
+
+  last_frame = now;
+  last_measure = now;
+  last_backlog = backlog;
+  drop_deadline = TimeValue{};
+}
+
+//----------------------------------------------------------------------
+void FFramePacer::reset()
+{
+  // Discards all measurements, but keeps the pacing mode
+
+  last_frame = TimeValue{};
+  last_measure = TimeValue{};
+  drop_deadline = TimeValue{};
+  last_backlog = 0;
+  bytes_per_frame = 0;
+  throughput = 0;
+  write_latency = 0;
+  dropped_frames = 0;
+}
+
+
+// private methods of FFramePacer
+//----------------------------------------------------------------------
+auto FFramePacer::getMicroseconds ( const TimeValue& from
+                                  , const TimeValue& to ) -> uInt64
+{
+  if ( to <= from )
+    return 0;
+
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  return uInt64(duration_cast<microseconds>(to - from).count());
+}
+
+//----------------------------------------------------------------------
+void FFramePacer::smooth (uInt64& value, uInt64 sample)
+{
+  // Exponential moving average with a weight of 1/4 for new samples
+
+  if ( value == 0 )
+    value = sample;
+  else
+    value = (3 * value + sample) / 4;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,155 @@
+/***********************************************************************
+* fframepacer.h - Frame pacing of the terminal output                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FFramePacer ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The frame pacer decides when the next terminal update may be
+ *  written. It uses the output backlog, i.e. the bytes that were
+ *  written but not yet sent to the terminal, to measure how fast
+ *  the terminal drains the output:
+ *
+ *   - Adaptive:    The frame time follows the bytes per frame and
+ *                  the measured throughput (120 Hz up to 5 Hz)
+ *   - TargetRate:  Fixed number of frames per second
+ *   - Unthrottled: Every update is written immediately
+ *
+ *  In the adaptive and the target rate mode, no frame is written
+ *  while more than one frame is waiting in the backlog. The changes
+ *  of the held frames are combined into the next written frame.
+ */
+
+#ifndef FFRAMEPACER_H
+#define FFRAMEPACER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include "final/fc.h"
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FFramePacer
+//----------------------------------------------------------------------
+
+class FFramePacer final
+{
+  public:
+    // Constants
+    static constexpr uInt64 MIN_FRAME_TIME = 8'333;     //   8.3 ms = 120 Hz
+    static constexpr uInt64 MAX_FRAME_TIME = 200'000;   // 200.0 ms = 5 Hz
+    static constexpr uInt   DEFAULT_FRAME_RATE = 60;
+    //   A smaller backlog never holds back a frame
+    static constexpr std::size_t MIN_BACKLOG = 4'096;
+
+    // Constructor
+    FFramePacer() = default;
+
+    // Accessors
+    static auto getClassName() -> FString;
+    auto getPacing() const noexcept -> FramePacing;
+    auto getTargetFrameRate() const noexcept -> uInt;
+    auto getFrameTime() const -> uInt64;
+    auto getBytesPerFrame() const noexcept -> uInt64;
+    auto getThroughput() const noexcept -> uInt64;
+    auto getWriteLatency() const noexcept -> uInt64;
+    auto getDroppedFrames() const noexcept -> uInt64;
+    auto getNextFrameTime() const -> TimeValue;
+
+    // Mutators
+    void setPacing (FramePacing) noexcept;
+    void setTargetFrameRate (uInt);
+
+    // Inquiries
+    auto isBehind (std::size_t) const -> bool;
+    auto isFrameDue (const TimeValue&) const -> bool;
+
+    // Methods
+    void measure (const TimeValue&, std::size_t);
+    void recordBacklog (const TimeValue&, std::size_t);
+    void frameWritten (const TimeValue&, std::size_t, std::size_t);
+    void reset();
+
+  private:
+    // Methods
+    static auto getMicroseconds (const TimeValue&, const TimeValue&) -> uInt64;
+    static void smooth (uInt64&, uInt64);
+
+    // Data members
+    FramePacing pacing{FramePacing::Adaptive};
+    uInt        target_rate{DEFAULT_FRAME_RATE};
+    TimeValue   last_frame{};          // Time of the last written frame
+    TimeValue   last_measure{};        // Time of the last backlog sample
+    TimeValue   drop_deadline{};       // Counts the next held frame
+    std::size_t last_backlog{0};       // Backlog at the last sample
+    uInt64      bytes_per_frame{0};    // Moving average
+    uInt64      throughput{0};         // Bytes per second (0 = unknown)
+    uInt64      write_latency{0};      // Time until the backlog is empty
+    uInt64      dropped_frames{0};     // Frames held back by the backlog
+};
+
+// FFramePacer inline functions
+//----------------------------------------------------------------------
+inline auto FFramePacer::getClassName() -> FString
+{ return "FFramePacer"; }
+
+//----------------------------------------------------------------------
+inline auto FFramePacer::getPacing() const noexcept -> FramePacing
+{ return pacing; }
+
+//----------------------------------------------------------------------
+inline auto FFramePacer::getTargetFrameRate() const noexcept -> uInt
+{ return target_rate; }
+
+//----------------------------------------------------------------------
+inline auto FFramePacer::getBytesPerFrame() const noexcept -> uInt64
+{ return bytes_per_frame; }
+
+//----------------------------------------------------------------------
+inline auto FFramePacer::getThroughput() const noexcept -> uInt64
+{ return throughput; }
+
+//----------------------------------------------------------------------
+inline auto FFramePacer::getWriteLatency() const noexcept -> uInt64
+{ return write_latency; }
+
+//----------------------------------------------------------------------
+inline auto FFramePacer::getDroppedFrames() const noexcept -> uInt64
+{ return dropped_frames; }
+
+//----------------------------------------------------------------------
+inline void FFramePacer::setPacing (FramePacing mode) noexcept
+{ pacing = mode; }
+
+}  // namespace finalcut
+
+#endif  // FFRAMEPACER_H
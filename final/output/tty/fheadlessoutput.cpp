@@ -0,0 +1,357 @@
+/***********************************************************************
+* fheadlessoutput.cpp - Terminal output into an in-memory buffer       *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <sys/uio.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "final/fc.h"
+#include "final/output/tty/fheadlessoutput.h"
+#include "final/output/tty/foptimove.h"
+#include "final/output/tty/fterm.h"
+#include "final/output/tty/ftermcap.h"
+#include "final/output/tty/ftermdata.h"
+
+namespace finalcut
+{
+
+// static class attribute
+FHeadlessOutput* FHeadlessOutput::active_output{nullptr};
+
+//----------------------------------------------------------------------
+// class FHeadlessOutput
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FHeadlessOutput::FHeadlessOutput (const FVTerm& t)
+  : FTermOutput{t}
+{
+  active_output = this;
+  FTermcap::setPutCharFunction (&putChar);
+  FTermcap::setPutStringFunction (&putString);
+
+  // FVTerm queries the terminal size directly after construction
+  initTermData();
+}
+
+//----------------------------------------------------------------------
+FHeadlessOutput::~FHeadlessOutput() noexcept  // destructor
+{
+  if ( active_output != this )
+    return;
+
+  active_output = nullptr;
+  FTermcap::setDefaultPutCharFunction();
+  FTermcap::setDefaultPutStringFunction();
+}
+
+
+// public methods of FHeadlessOutput
+//----------------------------------------------------------------------
+auto FHeadlessOutput::getProfile() -> TermProfile&
+{
+  static TermProfile profile{getXTermProfile()};
+  return profile;
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::getXTermProfile() -> TermProfile
+{
+  // Capabilities of the terminfo entry xterm-256color
+
+  TermProfile profile{};
+  profile.name = "xterm-256color";
+  profile.type = FTermTypeT(FTermType::xterm);
+  profile.encoding = Encoding::UTF8;
+  profile.max_color = 256;
+  profile.background_color_erase = true;
+  profile.automatic_right_margin = true;
+  profile.eat_nl_glitch = true;
+  profile.capabilities =
+  {
+    { Termcap::t_bell, BEL },
+    { Termcap::t_erase_chars, CSI "%p1%dX" },
+    { Termcap::t_clear_screen, CSI "H" CSI "2J" },
+    { Termcap::t_clr_eos, CSI "J" },
+    { Termcap::t_clr_eol, CSI "K" },
+    { Termcap::t_clr_bol, CSI "1K" },
+    { Termcap::t_cursor_home, CSI "H" },
+    { Termcap::t_carriage_return, "\r" },
+    { Termcap::t_tab, "\t" },
+    { Termcap::t_back_tab, CSI "Z" },
+    { Termcap::t_parm_ich, CSI "%p1%d@" },
+    { Termcap::t_repeat_char, "%p1%c" CSI "%p2%{1}%-%db" },
+    { Termcap::t_set_a_foreground, CSI "%?%p1%{8}%<%t3%p1%d%e%p1%{16}%<"
+                                   "%t9%p1%{8}%-%d%e38;5;%p1%d%;m" },
+    { Termcap::t_set_a_background, CSI "%?%p1%{8}%<%t4%p1%d%e%p1%{16}%<"
+                                   "%t10%p1%{8}%-%d%e48;5;%p1%d%;m" },
+    { Termcap::t_orig_pair, CSI "39;49m" },
+    { Termcap::t_cursor_address, CSI "%i%p1%d;%p2%dH" },
+    { Termcap::t_column_address, CSI "%i%p1%dG" },
+    { Termcap::t_row_address, CSI "%i%p1%dd" },
+    { Termcap::t_cursor_visible, CSI "?12;25h" },
+    { Termcap::t_cursor_invisible, CSI "?25l" },
+    { Termcap::t_cursor_normal, CSI "?12l" CSI "?25h" },
+    { Termcap::t_cursor_up, CSI "A" },
+    { Termcap::t_cursor_down, "\n" },
+    { Termcap::t_cursor_left, "\b" },
+    { Termcap::t_cursor_right, CSI "C" },
+    { Termcap::t_parm_up_cursor, CSI "%p1%dA" },
+    { Termcap::t_parm_down_cursor, CSI "%p1%dB" },
+    { Termcap::t_parm_left_cursor, CSI "%p1%dD" },
+    { Termcap::t_parm_right_cursor, CSI "%p1%dC" },
+    { Termcap::t_save_cursor, ESC "7" },
+    { Termcap::t_restore_cursor, ESC "8" },
+    { Termcap::t_scroll_forward, "\n" },
+    { Termcap::t_scroll_reverse, ESC "M" },
+    { Termcap::t_parm_index, CSI "%p1%dS" },
+    { Termcap::t_parm_rindex, CSI "%p1%dT" },
+    { Termcap::t_change_scroll_region, CSI "%i%p1%d;%p2%dr" },
+    { Termcap::t_insert_line, CSI "L" },
+    { Termcap::t_parm_insert_line, CSI "%p1%dL" },
+    { Termcap::t_delete_line, CSI "M" },
+    { Termcap::t_parm_delete_line, CSI "%p1%dM" },
+    { Termcap::t_enter_ca_mode, CSI "?1049h" CSI "22;0;0t" },
+    { Termcap::t_exit_ca_mode, CSI "?1049l" CSI "23;0;0t" },
+    { Termcap::t_enter_bold_mode, CSI "1m" },
+    { Termcap::t_enter_dim_mode, CSI "2m" },
+    { Termcap::t_enter_italics_mode, CSI "3m" },
+    { Termcap::t_exit_italics_mode, CSI "23m" },
+    { Termcap::t_enter_underline_mode, CSI "4m" },
+    { Termcap::t_exit_underline_mode, CSI "24m" },
+    { Termcap::t_enter_blink_mode, CSI "5m" },
+    { Termcap::t_enter_reverse_mode, CSI "7m" },
+    { Termcap::t_enter_standout_mode, CSI "7m" },
+    { Termcap::t_exit_standout_mode, CSI "27m" },
+    { Termcap::t_enter_secure_mode, CSI "8m" },
+    { Termcap::t_set_attributes, "%?%p9%t" ESC "(0%e" ESC "(B%;" CSI "0"
+                                 "%?%p6%t;1%;%?%p5%t;2%;%?%p2%t;4%;"
+                                 "%?%p1%p3%|%t;7%;%?%p4%t;5%;%?%p7%t;8%;m" },
+    { Termcap::t_exit_attribute_mode, ESC "(B" CSI "m" },
+    { Termcap::t_enter_alt_charset_mode, ESC "(0" },
+    { Termcap::t_exit_alt_charset_mode, ESC "(B" },
+    { Termcap::t_enter_insert_mode, CSI "4h" },
+    { Termcap::t_exit_insert_mode, CSI "4l" },
+    { Termcap::t_enter_am_mode, CSI "?7h" },
+    { Termcap::t_exit_am_mode, CSI "?7l" },
+    { Termcap::t_acs_chars, "``aaffggiijjkkllmmnnooppqqrrssttuuvvwwxxyyzz{{||}}~~" },
+    { Termcap::t_keypad_xmit, CSI "?1h" ESC "=" },
+    { Termcap::t_keypad_local, CSI "?1l" ESC ">" }
+  };
+
+  return profile;
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::getVT100Profile() -> TermProfile
+{
+  // Capabilities of the terminfo entry vt100 (monochrome,
+  // DEC special graphics and delays in the control strings)
+
+  TermProfile profile{};
+  profile.name = "vt100";
+  profile.encoding = Encoding::VT100;
+  profile.max_color = 1;
+  profile.automatic_right_margin = true;
+  profile.eat_nl_glitch = true;
+  profile.capabilities =
+  {
+    { Termcap::t_bell, BEL },
+    { Termcap::t_clear_screen, CSI "H" CSI "J$<50>" },
+    { Termcap::t_clr_eos, CSI "J$<50>" },
+    { Termcap::t_clr_eol, CSI "K$<3>" },
+    { Termcap::t_clr_bol, CSI "1K$<3>" },
+    { Termcap::t_cursor_home, CSI "H" },
+    { Termcap::t_carriage_return, "\r" },
+    { Termcap::t_tab, "\t" },
+    { Termcap::t_cursor_address, CSI "%i%p1%d;%p2%dH$<5>" },
+    { Termcap::t_cursor_up, CSI "A$<2>" },
+    { Termcap::t_cursor_down, "\n" },
+    { Termcap::t_cursor_left, "\b" },
+    { Termcap::t_cursor_right, CSI "C$<2>" },
+    { Termcap::t_parm_up_cursor, CSI "%p1%dA" },
+    { Termcap::t_parm_down_cursor, CSI "%p1%dB" },
+    { Termcap::t_parm_left_cursor, CSI "%p1%dD" },
+    { Termcap::t_parm_right_cursor, CSI "%p1%dC" },
+    { Termcap::t_save_cursor, ESC "7" },
+    { Termcap::t_restore_cursor, ESC "8" },
+    { Termcap::t_scroll_forward, "\n" },
+    { Termcap::t_scroll_reverse, ESC "M$<5>" },
+    { Termcap::t_change_scroll_region, CSI "%i%p1%d;%p2%dr" },
+    { Termcap::t_enable_acs, ESC "(B" ESC ")0" },
+    { Termcap::t_enter_bold_mode, CSI "1m$<2>" },
+    { Termcap::t_enter_underline_mode, CSI "4m$<2>" },
+    { Termcap::t_exit_underline_mode, CSI "m$<2>" },
+    { Termcap::t_enter_blink_mode, CSI "5m$<2>" },
+    { Termcap::t_enter_reverse_mode, CSI "7m$<2>" },
+    { Termcap::t_enter_standout_mode, CSI "7m$<2>" },
+    { Termcap::t_exit_standout_mode, CSI "m$<2>" },
+    { Termcap::t_set_attributes, CSI "0%?%p1%p6%|%t;1%;%?%p2%t;4%;"
+                                 "%?%p1%p3%|%t;7%;%?%p4%t;5%;m"
+                                 "%?%p9%t\016%e\017%;$<2>" },
+    { Termcap::t_exit_attribute_mode, CSI "m\017$<2>" },
+    { Termcap::t_enter_alt_charset_mode, "\016" },
+    { Termcap::t_exit_alt_charset_mode, "\017" },
+    { Termcap::t_enter_am_mode, CSI "?7h" },
+    { Termcap::t_exit_am_mode, CSI "?7l" },
+    { Termcap::t_acs_chars, "``aaffggjjkkllmmnnooppqqrrssttuuvvwwxxyyzz{{||}}~~" },
+    { Termcap::t_keypad_xmit, CSI "?1h" ESC "=" },
+    { Termcap::t_keypad_local, CSI "?1l" ESC ">" }
+  };
+
+  return profile;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::setTerminalSize (FSize size)
+{
+  static auto& fterm_data = FTermData::getInstance();
+  fterm_data.getTerminalGeometry().setSize(size);
+  fterm_data.setTermResized(true);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::finishTerminal()
+{
+  // Writes the closing output to the memory buffer
+  // without waiting for a terminal device
+
+  showCursor();
+  flush();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::detectTerminalSize()
+{
+  static const auto& fterm_data = FTermData::getInstance();
+  static auto& opti_move = FOptiMove::getInstance();
+  const auto& term_geometry = fterm_data.getTerminalGeometry();
+  opti_move.setTermSize (term_geometry.getWidth(), term_geometry.getHeight());
+}
+
+
+// private methods of FHeadlessOutput
+//----------------------------------------------------------------------
+void FHeadlessOutput::initTerminalDevice()
+{
+  // Uses the profile instead of the terminal device
+  // and the termcap database
+
+  initTermData();
+  initTermcap();
+  FTerm::initCapabilities();
+  detectTerminalSize();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::initTermcap() const
+{
+  const auto& profile = getProfile();
+
+  for (auto&& cap : FTermcap::strings)
+    cap.string = nullptr;
+
+  for (const auto& cap : profile.capabilities)
+    FTermcap::strings[std::size_t(cap.first)].string = cap.second;
+
+  FTermcap::background_color_erase = profile.background_color_erase;
+  FTermcap::can_change_color_palette = false;
+  FTermcap::automatic_left_margin = profile.automatic_left_margin;
+  FTermcap::automatic_right_margin = profile.automatic_right_margin;
+  FTermcap::eat_nl_glitch = profile.eat_nl_glitch;
+  FTermcap::ansi_default_color = profile.ansi_default_color;
+  FTermcap::osc_support = false;
+  FTermcap::no_utf8_acs_chars = false;
+  FTermcap::no_padding_char = false;
+  FTermcap::xon_xoff_flow_control = false;
+  FTermcap::max_color = profile.max_color;
+  FTermcap::tabstop = profile.tabstop;
+  FTermcap::padding_baudrate = 0;  // Padding without delay
+  FTermcap::attr_without_color = profile.attr_without_color;
+  const auto& home = TCAP(t_cursor_home);
+  FTermcap::has_ansi_escape_sequences = home
+                                     && std::strncmp(home, CSI "H", 3) == 0;
+  FTermcap::setInitialized();
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutput::initTermData() const
+{
+  static auto& fterm_data = FTermData::getInstance();
+  const auto& profile = getProfile();
+  fterm_data.setTermType (profile.name);
+  // Replaces all terminal type flags with the profile type
+  fterm_data.unsetTermType (static_cast<FTermType>(~FTermTypeT(0)));
+  fterm_data.setTermType (static_cast<FTermType>(profile.type));
+
+  fterm_data.setMonochron (profile.max_color < 8);
+  fterm_data.setNewFont (false);
+  fterm_data.setVGAFont (false);
+  fterm_data.setTermEncoding (profile.encoding);
+  fterm_data.setUTF8Console (profile.encoding == Encoding::UTF8);
+  fterm_data.setUTF8 (profile.encoding == Encoding::UTF8);
+  fterm_data.setVT100Console (profile.encoding == Encoding::VT100);
+  fterm_data.setASCIIConsole (profile.encoding == Encoding::ASCII);
+  fterm_data.getTerminalGeometry().setRect ( 1, 1
+                                           , profile.size.getWidth()
+                                           , profile.size.getHeight() );
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::writeNonBlocking (struct iovec* iov, int iovcnt) -> std::size_t
+{
+  // Collects the output instead of writing it to stdout
+
+  std::size_t written{0};
+
+  for (int i{0}; i < iovcnt; i++)
+  {
+    output.append (static_cast<const char*>(iov[i].iov_base), iov[i].iov_len);
+    written += iov[i].iov_len;
+  }
+
+  return written;
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::putChar (int ch) -> int
+{
+  if ( ! active_output )
+    return EOF;
+
+  active_output->output.push_back(char(ch));
+  return ch;
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutput::putString (const std::string& string) -> int
+{
+  if ( ! active_output )
+    return EOF;
+
+  active_output->output.append(string);
+  return 1;
+}
+
+}  // namespace finalcut
@@ -0,0 +1,204 @@
+/***********************************************************************
+* fheadlessoutput.h - Terminal output into an in-memory buffer         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Inheritance diagram
+ *  ═══════════════════
+ *
+ *     ▕▔▔▔▔▔▔▔▔▔▏
+ *     ▕ FOutput ▏
+ *     ▕▁▁▁▁▁▁▁▁▁▏
+ *          ▲
+ *          │
+ *   ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ *   ▕ FTermOutput ▏
+ *   ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ *          ▲
+ *          │
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FHeadlessOutput ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  FHeadlessOutput runs the complete terminal output of FTermOutput
+ *  (line comparison, attribute and cursor motion optimization) without
+ *  a terminal device. The terminal capabilities come from a profile,
+ *  and all bytes are collected in a memory buffer. This is useful
+ *  for tests and benchmarks without a tty.
+ *
+ *  The profile must be set before the first FVTerm object is created:
+ *
+ *    finalcut::FHeadlessOutput::setProfile
+ *    (
+ *      finalcut::FHeadlessOutput::getXTermProfile()
+ *    );
+ *    finalcut::FVTerm vterm{finalcut::outputClass<FHeadlessOutput>{}};
+ *
+ *  All FVTerm objects created afterward use the same output.
+ */
+
+#ifndef FHEADLESSOUTPUT_H
+#define FHEADLESSOUTPUT_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "final/output/tty/ftermoutput.h"
+#include "final/util/fsize.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FHeadlessOutput
+//----------------------------------------------------------------------
+
+class FHeadlessOutput final : public FTermOutput
+{
+  public:
+    struct TermProfile
+    {
+      // Using-declaration
+      using Capability = std::pair<Termcap, const char*>;
+
+      // Data members
+      std::string name{};                 // Terminal name (TERM)
+      FTermTypeT  type{0};                // FTermType flags
+      FSize       size{80, 24};           // Terminal size
+      Encoding    encoding{Encoding::UTF8};
+      int         max_color{1};           // Co
+      int         tabstop{8};             // it
+      int         attr_without_color{0};  // NC
+      bool        background_color_erase{false};  // ut
+      bool        automatic_left_margin{false};   // bw
+      bool        automatic_right_margin{false};  // am
+      bool        eat_nl_glitch{false};           // xn
+      bool        ansi_default_color{false};      // AX
+      std::vector<Capability> capabilities{};     // Strings with static
+                                                  // storage duration
+    };
+
+    // Using-declaration
+    using FTermOutput::setCursor;
+
+    // Constructor
+    explicit FHeadlessOutput (const FVTerm&);
+
+    // Destructor
+    ~FHeadlessOutput() noexcept override;
+
+    // Accessors
+    auto getClassName() const -> FString override;
+    static auto getProfile() -> TermProfile&;
+    static auto getXTermProfile() -> TermProfile;
+    static auto getVT100Profile() -> TermProfile;
+    auto getOutput() const & -> const std::string&;
+
+    // Mutators
+    static void setProfile (const TermProfile&);
+    void setCursor (CursorMode) override;
+    void setTerminalSize (FSize) override;
+    auto setVGAFont() -> bool override;
+    auto setNewFont() -> bool override;
+
+    // Inquiries
+    auto isFlushTimeout() const -> bool override;
+    auto allowsTerminalSizeManipulation() const -> bool override;
+    auto canChangeColorPalette() const -> bool override;
+
+    // Methods
+    void finishTerminal() override;
+    void detectTerminalSize() override;
+    void initScreenSettings() override;
+    void clearOutput();
+
+  private:
+    // Methods
+    auto getOutputBacklog() const -> std::size_t override;
+    void initTerminalDevice() override;
+    void initTermcap() const;
+    void initTermData() const;
+    auto writeNonBlocking (struct iovec*, int) -> std::size_t override;
+    static auto putChar (int) -> int;
+    static auto putString (const std::string&) -> int;
+
+    // Data members
+    std::string             output{};
+    static FHeadlessOutput* active_output;
+};
+
+// FHeadlessOutput inline functions
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getClassName() const -> FString
+{ return "FHeadlessOutput"; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getOutput() const & -> const std::string&
+{ return output; }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::setProfile (const TermProfile& profile)
+{ getProfile() = profile; }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::setCursor (CursorMode)
+{ }  // There is no cursor shape in the memory buffer
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::setVGAFont() -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::setNewFont() -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::isFlushTimeout() const -> bool
+{ return true; }  // Every flush reaches the buffer
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::allowsTerminalSizeManipulation() const -> bool
+{ return true; }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::canChangeColorPalette() const -> bool
+{ return false; }
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::initScreenSettings()
+{ }  // No console character mapping
+
+//----------------------------------------------------------------------
+inline void FHeadlessOutput::clearOutput()
+{ output.clear(); }
+
+//----------------------------------------------------------------------
+inline auto FHeadlessOutput::getOutputBacklog() const -> std::size_t
+{ return 0; }  // The memory buffer takes all output at once
+
+}  // namespace finalcut
+
+#endif  // FHEADLESSOUTPUT_H
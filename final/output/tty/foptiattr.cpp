@@ -398,6 +398,7 @@ void FOptiAttr::initialize()
   init_reset_attribute (F_dbl_underline.off);
   init_reset_attribute (F_standout.off, all_tests & ~same_like_se);
   alt_equal_pc_charset = hasCharsetEquivalence();
+  clearTransitionCache();
 }
 
 //----------------------------------------------------------------------
@@ -442,8 +443,71 @@ auto FOptiAttr::vga2ansi (FColor color) -> FColor
 }
 
 //----------------------------------------------------------------------
-auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> std::string
+auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> const std::string&
 {
+  // Returns the escape sequence for the change from the current
+  // terminal attributes (term) to the attributes of the next character.
+  // The result is cached by the color and attribute words of both
+  // characters and remains valid until the next call.
+
+  static const auto& start_options = FStartOptions::getInstance();
+
+  if ( cache_sgr_optimizer != start_options.sgr_optimizer )
+  {
+    cache_sgr_optimizer = start_options.sgr_optimizer;
+    clearTransitionCache();
+  }
+
+  const TransitionWords from_words
+  {{ term.color.data, term.attr.data, next.color.data, next.attr.data }};
+  auto& transition = transition_cache[getTransitionIndex(from_words)];
+
+  if ( transition.generation != cache_generation
+    || transition.from != from_words )
+  {
+    // Cache miss
+    transition.hide_char = buildAttributeChange (term, next);
+    transition.from = from_words;
+    transition.to = {{ term.color.data, term.attr.data
+                     , next.color.data, next.attr.data }};
+    transition.sequence.assign(attr_buf);
+    transition.generation = cache_generation;
+    return transition.sequence;
+  }
+
+  term.color.data = transition.to[0];
+  term.attr.data  = transition.to[1];
+  next.color.data = transition.to[2];
+  next.attr.data  = transition.to[3];
+
+  if ( transition.hide_char )
+    next.encoded_char[0] = ' ';
+
+  return transition.sequence;
+}
+
+
+// private methods of FOptiAttr
+//----------------------------------------------------------------------
+inline auto FOptiAttr::getTransitionIndex (const TransitionWords& words) -> std::size_t
+{
+  uInt32 hash{2166136261u};  // FNV-1a
+
+  for (const auto& word : words)
+  {
+    hash ^= word;
+    hash *= 16777619u;
+  }
+
+  return ( hash ^ (hash >> 16) ) & (TRANSITION_CACHE_SIZE - 1);
+}
+
+//----------------------------------------------------------------------
+auto FOptiAttr::buildAttributeChange (FChar& term, FChar& next) -> bool
+{
+  // Generates the escape sequence for the attribute change in attr_buf
+  // and returns true if the next character has to be hidden
+
   const bool next_has_color = hasColor(next);
   fake_reverse = false;
   attr_buf.clear();
@@ -453,12 +517,14 @@ auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> std::string
   detectSwitchOff (term, next);
 
   // Simulate invisible characters
-  if ( ! F_secure.on.cap && next.attr.bit.invisible )
+  const bool hide_char = ! F_secure.on.cap && next.attr.bit.invisible;
+
+  if ( hide_char )
     next.encoded_char[0] = ' ';
 
   // Look for no changes
   if ( ! (switchOn() || switchOff() || hasColorChanged(term, next)) )
-    return {};
+    return hide_char;
 
   if ( hasNoAttribute(next) )
   {
@@ -474,32 +540,29 @@ auto FOptiAttr::changeAttribute (FChar& term, FChar& next) -> std::string
     changeAttributeSeparately (term, next);
   }
 
-  static const auto& start_options = FStartOptions::getInstance();
-
-  if ( start_options.sgr_optimizer )
+  if ( cache_sgr_optimizer )
     sgr_optimizer.optimize();
 
-  return attr_buf;
+  return hide_char;
 }
 
-
-// private methods of FOptiAttr
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode ( Capability& capability
                                 , const char cap[]
-                                , bool caused_reset ) const
+                                , bool caused_reset )
 {
   if ( cap )
   {
     capability.cap = cap;
     capability.caused_reset = caused_reset;
+    clearTransitionCache();
   }
 }
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode_on ( TextStyle& style
                                    , const char cap[]
-                                   , bool caused_reset ) const
+                                   , bool caused_reset )
 {
   set_mode (style.on, cap, caused_reset);
 }
@@ -507,7 +570,7 @@ inline void FOptiAttr::set_mode_on ( TextStyle& style
 //----------------------------------------------------------------------
 inline void FOptiAttr::set_mode_off ( TextStyle& style
                                     , const char cap[]
-                                    , bool caused_reset ) const
+                                    , bool caused_reset )
 {
   set_mode (style.off, cap, caused_reset);
 }
@@ -148,7 +148,7 @@ class FOptiAttr final
     // Methods
     void        initialize();
     static auto vga2ansi (FColor) -> FColor;
-    auto        changeAttribute (FChar&, FChar&) -> std::string;
+    auto        changeAttribute (FChar&, FChar&) -> const std::string&;
 
   private:
     struct Capability
@@ -184,6 +184,23 @@ class FOptiAttr final
       FChar off{};
     };
 
+    // Color and attribute words of the terminal and the next character
+    using TransitionWords = std::array<uInt32, 4>;
+
+    struct AttributeTransition
+    {
+      TransitionWords from{};        // Words before the change
+      TransitionWords to{};          // Words after the change
+      std::string     sequence{};    // Escape sequence for the change
+      uInt            generation{0}; // Valid if equal to cache_generation
+      bool            hide_char{false};  // Simulated invisible character
+    };
+
+    // Constants
+    static constexpr std::size_t TRANSITION_CACHE_SIZE{256};  // Power of 2
+
+    using TransitionCache = std::array<AttributeTransition, TRANSITION_CACHE_SIZE>;
+
     // Using-declarations
     using SetFunctionCall = std::function<bool(FOptiAttr*, FChar&)>;
 
@@ -210,9 +227,9 @@ class FOptiAttr final
     };
 
     // Mutators
-    void        set_mode (Capability&, const char[], bool) const;
-    void        set_mode_on (TextStyle&, const char[], bool) const;
-    void        set_mode_off (TextStyle&, const char[], bool) const;
+    void        set_mode (Capability&, const char[], bool);
+    void        set_mode_on (TextStyle&, const char[], bool);
+    void        set_mode_off (TextStyle&, const char[], bool);
     auto        setTermBold (FChar&) -> bool;
     auto        unsetTermBold (FChar&) -> bool;
     auto        setTermDim (FChar&) -> bool;
@@ -259,6 +276,9 @@ class FOptiAttr final
     auto        hasColorChanged (const FChar&, const FChar&) const -> bool;
 
     // Methods
+    static auto getTransitionIndex (const TransitionWords&) -> std::size_t;
+    void        clearTransitionCache() noexcept;
+    auto        buildAttributeChange (FChar&, FChar&) -> bool;
     void        resetColor (FChar&) const;
     void        prevent_no_color_video_attributes (FChar&, bool = false);
     void        deactivateAttributes (FChar&, FChar&);
@@ -312,6 +332,9 @@ class FOptiAttr final
     AttributeChanges changes{};
     std::string      attr_buf{};
     SGRoptimizer     sgr_optimizer{attr_buf};
+    TransitionCache  transition_cache{};
+    uInt             cache_generation{1};
+    bool             cache_sgr_optimizer{false};
     bool             alt_equal_pc_charset{false};
     bool             fake_reverse{false};
 };
@@ -324,19 +347,47 @@ inline auto FOptiAttr::getClassName() const -> FString
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setMaxColor (const int& c) noexcept
-{ F_color.max_color = c; }
+{
+  F_color.max_color = c;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setNoColorVideo (int attr) noexcept
-{ F_color.attr_without_color = attr; }
+{
+  F_color.attr_without_color = attr;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::setDefaultColorSupport() noexcept
-{ F_color.ansi_default_color = true; }
+{
+  F_color.ansi_default_color = true;
+  clearTransitionCache();
+}
 
 //----------------------------------------------------------------------
 inline void FOptiAttr::unsetDefaultColorSupport() noexcept
-{ F_color.ansi_default_color = false; }
+{
+  F_color.ansi_default_color = false;
+  clearTransitionCache();
+}
+
+//----------------------------------------------------------------------
+inline void FOptiAttr::clearTransitionCache() noexcept
+{
+  // Invalidates all cached attribute transitions
+
+  cache_generation++;
+
+  if ( cache_generation != 0 )
+    return;
+
+  for (auto& transition : transition_cache)  // Generation overflow
+    transition.generation = 0;
+
+  cache_generation = 1;
+}
 
 //----------------------------------------------------------------------
 template <typename CharT
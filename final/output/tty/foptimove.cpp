@@ -280,12 +280,14 @@ void FOptiMove::set_cursor_address (const char cap[])
     parm_cursor.address.cap = cap;
     parm_cursor.address.duration = capDuration (temp.data(), 1);
     parm_cursor.address.length = capDurationToLength (parm_cursor.address.duration);
+    parm_cursor.address.param_template = compileParamTemplate(cap);
   }
   else
   {
     parm_cursor.address.cap = nullptr;
     parm_cursor.address.duration = \
     parm_cursor.address.length   = LONG_DURATION;
+    parm_cursor.address.param_template.clear();
   }
 }
 
@@ -298,12 +300,14 @@ void FOptiMove::set_column_address (const char cap[])
     parm_cursor.column_address.cap = cap;
     parm_cursor.column_address.duration = capDuration (temp.data(), 1);
     parm_cursor.column_address.length = capDurationToLength (parm_cursor.column_address.duration);
+    parm_cursor.column_address.param_template = compileParamTemplate(cap);
   }
   else
   {
     parm_cursor.column_address.cap = nullptr;
     parm_cursor.column_address.duration = \
     parm_cursor.column_address.length   = LONG_DURATION;
+    parm_cursor.column_address.param_template.clear();
   }
 }
 
@@ -316,12 +320,14 @@ void FOptiMove::set_row_address (const char cap[])
     parm_cursor.row_address.cap = cap;
     parm_cursor.row_address.duration = capDuration (temp.data(), 1);
     parm_cursor.row_address.length = capDurationToLength (parm_cursor.row_address.duration);
+    parm_cursor.row_address.param_template = compileParamTemplate(cap);
   }
   else
   {
     parm_cursor.row_address.cap = nullptr;
     parm_cursor.row_address.duration = \
     parm_cursor.row_address.length   = LONG_DURATION;
+    parm_cursor.row_address.param_template.clear();
   }
 }
 
@@ -334,12 +340,14 @@ void FOptiMove::set_parm_up_cursor (const char cap[])
     parm_cursor.up.cap = cap;
     parm_cursor.up.duration = capDuration (temp.data(), 1);
     parm_cursor.up.length = capDurationToLength (parm_cursor.up.duration);
+    parm_cursor.up.param_template = compileParamTemplate(cap);
   }
   else
   {
     parm_cursor.up.cap = nullptr;
     parm_cursor.up.duration = \
     parm_cursor.up.length   = LONG_DURATION;
+    parm_cursor.up.param_template.clear();
   }
 }
 
@@ -352,12 +360,14 @@ void FOptiMove::set_parm_down_cursor (const char cap[])
     parm_cursor.down.cap = cap;
     parm_cursor.down.duration = capDuration (temp.data(), 1);
     parm_cursor.down.length = capDurationToLength (parm_cursor.down.duration);
+    parm_cursor.down.param_template = compileParamTemplate(cap);
   }
   else
   {
     parm_cursor.down.cap = nullptr;
     parm_cursor.down.duration = \
     parm_cursor.down.length   = LONG_DURATION;
+    parm_cursor.down.param_template.clear();
   }
 }
 
@@ -370,12 +380,14 @@ void FOptiMove::set_parm_left_cursor (const char cap[])
     parm_cursor.left.cap = cap;
     parm_cursor.left.duration = capDuration (temp.data(), 1);
     parm_cursor.left.length = capDurationToLength (parm_cursor.left.duration);
+    parm_cursor.left.param_template = compileParamTemplate(cap);
   }
   else
   {
     parm_cursor.left.cap = nullptr;
     parm_cursor.left.duration = \
     parm_cursor.left.length   = LONG_DURATION;
+    parm_cursor.left.param_template.clear();
   }
 }
 
@@ -388,12 +400,14 @@ void FOptiMove::set_parm_right_cursor (const char cap[])
     parm_cursor.right.cap = cap;
     parm_cursor.right.duration = capDuration (temp.data(), 1);
     parm_cursor.right.length = capDurationToLength (parm_cursor.right.duration);
+    parm_cursor.right.param_template = compileParamTemplate(cap);
   }
   else
   {
     parm_cursor.right.cap = nullptr;
     parm_cursor.right.duration = \
     parm_cursor.right.length   = LONG_DURATION;
+    parm_cursor.right.param_template.clear();
   }
 }
 
@@ -502,8 +516,11 @@ void FOptiMove::check_boundaries ( int& xold, int& yold
 }
 
 //----------------------------------------------------------------------
-auto FOptiMove::moveCursor (int xold, int yold, int xnew, int ynew) -> std::string
+auto FOptiMove::moveCursor (int xold, int yold, int xnew, int ynew) -> const std::string&
 {
+  // The costs of all methods are compared first. Only the escape
+  // sequence of the fastest method is then written into move_buf.
+
   int method{0};
   int move_time{LONG_DURATION};
 
@@ -515,7 +532,10 @@ auto FOptiMove::moveCursor (int xold, int yold, int xnew, int ynew) -> std::stri
       || yold < 0
       || isWideMove (xold, yold, xnew, ynew) ) )
   {
-    return ( move_time < LONG_DURATION ) ? move_buf : std::string{};
+    if ( move_time >= LONG_DURATION )
+      move_buf.clear();
+
+    return move_buf;
   }
 
   // Method 1: local movement
@@ -541,10 +561,10 @@ auto FOptiMove::moveCursor (int xold, int yold, int xnew, int ynew) -> std::stri
   // Copy the escape sequence for the chosen method in move_buf
   moveByMethod (method, xold, yold, xnew, ynew);
 
-  if ( move_time < LONG_DURATION )
-    return move_buf;
+  if ( move_time >= LONG_DURATION )
+    move_buf.clear();
 
-  return {};
+  return move_buf;
 }
 
 
@@ -629,76 +649,259 @@ auto FOptiMove::capDurationToLength (int duration) const -> int
 }
 
 //----------------------------------------------------------------------
-auto FOptiMove::repeatedAppend ( std::string& dst
-                               , const Capability& o
-                               , int count ) const -> int
+auto FOptiMove::compileParamTemplate (const char cap[]) -> std::string
 {
-  const auto& src_len = stringLength(o.cap);
-  const auto& dst_len = dst.length();
-  int total{0};
+  // Precompiles a parameterized capability that consists only of
+  // literal characters, "%%", "%i" and "%p1%d" or "%p2%d" sequences.
+  // A parameter is stored as '\0' followed by 'a' (p1) or 'b' (p2),
+  // or 'A' and 'B' for parameters incremented by "%i".
+  // All other capabilities return an empty string and are encoded
+  // with FTermcap.
+
+  if ( ! cap )
+    return {};
 
-  if ( (dst_len + uInt(count) * src_len) < BUF_SIZE - 1 )
+  std::string param_template{};
+  bool increment{false};
+  bool has_param{false};
+  int param{-1};
+  const char* p = cap;
+
+  while ( *p )
   {
-    total += count * o.duration;
-    int cnt = count;
+    if ( *p != '%' )
+    {
+      if ( param >= 0 )
+        return {};
+
+      param_template.push_back(*p);
+      p++;
+      continue;
+    }
+
+    p++;
 
-    while ( cnt > 0 )
+    if ( *p == '%' && param < 0 )
+      param_template.push_back('%');
+    else if ( *p == 'i' && ! has_param )
+      increment = true;
+    else if ( *p == 'p' && param < 0 && (p[1] == '1' || p[1] == '2') )
     {
-      cnt--;
-      dst.append(o.cap);
+      p++;
+      param = *p - '1';
+      has_param = true;
     }
+    else if ( *p == 'd' && param >= 0 )
+    {
+      param_template.push_back('\0');
+      param_template.push_back(char((increment ? 'A' : 'a') + param));
+      param = -1;
+    }
+    else
+      return {};  // Unsupported format
+
+    p++;
+  }
+
+  if ( ! has_param || param >= 0 )
+    return {};
+
+  return param_template;
+}
+
+//----------------------------------------------------------------------
+inline void FOptiMove::appendNumber (std::string& dst, int number)
+{
+  // Writes a decimal number without a temporary string
+
+  std::array<char, 12> digits{};
+  auto pos = digits.size();
+  auto value = uInt(number);
+
+  if ( number < 0 )
+  {
+    dst.push_back('-');
+    value = 0u - value;
   }
+
+  do
+  {
+    pos--;
+    digits[pos] = char('0' + value % 10);
+    value /= 10;
+  }
+  while ( value > 0 );
+
+  dst.append(&digits[pos], digits.size() - pos);
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::appendTemplate ( std::string& dst
+                               , const std::string& param_template
+                               , int p1, int p2 )
+{
+  auto iter = param_template.cbegin();
+  const auto last = param_template.cend();
+
+  while ( iter != last )
+  {
+    if ( *iter != '\0' )
+    {
+      dst.push_back(*iter);
+      ++iter;
+      continue;
+    }
+
+    ++iter;
+    const bool increment = *iter < 'a';
+    const int param = *iter - (increment ? 'A' : 'a');
+    appendNumber (dst, (param == 0 ? p1 : p2) + (increment ? 1 : 0));
+    ++iter;
+  }
+}
+
+//----------------------------------------------------------------------
+inline void FOptiMove::appendParameter ( std::string& dst
+                                       , const Capability& o
+                                       , int num )
+{
+  if ( o.param_template.empty() )
+    dst.append(FTermcap::encodeParameter(o.cap, num));
   else
-    total = LONG_DURATION;
+    appendTemplate (dst, o.param_template, num, 0);
+}
 
-  return total;
+//----------------------------------------------------------------------
+inline void FOptiMove::appendMotionParameter ( std::string& dst
+                                             , const Capability& o
+                                             , int x, int y )
+{
+  if ( o.param_template.empty() )
+    dst.append(FTermcap::encodeMotionParameter(o.cap, x, y));
+  else
+    appendTemplate (dst, o.param_template, y, x);
 }
 
 //----------------------------------------------------------------------
-auto FOptiMove::relativeMove ( std::string& move
-                             , int from_x, int from_y
-                             , int to_x, int to_y ) const -> int
+inline void FOptiMove::repeatedAppend ( std::string& dst
+                                      , const Capability& o
+                                      , int count )
 {
+  while ( count > 0 )
+  {
+    count--;
+    dst.append(o.cap);
+  }
+}
+
+//----------------------------------------------------------------------
+inline auto FOptiMove::repeatedDuration ( const Capability& o
+                                        , int count
+                                        , std::size_t used ) const -> int
+{
+  // Duration of count repetitions after used bytes of the same move
+
+  const auto& src_len = stringLength(o.cap);
+
+  if ( (used + uInt(count) * src_len) < BUF_SIZE - 1 )
+    return count * o.duration;
+
+  return LONG_DURATION;
+}
+
+//----------------------------------------------------------------------
+auto FOptiMove::relativeMove ( int from_x, int from_y
+                             , int to_x, int to_y ) const -> RelativeMove
+{
+  // Selects the fastest relative move without building the sequence
+
+  RelativeMove move{};
   int vtime{0};
   int htime{0};
 
-  if ( ! move.empty() )
-    move.clear();
-
   if ( to_y != from_y )  // vertical move
   {
     vtime = verticalMove (move, from_y, to_y);
 
     if ( vtime >= LONG_DURATION )
-      return LONG_DURATION;
+    {
+      move.time = LONG_DURATION;
+      return move;
+    }
   }
 
   if ( to_x != from_x )  // horizontal move
   {
-    std::string hmove{};
-    htime = horizontalMove (hmove, from_x, to_x);
+    htime = horizontalMove (move, from_x, to_x);
 
     if ( htime >= LONG_DURATION )
-      return LONG_DURATION;
+    {
+      move.time = LONG_DURATION;
+      return move;
+    }
+  }
 
-    if ( ! move.empty() )
-      move.append(hmove);
+  move.time = vtime + htime;
+  return move;
+}
+
+//----------------------------------------------------------------------
+void FOptiMove::appendRelativeMove ( std::string& dst
+                                   , const RelativeMove& move
+                                   , int from_x, int from_y
+                                   , int to_x, int to_y ) const
+{
+  if ( move.vertical == MoveType::Address )
+    appendParameter (dst, parm_cursor.row_address, to_y);
+  else if ( move.vertical == MoveType::Parameter )
+  {
+    if ( to_y > from_y )
+      appendParameter (dst, parm_cursor.down, to_y - from_y);
+    else
+      appendParameter (dst, parm_cursor.up, from_y - to_y);
+  }
+  else if ( move.vertical == MoveType::Repeat )
+  {
+    if ( to_y > from_y )
+      repeatedAppend (dst, cursor.down, to_y - from_y);
     else
-      move = std::move(hmove);
+      repeatedAppend (dst, cursor.up, from_y - to_y);
   }
 
-  return vtime + htime;
+  if ( move.horizontal == MoveType::Address )
+    appendParameter (dst, parm_cursor.column_address, to_x);
+  else if ( move.horizontal == MoveType::Parameter )
+  {
+    if ( to_x > from_x )
+      appendParameter (dst, parm_cursor.right, to_x - from_x);
+    else
+      appendParameter (dst, parm_cursor.left, from_x - to_x);
+  }
+  else if ( move.horizontal == MoveType::Repeat )
+  {
+    if ( to_x > from_x )
+    {
+      repeatedAppend (dst, cursor.tab, move.tabs);
+      repeatedAppend (dst, cursor.right, move.steps);
+    }
+    else
+    {
+      repeatedAppend (dst, cursor.back_tab, move.tabs);
+      repeatedAppend (dst, cursor.left, move.steps);
+    }
+  }
 }
 
 //----------------------------------------------------------------------
-inline auto FOptiMove::verticalMove (std::string& move, int from_y, int to_y) const -> int
+inline auto FOptiMove::verticalMove ( RelativeMove& move
+                                    , int from_y, int to_y ) const -> int
 {
   int vtime{LONG_DURATION};
 
   if ( parm_cursor.row_address.cap )
   {
     // Move to fixed row position
-    move = FTermcap::encodeParameter(parm_cursor.row_address.cap, to_y);
+    move.vertical = MoveType::Address;
     vtime = parm_cursor.row_address.duration;
   }
 
@@ -711,189 +914,184 @@ inline auto FOptiMove::verticalMove (std::string& move, int from_y, int to_y) co
 }
 
 //----------------------------------------------------------------------
-inline void FOptiMove::downMove ( std::string& move, int& vtime
+inline void FOptiMove::downMove ( RelativeMove& move, int& vtime
                                 , int from_y, int to_y ) const
 {
   const int num = to_y - from_y;
 
   if ( parm_cursor.down.cap && parm_cursor.down.duration < vtime )
   {
-    move = FTermcap::encodeParameter(parm_cursor.down.cap, num);
+    move.vertical = MoveType::Parameter;
     vtime = parm_cursor.down.duration;
   }
 
   if ( cursor.down.cap && (num * cursor.down.duration < vtime) )
   {
-    if ( ! move.empty() )
-      move.clear();
-
-    vtime = repeatedAppend (move, cursor.down, num);
+    move.vertical = MoveType::Repeat;
+    vtime = repeatedDuration (cursor.down, num, 0);
   }
 }
 
 //----------------------------------------------------------------------
-inline void FOptiMove::upMove ( std::string& move, int& vtime
+inline void FOptiMove::upMove ( RelativeMove& move, int& vtime
                               , int from_y, int to_y ) const
 {
   const int num = from_y - to_y;
 
   if ( parm_cursor.up.cap && parm_cursor.up.duration < vtime )
   {
-    move = FTermcap::encodeParameter(parm_cursor.up.cap, num);
+    move.vertical = MoveType::Parameter;
     vtime = parm_cursor.up.duration;
   }
 
   if ( cursor.up.cap && (num * cursor.up.duration < vtime) )
   {
-    if ( ! move.empty() )
-      move.clear();
-
-    vtime = repeatedAppend (move, cursor.up, num);
+    move.vertical = MoveType::Repeat;
+    vtime = repeatedDuration (cursor.up, num, 0);
   }
 }
 
 //----------------------------------------------------------------------
-inline auto FOptiMove::horizontalMove (std::string& hmove, int from_x, int to_x) const -> int
+inline auto FOptiMove::horizontalMove ( RelativeMove& move
+                                      , int from_x, int to_x ) const -> int
 {
   int htime{LONG_DURATION};
 
   if ( parm_cursor.column_address.cap )
   {
     // Move to fixed column position
-    hmove = FTermcap::encodeParameter(parm_cursor.column_address.cap, to_x);
+    move.horizontal = MoveType::Address;
     htime = parm_cursor.column_address.duration;
   }
 
   if ( to_x > from_x )
-    rightMove (hmove, htime, from_x, to_x);
+    rightMove (move, htime, from_x, to_x);
   else  // to_x < from_x
-    leftMove (hmove, htime, from_x, to_x);
+    leftMove (move, htime, from_x, to_x);
 
   return htime;
 }
 
 //----------------------------------------------------------------------
-inline void FOptiMove::moveWithParmRightCursor ( std::string& hmove
-                                               , int& htime, int num ) const
-{
-  // Use parameterized cursor right capability
-  hmove = FTermcap::encodeParameter(parm_cursor.right.cap, num);
-  htime = parm_cursor.right.duration;
-}
-
-//----------------------------------------------------------------------
-inline void FOptiMove::moveWithRightCursor ( std::string& hmove, int& htime
-                                           , int num, int from_x, int to_x ) const
+inline void FOptiMove::moveWithRightCursor ( RelativeMove& move, int& htime
+                                           , int from_x, int to_x ) const
 {
-  std::string str{};
+  int pos = from_x;
+  int tabs{0};
   int htime_r{0};
+  std::size_t length{0};
 
   // try to use tab
   if ( tabstop > 0 && cursor.tab.cap )
   {
-    int pos = from_x;
+    const auto& tab_length = stringLength(cursor.tab.cap);
 
     for ( int tab_pos = pos + tabstop - (pos % tabstop)
         ; tab_pos <= to_x
         ; tab_pos += tabstop )
     {
-      htime_r += repeatedAppend (str, cursor.tab, 1);
-
-      if ( htime_r >= LONG_DURATION )
-        break;
+      if ( length + tab_length >= BUF_SIZE - 1 )
+        return;
 
+      length += tab_length;
+      htime_r += cursor.tab.duration;
+      tabs++;
       pos = tab_pos;
     }
-
-    num = to_x - pos;
   }
 
   // Use the cursor right capability
-  htime_r += repeatedAppend (str, cursor.right, num);
+  const int steps = to_x - pos;
+  const int step_time = repeatedDuration (cursor.right, steps, length);
+
+  if ( step_time >= LONG_DURATION )
+    return;
+
+  htime_r += step_time;
 
   if ( htime_r < htime )
   {
-    hmove = std::move(str);
+    move.horizontal = MoveType::Repeat;
+    move.tabs = tabs;
+    move.steps = steps;
     htime = htime_r;
   }
 }
 
 //----------------------------------------------------------------------
-inline void FOptiMove::rightMove ( std::string& hmove, int& htime
+inline void FOptiMove::rightMove ( RelativeMove& move, int& htime
                                  , int from_x, int to_x ) const
 {
-  int num = to_x - from_x;
-
-  if ( num == 0 )
-    return;
-
   if ( parm_cursor.right.cap && parm_cursor.right.duration < htime )
-    moveWithParmRightCursor (hmove, htime, num);
+  {
+    // Use parameterized cursor right capability
+    move.horizontal = MoveType::Parameter;
+    htime = parm_cursor.right.duration;
+  }
 
   if ( cursor.right.cap )
-    moveWithRightCursor (hmove, htime, num, from_x, to_x);
+    moveWithRightCursor (move, htime, from_x, to_x);
 }
 
 //----------------------------------------------------------------------
-inline void FOptiMove::moveWithParmLeftCursor ( std::string& hmove
-                                              , int& htime, int num ) const
+inline void FOptiMove::moveWithLeftCursor ( RelativeMove& move, int& htime
+                                          , int from_x, int to_x ) const
 {
-  // Use parameterized cursor right capability
-  hmove = FTermcap::encodeParameter(parm_cursor.left.cap, num);
-  htime = parm_cursor.left.duration;
-}
-
-//----------------------------------------------------------------------
-inline void FOptiMove::moveWithLeftCursor ( std::string& hmove, int& htime
-                                          , int num, int from_x, int to_x ) const
-{
-  std::string str{};
+  int pos = from_x;
+  int tabs{0};
   int htime_l{0};
+  std::size_t length{0};
 
   // try to use backward tab
   if ( tabstop > 0 && cursor.back_tab.cap )
   {
-    int pos = from_x;
+    const auto& back_tab_length = stringLength(cursor.back_tab.cap);
 
     for ( int tab_pos = ( pos > 0 ) ? ((pos - 1) / tabstop) * tabstop : -1
         ; tab_pos >= to_x
         ; tab_pos = ( pos > 0 ) ? ((pos - 1) / tabstop) * tabstop : -1)
     {
-      htime_l += repeatedAppend (str, cursor.back_tab, 1);
-
-      if ( htime_l >= LONG_DURATION )
-        break;
+      if ( length + back_tab_length >= BUF_SIZE - 1 )
+        return;
 
+      length += back_tab_length;
+      htime_l += cursor.back_tab.duration;
+      tabs++;
       pos = tab_pos;
     }
-
-    num = pos - to_x;
   }
 
   // Use the cursor left capability
-  htime_l += repeatedAppend (str, cursor.left, num);
+  const int steps = pos - to_x;
+  const int step_time = repeatedDuration (cursor.left, steps, length);
+
+  if ( step_time >= LONG_DURATION )
+    return;
+
+  htime_l += step_time;
 
   if ( htime_l < htime )
   {
-    hmove = std::move(str);
+    move.horizontal = MoveType::Repeat;
+    move.tabs = tabs;
+    move.steps = steps;
     htime = htime_l;
   }
 }
 
 //----------------------------------------------------------------------
-inline void FOptiMove::leftMove ( std::string& hmove, int& htime
+inline void FOptiMove::leftMove ( RelativeMove& move, int& htime
                                 , int from_x, int to_x ) const
 {
-  int num = from_x - to_x;
-
-  if ( num == 0 )
-    return;
-
   if ( parm_cursor.left.cap && parm_cursor.left.duration < htime )
-    moveWithParmLeftCursor (hmove, htime, num);
+  {
+    // Use parameterized cursor left capability
+    move.horizontal = MoveType::Parameter;
+    htime = parm_cursor.left.duration;
+  }
 
   if ( cursor.left.cap )
-    moveWithLeftCursor (hmove, htime, num, from_x, to_x);
+    moveWithLeftCursor (move, htime, from_x, to_x);
 }
 
 //----------------------------------------------------------------------
@@ -914,12 +1112,11 @@ inline auto FOptiMove::isMethod0Faster ( int& move_time
   if ( ! parm_cursor.address.cap )
     return false;
 
-  const auto move_xy = \
-    FTermcap::encodeMotionParameter(parm_cursor.address.cap, xnew, ynew);
+  move_buf.clear();
+  appendMotionParameter (move_buf, parm_cursor.address, xnew, ynew);
 
-  if ( ! move_xy.empty() )
+  if ( ! move_buf.empty() )
   {
-    move_buf = move_xy;
     move_time = parm_cursor.address.duration;
     return true;
   }
@@ -936,11 +1133,12 @@ inline auto FOptiMove::isMethod1Faster ( int& move_time
 
   if ( xold >= 0 && yold >= 0 )
   {
-    const int new_time = relativeMove (temp_result, xold, yold, xnew, ynew);
+    const auto move = relativeMove (xold, yold, xnew, ynew);
 
-    if ( new_time < LONG_DURATION && new_time < move_time )
+    if ( move.time < LONG_DURATION && move.time < move_time )
     {
-      move_time = new_time;
+      move_time = move.time;
+      best_move = move;
       return true;
     }
   }
@@ -957,12 +1155,13 @@ inline auto FOptiMove::isMethod2Faster ( int& move_time
 
   if ( yold >= 0 && cursor.carriage_return.cap )
   {
-    const int new_time = relativeMove (temp_result, 0, yold, xnew, ynew);
+    const auto move = relativeMove (0, yold, xnew, ynew);
 
-    if ( new_time < LONG_DURATION
-      && cursor.carriage_return.duration + new_time < move_time )
+    if ( move.time < LONG_DURATION
+      && cursor.carriage_return.duration + move.time < move_time )
     {
-      move_time = cursor.carriage_return.duration + new_time;
+      move_time = cursor.carriage_return.duration + move.time;
+      best_move = move;
       return true;
     }
   }
@@ -978,12 +1177,13 @@ inline auto FOptiMove::isMethod3Faster ( int& move_time
 
   if ( cursor.home.cap )
   {
-    const int new_time = relativeMove (temp_result, 0, 0, xnew, ynew);
+    const auto move = relativeMove (0, 0, xnew, ynew);
 
-    if ( new_time < LONG_DURATION
-      && cursor.home.duration + new_time < move_time )
+    if ( move.time < LONG_DURATION
+      && cursor.home.duration + move.time < move_time )
     {
-      move_time = cursor.home.duration + new_time;
+      move_time = cursor.home.duration + move.time;
+      best_move = move;
       return true;
     }
   }
@@ -996,15 +1196,17 @@ inline auto FOptiMove::isMethod4Faster ( int& move_time
                                        , int xnew, int ynew ) -> bool
 {
   // Test method 4: home-down + local movement
+
   if ( cursor.to_ll.cap )
   {
     int down = int(screen.height) - 1;
-    const int new_time = relativeMove (temp_result, 0, down, xnew, ynew);
+    const auto move = relativeMove (0, down, xnew, ynew);
 
-    if ( new_time < LONG_DURATION
-      && cursor.to_ll.duration + new_time < move_time )
+    if ( move.time < LONG_DURATION
+      && cursor.to_ll.duration + move.time < move_time )
     {
-      move_time = cursor.to_ll.duration + new_time;
+      move_time = cursor.to_ll.duration + move.time;
+      best_move = move;
       return true;
     }
   }
@@ -1018,6 +1220,7 @@ inline auto FOptiMove::isMethod5Faster ( int& move_time
                                        , int xnew, int ynew ) -> bool
 {
   // Test method 5: left margin for wrap to right-hand side
+
   if ( automatic_left_margin
     && ! eat_nl_glitch
     && yold > 0
@@ -1025,15 +1228,16 @@ inline auto FOptiMove::isMethod5Faster ( int& move_time
   {
     int x = int(screen.width) - 1;
     int y = yold - 1;
-    const int new_time = relativeMove (temp_result, x, y, xnew, ynew);
+    const auto move = relativeMove (x, y, xnew, ynew);
 
-    if ( new_time < LONG_DURATION
+    if ( move.time < LONG_DURATION
       && cursor.carriage_return.cap
       && cursor.carriage_return.duration
-       + cursor.left.duration + new_time < move_time )
+       + cursor.left.duration + move.time < move_time )
     {
       move_time = cursor.carriage_return.duration
-                + cursor.left.duration + new_time;
+                + cursor.left.duration + move.time;
+      best_move = move;
       return true;
     }
   }
@@ -1052,7 +1256,8 @@ void FOptiMove::moveByMethod ( int method
       return;
 
     case 1:
-      relativeMove (move_buf, xold, yold, xnew, ynew);
+      move_buf.clear();
+      appendRelativeMove (move_buf, best_move, xold, yold, xnew, ynew);
       break;
 
     case 2:
@@ -1083,16 +1288,14 @@ inline void FOptiMove::moveWithCarriageReturn (int yold, int xnew, int ynew)
     return;
 
   move_buf = cursor.carriage_return.cap;
-  relativeMove (temp_result, 0, yold, xnew, ynew);
-  move_buf.append(temp_result);
+  appendRelativeMove (move_buf, best_move, 0, yold, xnew, ynew);
 }
 
 //----------------------------------------------------------------------
 inline void FOptiMove::moveWithHome (int xnew, int ynew)
 {
   move_buf = cursor.home.cap;
-  relativeMove (temp_result, 0, 0, xnew, ynew);
-  move_buf.append(temp_result);
+  appendRelativeMove (move_buf, best_move, 0, 0, xnew, ynew);
 }
 
 //----------------------------------------------------------------------
@@ -1100,8 +1303,7 @@ inline void FOptiMove::moveWithToLL (int xnew, int ynew)
 {
   move_buf = cursor.to_ll.cap;
   int down = int(screen.height) - 1;
-  relativeMove (temp_result, 0, down, xnew, ynew);
-  move_buf.append(temp_result);
+  appendRelativeMove (move_buf, best_move, 0, down, xnew, ynew);
 }
 
 //----------------------------------------------------------------------
@@ -1116,8 +1318,7 @@ inline void FOptiMove::moveWithCRAndWrapToLeft ( int xold, int yold
   move_buf.append(cursor.left.cap);
   int x = int(screen.width) - 1;
   int y = yold - 1;
-  relativeMove (temp_result, x, y, xnew, ynew);
-  move_buf.append(temp_result);
+  appendRelativeMove (move_buf, best_move, x, y, xnew, ynew);
 }
 
 
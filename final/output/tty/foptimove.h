@@ -159,7 +159,7 @@ class FOptiMove final
 
     // Methods
     void  check_boundaries (int&, int&, int&, int&) const;
-    auto  moveCursor (int, int, int, int) -> std::string;
+    auto  moveCursor (int, int, int, int) -> const std::string&;
 
   private:
     struct Capability
@@ -167,6 +167,7 @@ class FOptiMove final
       const char* cap;
       int duration;
       int length;
+      std::string param_template;  // Precompiled parameter sequence
     };
 
     struct Cursor
@@ -208,6 +209,24 @@ class FOptiMove final
       std::size_t height{};
     };
 
+    // Enumeration
+    enum class MoveType : uInt8
+    {
+      None,       // No movement
+      Address,    // Absolute row or column address
+      Parameter,  // Parameterized relative movement
+      Repeat      // Repeated single steps (with tabs)
+    };
+
+    struct RelativeMove
+    {
+      int      time{0};
+      MoveType vertical{MoveType::None};
+      MoveType horizontal{MoveType::None};
+      int      tabs{0};   // Number of horizontal (back) tabs
+      int      steps{0};  // Number of single steps after the tabs
+    };
+
     // Constant
     static constexpr std::string::size_type BUF_SIZE{512u};
 
@@ -221,18 +240,24 @@ class FOptiMove final
     void  calculateCharDuration();
     auto  capDuration (const char[], int) const -> int;
     auto  capDurationToLength (int) const -> int;
-    auto  repeatedAppend (std::string&, const Capability&, int) const -> int;
-    auto  relativeMove (std::string&, int, int, int, int) const -> int;
-    auto  verticalMove (std::string&, int, int) const -> int;
-    void  downMove (std::string&, int&, int, int) const;
-    void  upMove (std::string&, int&, int, int) const;
-    auto  horizontalMove (std::string&, int, int) const -> int;
-    void  moveWithParmRightCursor (std::string&, int&, int) const;
-    void  moveWithRightCursor (std::string&, int&, int, int, int) const;
-    void  rightMove (std::string&, int&, int, int) const;
-    void  moveWithParmLeftCursor (std::string&, int&, int) const;
-    void  moveWithLeftCursor (std::string&, int&, int, int, int) const;
-    void  leftMove (std::string&, int&, int, int) const;
+    static auto  compileParamTemplate (const char[]) -> std::string;
+    static void  appendNumber (std::string&, int);
+    static void  appendTemplate (std::string&, const std::string&, int, int);
+    static void  appendParameter (std::string&, const Capability&, int);
+    static void  appendMotionParameter (std::string&, const Capability&, int, int);
+    static void  repeatedAppend (std::string&, const Capability&, int);
+    auto  repeatedDuration (const Capability&, int, std::size_t) const -> int;
+    auto  relativeMove (int, int, int, int) const -> RelativeMove;
+    void  appendRelativeMove ( std::string&, const RelativeMove&
+                             , int, int, int, int ) const;
+    auto  verticalMove (RelativeMove&, int, int) const -> int;
+    void  downMove (RelativeMove&, int&, int, int) const;
+    void  upMove (RelativeMove&, int&, int, int) const;
+    auto  horizontalMove (RelativeMove&, int, int) const -> int;
+    void  moveWithRightCursor (RelativeMove&, int&, int, int) const;
+    void  rightMove (RelativeMove&, int&, int, int) const;
+    void  moveWithLeftCursor (RelativeMove&, int&, int, int) const;
+    void  leftMove (RelativeMove&, int&, int, int) const;
 
     auto  isWideMove (int, int, int, int) const -> bool;
     auto  isMethod0Faster (int&, int, int) -> bool;
@@ -256,7 +281,7 @@ class FOptiMove final
     int         baudrate{9600};
     int         tabstop{0};
     std::string move_buf{};
-    std::string temp_result{};
+    RelativeMove best_move{};
     bool        automatic_left_margin{false};
     bool        eat_nl_glitch{false};
 
@@ -33,6 +33,7 @@
 #include "final/fapplication.h"
 #include "final/fc.h"
 #include "final/fstartoptions.h"
+#include "final/eventloop/pipedata.h"
 #include "final/input/fkeyboard.h"
 #include "final/input/fkey_map.h"
 #include "final/input/fmouse.h"
@@ -74,11 +75,13 @@ struct var
   static FTerm*      init_term_object;  // Global FTerm object
   static bool        term_initialized;  // Global init state
   static std::size_t object_counter;    // Counts the number of object instances
+  static PipeData    signal_pipe;       // Wakes up the event loop on signals
 };
 
 FTerm*      var::init_term_object{nullptr};
 bool        var::term_initialized{false};
 std::size_t var::object_counter{0};
+PipeData    var::signal_pipe{-1, -1};
 
 }  // namespace internal
 
@@ -153,6 +156,15 @@ auto FTerm::getTTYFileDescriptor() -> int
   return fterm_data.getTTYFileDescriptor();
 }
 
+//----------------------------------------------------------------------
+auto FTerm::getSignalFileDescriptor() -> int
+{
+  // The read end of the signal pipe becomes readable
+  // when a signal has been received
+
+  return internal::var::signal_pipe.getReadFd();
+}
+
 //----------------------------------------------------------------------
 auto FTerm::getTermType() -> std::string
 {
@@ -876,6 +888,24 @@ void FTerm::stringPrint (const std::string& str)
   }
 }
 
+//----------------------------------------------------------------------
+void FTerm::initCapabilities()
+{
+  // Prepares the output for the current termcap values
+
+  // Initialize terminal quirks
+  init_quirks();
+
+  // Initialize cursor movement optimization
+  init_optiMove();
+
+  // Initialize video attributes optimization
+  init_optiAttr();
+
+  // Initialize vt100 alternate character set
+  init_alt_charset();
+}
+
 
 // protected methods of FTerm
 //----------------------------------------------------------------------
@@ -1759,6 +1789,48 @@ inline void FTerm::disableApplicationEscKey()
     paddingPrint (CSI "?7727l");
 }
 
+//----------------------------------------------------------------------
+inline void FTerm::enableKeyboardProtocol()
+{
+  // Push the keyboard enhancement flags "disambiguate escape codes" (1)
+  // and "report event types" (2) onto the terminal's flag stack
+
+  static auto& term_detection = FTermDetection::getInstance();
+
+  if ( ! term_detection.hasKeyboardProtocolSupport() )
+    return;
+
+  paddingPrint (CSI ">3u");
+  std::fflush(stdout);
+  static auto& keyboard = FKeyboard::getInstance();
+  keyboard.enableKeyboardProtocol();
+
+  // Key releases only when the terminal confirms the event types flag
+  FTermios::setCaptureSendCharacters();
+  keyboard.setNonBlockingInput();
+  const auto flags = term_detection.getKeyboardProtocolFlags();
+  keyboard.unsetNonBlockingInput();
+  FTermios::unsetCaptureSendCharacters();
+
+  if ( flags >= 0 && (flags & 2) )
+    keyboard.enableKeyReleaseEvents();
+}
+
+//----------------------------------------------------------------------
+inline void FTerm::disableKeyboardProtocol()
+{
+  // Restore the previous keyboard enhancement flags
+
+  static auto& keyboard = FKeyboard::getInstance();
+
+  if ( ! keyboard.hasKeyboardProtocol() )
+    return;
+
+  paddingPrint (CSI "<u");
+  std::fflush(stdout);
+  keyboard.disableKeyboardProtocol();
+}
+
 //----------------------------------------------------------------------
 void FTerm::useAlternateScreenBuffer()
 {
@@ -1826,17 +1898,8 @@ void FTerm::init()
   // Initializes variables for the current terminal
   init_termcap();
 
-  // Initialize terminal quirks
-  init_quirks();
-
-  // Initialize cursor movement optimization
-  init_optiMove();
-
-  // Initialize video attributes optimization
-  init_optiAttr();
-
-  // Initialize vt100 alternate character set
-  init_alt_charset();
+  // Quirks, output optimization and alternate character set
+  initCapabilities();
 
   // Pass the terminal capabilities to the keyboard object
   FKeyboard::getInstance().setTermcapMap();
@@ -1851,17 +1914,23 @@ void FTerm::init()
   enableMouse();
 
   // Activate meta key sends escape + terminal focus event
+  // + bracketed paste
   if ( FTermData::getInstance().isTermType(FTermType::xterm) )
   {
     FTermXTerminal::getInstance().metaSendsESC(true);
 
     if ( getStartOptions().terminal_focus_events )
       FTermXTerminal::getInstance().setFocusSupport(true);
+
+    FTermXTerminal::getInstance().setBracketedPaste(true);
   }
 
   // switch to application escape key mode
   enableApplicationEscKey();
 
+  // Report the escape key as an unambiguous sequence
+  enableKeyboardProtocol();
+
   // Enter 'keyboard_transmit' mode
   enableKeypad();
 
@@ -2049,6 +2118,9 @@ void FTerm::finish() const
   // Switch to normal escape key mode
   disableApplicationEscKey();
 
+  // Leave the progressive keyboard enhancement mode
+  disableKeyboardProtocol();
+
   finishOSspecifics();
 
   if ( data.isTermType(FTermType::kde_konsole) )
@@ -2060,9 +2132,12 @@ void FTerm::finish() const
   if ( getStartOptions().mouse_support )
     disableMouse();
 
-  // Deactivate terminal focus event + meta key sends escape
+  // Deactivate bracketed paste + terminal focus event
+  // + meta key sends escape
   if ( data.isTermType(FTermType::xterm) )
   {
+    xterm.setBracketedPaste(false);
+
     if ( getStartOptions().terminal_focus_events )
       xterm.setFocusSupport(false);
 
@@ -2141,9 +2216,86 @@ void FTerm::processTermination (int signum)
   std::terminate();
 }
 
+//----------------------------------------------------------------------
+void FTerm::createSignalPipe()
+{
+  auto& signal_pipe = internal::var::signal_pipe;
+
+  if ( signal_pipe.getReadFd() != -1 )
+    return;
+
+  static const auto& fsystem = FSystem::getInstance();
+
+  if ( fsystem->pipe(signal_pipe) != 0 )
+  {
+    signal_pipe = PipeData{-1, -1};
+    return;
+  }
+
+  // A full pipe must never block the signal handler
+  for (const auto fd : { signal_pipe.getReadFd(), signal_pipe.getWriteFd() })
+  {
+    const int flags = fcntl(fd, F_GETFL);
+    fcntl (fd, F_SETFL, flags | O_NONBLOCK);
+    fcntl (fd, F_SETFD, FD_CLOEXEC);
+  }
+}
+
+//----------------------------------------------------------------------
+void FTerm::closeSignalPipe()
+{
+  auto& signal_pipe = internal::var::signal_pipe;
+
+  if ( signal_pipe.getReadFd() == -1 )
+    return;
+
+  static const auto& fsystem = FSystem::getInstance();
+  (void)fsystem->close(signal_pipe.getReadFd());
+  (void)fsystem->close(signal_pipe.getWriteFd());
+  signal_pipe = PipeData{-1, -1};
+}
+
+//----------------------------------------------------------------------
+void FTerm::clearSignalNotification()
+{
+  // Empties the signal pipe
+
+  const int fd = internal::var::signal_pipe.getReadFd();
+
+  if ( fd == -1 )
+    return;
+
+  std::array<char, 64> buffer{};
+
+  while ( ::read(fd, buffer.data(), buffer.size()) > 0 )
+    ;  // Read until the pipe is empty
+}
+
+//----------------------------------------------------------------------
+void FTerm::notifySignal()
+{
+  // Async-signal-safe notification of the event loop
+
+  const int fd = internal::var::signal_pipe.getWriteFd();
+
+  if ( fd == -1 )
+    return;
+
+  const int saved_errno = errno;
+  const char byte{1};
+
+  if ( ::write(fd, &byte, 1) < 0 )
+  {
+    // The pipe is full, there is already a notification
+  }
+
+  errno = saved_errno;
+}
+
 //----------------------------------------------------------------------
 void FTerm::setSignalHandler()
 {
+  createSignalPipe();
   signal(SIGTERM,  FTerm::signal_handler);  // Termination signal
   signal(SIGQUIT,  FTerm::signal_handler);  // Quit from keyboard (Ctrl-\)
   signal(SIGINT,   FTerm::signal_handler);  // Keyboard interrupt (Ctrl-C)
@@ -2163,6 +2315,7 @@ void FTerm::resetSignalHandler()
   signal(SIGINT,   SIG_DFL);  // Keyboard interrupt (Ctrl-C)
   signal(SIGQUIT,  SIG_DFL);  // Quit from keyboard (Ctrl-\)
   signal(SIGTERM,  SIG_DFL);  // Termination signal
+  closeSignalPipe();
 }
 
 //----------------------------------------------------------------------
@@ -2172,6 +2325,7 @@ void FTerm::signal_handler (int sig_num)
   {
     case SIGWINCH:
       terminalSizeChange();
+      notifySignal();
       break;
 
     case SIGTERM:
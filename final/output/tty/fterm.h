@@ -171,6 +171,7 @@ class FTerm final
     static auto getKeyName (FKey) -> FString;
     auto        getCharSubstitutionMap() & -> FCharSubstitution&;
     static auto getTTYFileDescriptor() -> int;
+    static auto getSignalFileDescriptor() -> int;
     static auto getTermType() -> std::string;
     static auto getTermFileName() -> std::string;
     static auto getTabstop() -> int;
@@ -235,8 +236,10 @@ class FTerm final
     static void stringPrint (const std::string&);
 
     void initTerminal();
+    static void initCapabilities();
     static void initScreenSettings();
     static void changeTermSizeFinished();
+    static void clearSignalNotification();
 
   private:
     // Methods
@@ -283,6 +286,8 @@ class FTerm final
     static void disableMouse();
     static void enableApplicationEscKey();
     static void disableApplicationEscKey();
+    static void enableKeyboardProtocol();
+    static void disableKeyboardProtocol();
     static void enableKeypad();
     static void disableKeypad();
     static void enableAlternateCharset();
@@ -299,6 +304,9 @@ class FTerm final
     static void printExitMessage();
     static void terminalSizeChange();
     [[noreturn]] static void processTermination (int);
+    static void createSignalPipe();
+    static void closeSignalPipe();
+    static void notifySignal();
     static void setSignalHandler();
     static void resetSignalHandler();
     static void signal_handler (int);
@@ -76,7 +76,7 @@ class FTermcap final
     };
 
     // Using-declaration
-    using TCapMapType = std::array<TCapMap, 86>;
+    using TCapMapType = std::array<TCapMap, 93>;
     using PutCharFunc = std::decay_t<int(int)>;
     using PutStringFunc = std::decay_t<int(const std::string&)>;
 
@@ -105,6 +105,7 @@ class FTermcap final
     static void  setPutStringFunction (const PutString&);
     static void  setDefaultPutStringFunction();
     static void  setBaudrate (int);
+    static void  setInitialized (bool = true);
 
     // Methods
     static void  init();
@@ -196,6 +197,14 @@ inline void FTermcap::setBaudrate (int baud)
   baudrate = baud;
 }
 
+//----------------------------------------------------------------------
+inline void FTermcap::setInitialized (bool state)
+{
+  // Marks capabilities that were not read from
+  // the termcap database as usable
+  initialized = state;
+}
+
 //----------------------------------------------------------------------
 inline void FTermcap::delayOutput (int ms)
 {
@@ -32,6 +32,7 @@
 
 #include "final/fapplication.h"
 #include "final/fc.h"
+#include "final/fstartoptions.h"
 #include "final/ftypes.h"
 #include "final/input/fkeyboard.h"
 #include "final/output/tty/ftermcap.h"
@@ -106,6 +107,40 @@ void FTermDetection::detect()
   detectTerminal();
 }
 
+//----------------------------------------------------------------------
+auto FTermDetection::getKeyboardProtocolFlags() const -> int
+{
+  // Request the current keyboard enhancement flags (CSI ? u).
+  // The primary device attributes (DA) are requested afterwards,
+  // so that other terminals do not have to wait for the timeout.
+
+  const auto& stdout_no{FTermios::getStdOut()};
+  const std::string QUERY_DA{CSI "?u" CSI "c"};
+
+  if ( write(stdout_no, QUERY_DA.data(), QUERY_DA.length()) == -1 )
+    return -1;
+
+  std::fflush(stdout);
+  std::array<char, 64> temp{};
+  auto isWithout_c = [] (const auto& t) { return ! std::strchr(t.data(), 'c'); };
+  auto pos = captureTerminalInput(temp, 150'000, isWithout_c);
+  const char* report = temp.data();
+  int flags{-1};
+  char final_char{'\0'};
+
+  // The DA answer (CSI ? ... c) starts with the same characters
+  while ( pos > 0 && (report = std::strstr(report, CSI "?")) != nullptr )
+  {
+    if ( std::sscanf(report, "\033[?%4d%c", &flags, &final_char) == 2
+      && final_char == 'u' )
+      return flags;
+
+    report++;
+  }
+
+  return -1;  // No answer or no keyboard protocol support
+}
+
 
 // private methods of FTermDetection
 //----------------------------------------------------------------------
@@ -303,6 +338,23 @@ inline auto FTermDetection::isTerminalWithoutDetection() const -> bool
       || fterm_data.isTermType(FTermType::kterm);
 }
 
+//----------------------------------------------------------------------
+inline auto FTermDetection::canQueryTerminalModes() const -> bool
+{
+  // The consoles and cygwin/mintty do not answer the mode and
+  // keyboard flag queries, so each query would wait for the full timeout
+
+  static const auto& fterm_data = FTermData::getInstance();
+
+  return ! fterm_data.isTermType ( FTermType::cygwin
+                                 | FTermType::mintty
+                                 | FTermType::linux_con
+                                 | FTermType::freebsd_con
+                                 | FTermType::netbsd_con
+                                 | FTermType::openbsd_con
+                                 | FTermType::sun_con );
+}
+
 //----------------------------------------------------------------------
 inline void FTermDetection::handleScreenAndTmux() const
 {
@@ -344,6 +396,12 @@ void FTermDetection::detectTerminal()
     // Determines the maximum number of colors
     new_termtype = determineMaxColor(new_termtype);
 
+    // Query the synchronized output mode (DEC private mode 2026)
+    detectSynchronizedOutput();
+
+    // Query the progressive keyboard enhancement (CSI ? u)
+    detectKeyboardProtocol();
+
     keyboard.unsetNonBlockingInput();
     FTermios::unsetCaptureSendCharacters();
   }
@@ -980,4 +1038,64 @@ inline void FTermDetection::correctFalseAssumptions (int terminal_id_type) const
     fterm_data.unsetTermType (FTermType::kde_konsole);
 }
 
+//----------------------------------------------------------------------
+void FTermDetection::detectSynchronizedOutput()
+{
+  // Terminals with synchronized output support can bracket
+  // a screen update to display it as a whole
+
+  sync_output_support = false;
+
+  if ( ! FStartOptions::getInstance().synchronized_output
+    || ! canQueryTerminalModes() )
+    return;
+
+  // DECRPM Ps values: 1 = set, 2 = reset (both changeable)
+  const auto mode = getSynchronizedOutputMode();
+  sync_output_support = ( mode == 1 || mode == 2 );
+}
+
+//----------------------------------------------------------------------
+auto FTermDetection::getSynchronizedOutputMode() const -> int
+{
+  // Request the DEC private mode 2026 (DECRQM). The primary device
+  // attributes (DA) are requested afterwards, so that terminals that
+  // do not know DECRQM do not have to wait for the timeout.
+
+  const auto& stdout_no{FTermios::getStdOut()};
+  const std::string DECRQM_DA{CSI "?2026$p" CSI "c"};
+
+  if ( write(stdout_no, DECRQM_DA.data(), DECRQM_DA.length()) == -1 )
+    return -1;
+
+  std::fflush(stdout);
+  std::array<char, 64> temp{};
+  auto isWithout_c = [] (const auto& t) { return ! std::strchr(t.data(), 'c'); };
+  auto pos = captureTerminalInput(temp, 150'000, isWithout_c);
+  const char* report = std::strstr(temp.data(), CSI "?2026;");
+  constexpr auto parse = "\033[?2026;%1d$y";
+  int mode{-1};
+
+  if ( pos > 0 && report && std::sscanf(report, parse, &mode) == 1 )
+    return mode;
+
+  return -1;  // No answer or an unsupported mode request
+}
+
+//----------------------------------------------------------------------
+void FTermDetection::detectKeyboardProtocol()
+{
+  // Terminals with the progressive keyboard enhancement protocol
+  // report the escape key and modified keys as unambiguous CSI u
+  // sequences. The escape key then needs no keypress timeout.
+
+  keyboard_protocol = false;
+
+  if ( ! FStartOptions::getInstance().keyboard_protocol
+    || ! canQueryTerminalModes() )
+    return;
+
+  keyboard_protocol = ( getKeyboardProtocolFlags() >= 0 );
+}
+
 }  // namespace finalcut
@@ -73,6 +73,8 @@ class FTermDetection final
     auto  canDisplay256Colors() const noexcept -> bool;
     auto  hasTerminalDetection() const noexcept -> bool;
     auto  hasSetCursorStyleSupport() const noexcept -> bool;
+    auto  hasSynchronizedOutputSupport() const noexcept -> bool;
+    auto  hasKeyboardProtocolSupport() const noexcept -> bool;
 
     // Mutators
     void  setTerminalDetection (bool = true) noexcept;
@@ -80,6 +82,7 @@ class FTermDetection final
 
     // Methods
     void  detect();
+    auto  getKeyboardProtocolFlags() const -> int;
 
   private:
     struct colorEnv
@@ -116,6 +119,7 @@ class FTermDetection final
     void  termtypeAnalysis();
     auto  findMatchingTerm (const TermTypeMap&) -> TermTypeMap::const_iterator;
     auto  isTerminalWithoutDetection() const -> bool;
+    auto  canQueryTerminalModes() const -> bool;
     void  handleScreenAndTmux() const;
     void  detectTerminal();
     auto  init_256colorTerminal() -> FString;
@@ -143,6 +147,9 @@ class FTermDetection final
     auto  secDA_Analysis_vte (const FString&) -> FString;
     auto  secDA_Analysis_kitty (const FString&) -> FString;
     void  correctFalseAssumptions (int) const;
+    void  detectSynchronizedOutput();
+    auto  getSynchronizedOutputMode() const -> int;
+    void  detectKeyboardProtocol();
 
     // Data members
 #if DEBUG
@@ -153,6 +160,8 @@ class FTermDetection final
     FString      termtype{};
     FString      ttytypename{"/etc/ttytype"};  // Default ttytype file
     bool         decscusr_support{false};      // Preset to false
+    bool         sync_output_support{false};   // Preset to false
+    bool         keyboard_protocol{false};     // Preset to false
     bool         terminal_detection{true};     // Preset to true
     bool         color256{};
     FString      answer_back{};
@@ -193,6 +202,14 @@ inline auto FTermDetection::canDisplay256Colors() const noexcept -> bool
 inline auto FTermDetection::hasSetCursorStyleSupport() const noexcept -> bool
 { return decscusr_support; }
 
+//----------------------------------------------------------------------
+inline auto FTermDetection::hasSynchronizedOutputSupport() const noexcept -> bool
+{ return sync_output_support; }
+
+//----------------------------------------------------------------------
+inline auto FTermDetection::hasKeyboardProtocolSupport() const noexcept -> bool
+{ return keyboard_protocol; }
+
 //----------------------------------------------------------------------
 inline auto FTermDetection::hasTerminalDetection() const noexcept -> bool
 { return terminal_detection; }
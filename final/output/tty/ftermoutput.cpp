@@ -20,8 +20,15 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
-#include <algorithm>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/ioctl.h>
+#include <sys/uio.h>
 #include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
 #include <unordered_map>
 
 #include "final/fobject.h"
@@ -32,13 +39,16 @@
 #include "final/output/tty/foptimove.h"
 #include "final/output/tty/ftermcap.h"
 #include "final/output/tty/ftermdata.h"
+#include "final/output/tty/ftermdetection.h"
 #include "final/output/tty/ftermfreebsd.h"
 #include "final/output/tty/ftermios.h"
 #include "final/output/tty/ftermoutput.h"
 #include "final/output/tty/ftermxterminal.h"
-#include "final/util/char_ringbuffer.h"
 #include "final/util/fpoint.h"
 #include "final/util/fsize.h"
+#include "final/util/fsystem.h"
+#include "final/vterm/fframeprofiler.h"
+#include "final/vterm/flinediff.h"
 
 namespace finalcut
 {
@@ -67,8 +77,7 @@ constexpr uInt8 var::b2_printed_mask;
 // static class attributes
 FVTerm::FTermArea* FTermOutput::vterm{nullptr};
 FTermData*         FTermOutput::fterm_data{nullptr};
-constexpr uInt64   FTermOutput::MIN_FLUSH_WAIT;
-constexpr uInt64   FTermOutput::MAX_FLUSH_WAIT;
+FTermOutput*       FTermOutput::active_term_output{nullptr};
 
 //----------------------------------------------------------------------
 // class FTermOutput
@@ -80,12 +89,21 @@ FTermOutput::FTermOutput (const FVTerm& t)  // constructor
   : FOutput{t}
 {
   fterm_data = &FTermData::getInstance();
-  FTermcap::setDefaultPutCharFunction();
-  FTermcap::setDefaultPutStringFunction();
+  active_term_output = this;
+  FTermcap::setPutCharFunction (&putStdioChar);
+  FTermcap::setPutStringFunction (&putStdioString);
 }
 
 //----------------------------------------------------------------------
-FTermOutput::~FTermOutput() noexcept = default;  // destructor
+FTermOutput::~FTermOutput() noexcept  // destructor
+{
+  if ( active_term_output != this )
+    return;
+
+  active_term_output = nullptr;
+  FTermcap::setDefaultPutCharFunction();
+  FTermcap::setDefaultPutStringFunction();
+}
 
 
 // public methods of FTermOutput
@@ -125,6 +143,21 @@ auto FTermOutput::getKeyName (FKey keynum) const -> FString
   return FTerm::getKeyName(keynum);
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::getFlushDeadline() const -> TimeValue
+{
+  // Returns the earliest time for the next flush of buffered output
+  // or pending terminal updates, or TimeValue::max() if there is
+  // nothing to flush
+
+  if ( output_buffer.empty() && padding_controls.empty()
+    && ( ! FVTerm::hasPendingTerminalUpdates()
+      || FVTerm::areTerminalUpdatesPaused() ) )
+    return TimeValue::max();
+
+  return frame_pacer.getNextFrameTime();
+}
+
 //----------------------------------------------------------------------
 auto FTermOutput::isMonochron() const -> bool
 {
@@ -146,7 +179,8 @@ auto FTermOutput::isEncodable (const wchar_t& wide_char) const -> bool
 //----------------------------------------------------------------------
 auto FTermOutput::isFlushTimeout() const -> bool
 {
-  return FObjectTimer::isTimeout (time_last_flush, flush_wait);
+  // The frame pacer decides on the basis of the last backlog sample
+  return frame_pacer.isFrameDue (FObjectTimer::getCurrentTime());
 }
 
 //----------------------------------------------------------------------
@@ -209,6 +243,7 @@ void FTermOutput::setCursor (FPoint p)
 //----------------------------------------------------------------------
 void FTermOutput::setCursor (CursorMode mode)
 {
+  waitForPendingOutput();
   if ( mode == CursorMode::Insert )
     FTerm::setInsertCursor();
   else if ( mode == CursorMode::Overwrite )
@@ -237,18 +272,21 @@ void FTermOutput::hideCursor (bool enable)
 //----------------------------------------------------------------------
 void FTermOutput::setTerminalSize (FSize size)
 {
+  waitForPendingOutput();
   FTerm::setTermSize(size);
 }
 
 //----------------------------------------------------------------------
 auto FTermOutput::setVGAFont() -> bool
 {
+  waitForPendingOutput();
   return FTerm::setVGAFont();
 }
 
 //----------------------------------------------------------------------
 auto FTermOutput::setNewFont() -> bool
 {
+  waitForPendingOutput();
   return FTerm::setNewFont();
 }
 
@@ -276,14 +314,14 @@ void FTermOutput::setNonBlockingRead (bool enable)
 //----------------------------------------------------------------------
 void FTermOutput::initTerminal (FVTerm::FTermArea* virtual_terminal)
 {
-  getFTerm().initTerminal();
+  initTerminalDevice();
   internal::var::terminal_encoding = fterm_data->getTerminalEncoding();
 
   // Redefine the color palette
   redefineColorPalette();
 
   vterm         = virtual_terminal;
-  output_buffer = std::make_shared<OutputBuffer>();
+  output_buffer.reserve(BUFFER_SIZE);
   term_pos      = std::make_shared<FPoint>(-1, -1);
 
   // Hide the input cursor
@@ -296,16 +334,21 @@ void FTermOutput::initTerminal (FVTerm::FTermArea* virtual_terminal)
   // Check for support for combined characters
   init_combined_character();
 
+  // Check for support for synchronized output
+  init_synchronized_output();
+
   // Resetting the status of terminal attributes
   clearTerminalState();
 
-  // Initialize the last flush time
-  time_last_flush = TimeValue{};
+  // Discard the measurements of the frame pacing
+  frame_pacer.reset();
 }
 
 //----------------------------------------------------------------------
 void FTermOutput::finishTerminal()
 {
+  waitForPendingOutput();
+
   // Restore the color palette
   restoreColorPalette();
 
@@ -315,6 +358,9 @@ void FTermOutput::finishTerminal()
   // Clear the terminal
   if ( fterm_data->isInAlternateScreen() )
     clearTerminal();
+
+  waitForPendingOutput();
+  closeOutputDevice();
 }
 
 //----------------------------------------------------------------------
@@ -322,7 +368,13 @@ auto FTermOutput::updateTerminal() -> bool
 {
   // Updates pending changes to the terminal
 
+  FFrameProfiler::ScopedPhase diff_phase{FFrameProfiler::Phase::Diff};
   int changedlines{0};
+  beginSynchronizedUpdate();
+
+  // Move shifted lines with a hardware scroll
+  if ( scrollChangedLines() )
+    changedlines++;
 
   for (uInt y{0}; y < uInt(vterm->size.height); y++)
   {
@@ -336,7 +388,9 @@ auto FTermOutput::updateTerminal() -> bool
 
   // sets the new input cursor position
   const auto& cursor_update = updateTerminalCursor();
-  return cursor_update || changedlines > 0;
+  const bool updated = cursor_update || changedlines > 0;
+  endSynchronizedUpdate (updated);
+  return updated;
 }
 
 //----------------------------------------------------------------------
@@ -363,6 +417,7 @@ auto FTermOutput::scrollTerminalForward() -> bool
   if ( ! TCAP(t_scroll_forward) )
     return false;
 
+  waitForPendingOutput();
   FTerm::scrollTermForward();
   return true;
 }
@@ -373,6 +428,7 @@ auto FTermOutput::scrollTerminalReverse() -> bool
   if ( ! TCAP(t_scroll_reverse) )
     return false;
 
+  waitForPendingOutput();
   FTerm::scrollTermReverse();
   return true;
 }
@@ -380,6 +436,7 @@ auto FTermOutput::scrollTerminalReverse() -> bool
 //----------------------------------------------------------------------
 void FTermOutput::clearTerminalAttributes()
 {
+  waitForPendingOutput();
   FTerm::clearTerminalAttributes();
 }
 
@@ -446,30 +503,87 @@ void FTermOutput::flush()
 {
   // Flush the output buffer
 
-  flushTimeAdjustment();
-
-  if ( ! output_buffer || output_buffer->isEmpty()
+  if ( (output_buffer.empty() && padding_controls.empty())
     || ! (isFlushTimeout() || getFVTerm().isTerminalUpdateForced()) )
     return;
 
-  while ( ! output_buffer->isEmpty() )
+  std::fflush(stdout);  // Previous stdio output must come first
+  static auto& profiler = FFrameProfiler::getInstance();
+  std::size_t frame_bytes{output_buffer.size()};
+
+  for (const auto& control : padding_controls)
+    frame_bytes += control.data.size();
+
+  profiler.addBytesWritten (frame_bytes);
+
+  if ( padding_controls.empty() )
   {
-    const auto& first = output_buffer->front();
-    const auto& type = first.type;
-    const auto& data = first.data;
+    writeOutputBuffer();  // Output the whole buffer at once
+  }
+  else
+  {
+    // Delays only work if all previous output has been written
+    waitForPendingOutput();
+    std::size_t start{0};
+
+    for (const auto& control : padding_controls)
+    {
+      // Control strings with delay are output via the termcap padding
+      if ( control.position > start )
+        FTerm::stringPrint (output_buffer.substr(start, control.position - start));
+
+      FTerm::paddingPrint (control.data);
+      start = control.position;
+    }
 
-    if ( type == OutputType::String )
-      FTerm::stringPrint (data);
-    else if ( type == OutputType::Control )
-      FTerm::paddingPrint (data);
+    if ( start < output_buffer.size() )
+      FTerm::stringPrint (output_buffer.substr(start));
 
-    output_buffer->pop();
+    std::fflush(stdout);
   }
 
-  std::fflush(stdout);
+  output_buffer.clear();
+  padding_controls.clear();
   static auto& mouse = FMouseControl::getInstance();
   mouse.drawPointer();
-  time_last_flush = FObjectTimer::getCurrentTime();
+  const auto now = FObjectTimer::getCurrentTime();
+  frame_pacer.frameWritten (now, frame_bytes, getOutputBacklog());
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::flushPendingOutput()
+{
+  // Continues writing the rest of the output without blocking
+
+  if ( ! hasPendingOutput() )
+    return;
+
+  std::array<struct iovec, 1> iov
+  {{
+    { &pending_output[pending_offset], pending_output.size() - pending_offset }
+  }};
+  pending_offset += writeNonBlocking (iov.data(), int(iov.size()));
+
+  if ( pending_offset >= pending_output.size() )
+  {
+    pending_output.clear();
+    pending_offset = 0;
+  }
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::measureOutputBacklog()
+{
+  // Takes one backlog sample per event loop pass. A frame held back
+  // by the backlog is only counted if there are terminal changes.
+
+  const auto now = FObjectTimer::getCurrentTime();
+  const auto backlog = getOutputBacklog();
+
+  if ( FVTerm::hasPendingTerminalUpdates() )
+    frame_pacer.recordBacklog (now, backlog);
+  else
+    frame_pacer.measure (now, backlog);
 }
 
 //----------------------------------------------------------------------
@@ -486,6 +600,27 @@ inline auto FTermOutput::getStartOptions() & -> FStartOptions&
   return FStartOptions::getInstance();
 }
 
+//----------------------------------------------------------------------
+auto FTermOutput::getOutputBacklog() const -> std::size_t
+{
+  // Returns the number of bytes that have been written
+  // but not yet sent to the terminal
+
+  std::size_t backlog = pending_output.size() - pending_offset;
+
+#if defined(TIOCOUTQ)
+  // Bytes in the output queue of the terminal driver
+  static const auto& fsys = FSystem::getInstance();
+  int queued{0};
+
+  if ( fsys->ioctl(FTermios::getStdOut(), TIOCOUTQ, &queued) == 0
+    && queued > 0 )
+    backlog += std::size_t(queued);
+#endif
+
+  return backlog;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::isInputCursorInsideTerminal() const -> bool
 {
@@ -558,6 +693,58 @@ void FTermOutput::restoreColorPalette()
   FTerm::resetColorMap();
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::initTerminalDevice()
+{
+  // Initializes the terminal device and the capabilities
+
+  getFTerm().initTerminal();
+  openOutputDevice();
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::openOutputDevice()
+{
+  // Stdin and stdout share one open file description on a tty.
+  // Opening the terminal a second time gives the output its own
+  // file description, which stays non-blocking for the entire
+  // session without changing the blocking mode of stdin and stdout.
+
+  static const auto& fsys = FSystem::getInstance();
+  const auto& term_filename = fterm_data->getTermFileName();
+  closeOutputDevice();
+
+  if ( term_filename.empty() )
+    return;
+
+  const int fd = fsys->open ( term_filename.data()
+                            , O_WRONLY | O_NOCTTY | O_NONBLOCK | O_CLOEXEC );
+
+  if ( fd < 0 )
+    return;  // Use the blocking stdout
+
+  output_fd = fd;
+  non_blocking_output = true;
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::closeOutputDevice()
+{
+  if ( output_fd < 0 )
+    return;
+
+  static const auto& fsys = FSystem::getInstance();
+  fsys->close(output_fd);
+  output_fd = -1;
+  non_blocking_output = false;
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getOutputDevice() const noexcept -> int
+{
+  return ( output_fd < 0 ) ? FTermios::getStdOut() : output_fd;
+}
+
 //----------------------------------------------------------------------
 void FTermOutput::init_characterLengths()
 {
@@ -605,6 +792,17 @@ void FTermOutput::init_combined_character()
   }
 }
 
+//----------------------------------------------------------------------
+void FTermOutput::init_synchronized_output()
+{
+  // Bracket screen updates only if the terminal has confirmed
+  // the DEC private mode 2026. Otherwise, the sequences are omitted.
+
+  static const auto& term_detection = FTermDetection::getInstance();
+  synchronized_output = getStartOptions().synchronized_output
+                     && term_detection.hasSynchronizedOutputSupport();
+}
+
 //----------------------------------------------------------------------
 auto FTermOutput::canClearToEOL (uInt xmin, uInt y) const -> bool
 {
@@ -720,24 +918,8 @@ auto FTermOutput::skipUnchangedCharacters ( uInt& x, uInt xmax, uInt y
   if ( ! print_char->attr.bit.no_changes )
     return false;
 
-  const auto* ch = print_char + 1;  // Skip first unchanged character
-  const auto* end = ch + xmax - x;
-
-  // Unroll the loop for better performance
-  while ( ch + 4 <= end
-       && ch[0].attr.bit.no_changes && ch[1].attr.bit.no_changes
-       && ch[2].attr.bit.no_changes && ch[3].attr.bit.no_changes )
-  {
-    std::advance(ch, 4);
-  }
-
-  // Handle the remaining elements
-  while ( ch < end && ch->attr.bit.no_changes )
-  {
-    std::advance(ch, 1);
-  }
-
-  auto count = uInt(ch - print_char);  // Number of unchanged characters
+  // Number of unchanged characters (including the first one)
+  const auto count = 1 + uInt(countUnchangedCells(print_char + 1, xmax - x));
 
   if ( count > cursor_address_length )
   {
@@ -1149,6 +1331,155 @@ inline void FTermOutput::adjustCursorPosition (FPoint& p) const
     y = term_height - 1;
 }
 
+//----------------------------------------------------------------------
+inline void FTermOutput::beginSynchronizedUpdate()
+{
+  // Begin synchronized update (BSU)
+
+  if ( ! synchronized_output )
+    return;
+
+  appendOutputBuffer (std::string{CSI "?2026h"});
+  sync_update_start = output_buffer.size();
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::endSynchronizedUpdate (bool updated)
+{
+  // End synchronized update (ESU)
+
+  if ( ! synchronized_output )
+    return;
+
+  constexpr std::size_t bsu_length = sizeof(CSI "?2026h") - 1;
+
+  if ( ! updated
+    && output_buffer.size() == sync_update_start
+    && sync_update_start >= bsu_length )
+    output_buffer.resize(sync_update_start - bsu_length);  // Remove the BSU
+  else
+    appendOutputBuffer (std::string{CSI "?2026l"});
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::scrollChangedLines() -> bool
+{
+  // Scrolls a vertically shifted block of lines on the terminal
+  // if this is cheaper than printing the lines again
+
+  const auto& shift = FVTerm::findTerminalLineShift(cursor_address_length);
+
+  if ( shift.distance == 0 )
+    return false;
+
+  auto scroll_string = getScrollRegionString(shift);
+
+  if ( scroll_string.empty() )
+    scroll_string = getInsertDeleteLineString(shift);
+
+  if ( scroll_string.empty() || scroll_string.length() >= shift.savings )
+    return false;
+
+  appendOutputBuffer (FTermControl{scroll_string});
+  term_pos->setPoint(-1, -1);  // The cursor position is now unknown
+  FVTerm::shiftTerminalLines(shift);
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getScrollRegionString (const FVTerm::FLineShift& shift) const -> std::string
+{
+  // Scrolls the lines with a scroll region (DECSTBM) and
+  // index (IND) or reverse index (RI)
+
+  const auto& cs = TCAP(t_change_scroll_region);
+  const auto& cm = TCAP(t_cursor_address);
+  const auto& scroll = ( shift.distance > 0 ) ? TCAP(t_scroll_forward)
+                                              : TCAP(t_scroll_reverse);
+  const auto& parm_scroll = ( shift.distance > 0 ) ? TCAP(t_parm_index)
+                                                   : TCAP(t_parm_rindex);
+  const auto lines = std::abs(shift.distance);
+
+  if ( ! cs || ! cm || (! scroll && ! parm_scroll) )
+    return {};
+
+  // The cursor must be on the margin in the scroll direction
+  const auto margin = int(( shift.distance > 0 ) ? shift.bottom : shift.top);
+  std::string str{FTermcap::encodeParameter(cs, shift.top, shift.bottom)};
+  str += FTermcap::encodeMotionParameter(cm, 0, margin);
+
+  if ( parm_scroll && (lines > 1 || ! scroll) )
+    str += FTermcap::encodeParameter(parm_scroll, lines);
+  else
+    for (auto n{0}; n < lines; n++)
+      str += scroll;
+
+  // Restore the full screen scroll region
+  str += FTermcap::encodeParameter(cs, 0, vterm->size.height - 1);
+  return str;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::getInsertDeleteLineString (const FVTerm::FLineShift& shift) const -> std::string
+{
+  // Scrolls the lines with delete line (DL) and insert line (IL)
+  // if the terminal has no scroll region
+
+  const auto& cm = TCAP(t_cursor_address);
+  const auto& dl = TCAP(t_delete_line);
+  const auto& il = TCAP(t_insert_line);
+  const auto& DL = TCAP(t_parm_delete_line);
+  const auto& IL = TCAP(t_parm_insert_line);
+  const auto lines = std::abs(shift.distance);
+
+  if ( ! cm || (! dl && ! DL) || (! il && ! IL) )
+    return {};
+
+  const auto repeat = [lines] (const char* cap, const char* parm_cap)
+  {
+    if ( parm_cap && (lines > 1 || ! cap) )
+      return FTermcap::encodeParameter(parm_cap, lines);
+
+    std::string str{};
+
+    for (auto n{0}; n < lines; n++)
+      str += cap;
+
+    return str;
+  };
+
+  const auto last_line = uInt(vterm->size.height - 1);
+  const auto gap = uInt(shift.bottom) + 1 - uInt(lines);  // First line below the moved lines
+  std::string str{};
+
+  if ( shift.distance > 0 )
+  {
+    // Delete at the top and insert below the region
+    str += FTermcap::encodeMotionParameter(cm, 0, int(shift.top));
+    str += repeat(dl, DL);
+
+    if ( shift.bottom < last_line )
+    {
+      str += FTermcap::encodeMotionParameter(cm, 0, int(gap));
+      str += repeat(il, IL);
+    }
+  }
+  else
+  {
+    // Delete below the region and insert at the top
+    if ( shift.bottom < last_line )
+    {
+      str += FTermcap::encodeMotionParameter(cm, 0, int(gap));
+      str += repeat(dl, DL);
+    }
+
+    str += FTermcap::encodeMotionParameter(cm, 0, int(shift.top));
+    str += repeat(il, IL);
+  }
+
+  return str;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::updateTerminalLine (uInt y) -> bool
 {
@@ -1164,6 +1495,8 @@ inline auto FTermOutput::updateTerminalLine (uInt y) -> bool
     return false;
   }
 
+  FFrameProfiler::ScopedPhase encode_phase{FFrameProfiler::Phase::Encode};
+
   // Clear rest of line
   if ( canClearToEOL (xmin, y) )
   {
@@ -1210,6 +1543,8 @@ auto FTermOutput::updateTerminalCursor() -> bool
 {
   // Updates the input cursor visibility and the position
 
+  FFrameProfiler::ScopedPhase encode_phase{FFrameProfiler::Phase::Encode};
+
   if ( isInputCursorInsideTerminal() )
   {
     setCursor (FPoint{vterm->input_cursor.x, vterm->input_cursor.y});
@@ -1221,52 +1556,13 @@ auto FTermOutput::updateTerminalCursor() -> bool
   return false;
 }
 
-//----------------------------------------------------------------------
-inline void FTermOutput::flushTimeAdjustment()
-{
-  const auto now = FObjectTimer::getCurrentTime();
-  const auto diff = now - time_last_flush;
-
-  if ( diff > milliseconds(400) )
-  {
-    flush_wait = MIN_FLUSH_WAIT;  // Reset to minimum values after 400 ms
-    flush_average = MIN_FLUSH_WAIT;
-    flush_median = MIN_FLUSH_WAIT;
-  }
-  else
-  {
-    auto usec = uInt64(duration_cast<microseconds>(diff).count());
-    usec = std::min(std::max(usec, MIN_FLUSH_WAIT), MAX_FLUSH_WAIT);
-
-    if ( usec >= flush_average )
-      flush_average += (usec - flush_average) / 10;
-    else
-    {
-      uInt64 delta = (flush_average - usec) / 10;
-
-      if ( flush_average >= delta )  // Avoid uInt64 underflow
-        flush_average -= delta;
-    }
-
-    if ( usec >= flush_median )
-      flush_median += flush_average / 5;
-    else
-    {
-      uInt64 delta = flush_average / 5;
-
-      if ( flush_median >= delta )  // Avoid uInt64 underflow
-        flush_median -= delta;
-    }
-
-    flush_wait = flush_median;
-  }
-}
-
 //----------------------------------------------------------------------
 inline void FTermOutput::markAsPrinted (uInt x, uInt y) const
 {
   // Marks a character as printed
 
+  static auto& profiler = FFrameProfiler::getInstance();
+  profiler.addCellsEmitted (1);
   vterm->getFChar(int(x), int(y)).attr.byte[2] |= internal::var::b2_printed_mask;
 }
 
@@ -1275,6 +1571,8 @@ inline void FTermOutput::markAsPrinted (uInt from, uInt to, uInt y) const
 {
   // Marks characters in the specified range [from .. to] as printed
 
+  static auto& profiler = FFrameProfiler::getInstance();
+  profiler.addCellsEmitted (to - from + 1);
   auto* ch = &vterm->getFChar(int(from), int(y));
   const auto* end = ch + to - from + 1;
 
@@ -1403,9 +1701,9 @@ inline void FTermOutput::appendChar (FChar& next_char)
     if ( ch != L'\0')
     {
       if ( internal::var::terminal_encoding == Encoding::UTF8 )
-        appendOutputBuffer (unicode_to_utf8(ch));
+        appendOutputBuffer (ch);
       else
-        appendOutputBuffer (std::string(1, char(uChar(ch))));
+        appendOutputBuffer (char(uChar(ch)));
     }
 
     if ( ! combined_char_support )
@@ -1518,38 +1816,191 @@ inline auto FTermOutput::moveCursorLeft() -> CursorMoved
 //----------------------------------------------------------------------
 inline void FTermOutput::checkFreeBufferSize()
 {
-  if ( output_buffer->isFull() )
+  if ( output_buffer.size() >= BUFFER_SIZE )
     flush();
 }
 
 //----------------------------------------------------------------------
 inline void FTermOutput::appendOutputBuffer (const FTermControl& ctrl)
 {
-  output_buffer->emplace(OutputType::Control, ctrl.string);
+  const auto& string = ctrl.string;
+
+  if ( string.find("$<") == std::string::npos )
+    output_buffer.append(string);
+  else  // Padding is only required for strings with a delay
+    padding_controls.push_back({output_buffer.size(), string});
+
   checkFreeBufferSize();
 }
 
 //----------------------------------------------------------------------
 inline void FTermOutput::appendOutputBuffer (const UniChar& ch)
 {
-  appendOutputBuffer(unicode_to_utf8(wchar_t(ch)));
+  appendOutputBuffer (wchar_t(ch));
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutput::appendOutputBuffer (wchar_t ch)
+{
+  // Encodes the character as UTF-8
+
+  if ( ch < 0x80 )
+    output_buffer.push_back(char(ch));
+  else
+    output_buffer.append(unicode_to_utf8(ch));
+
+  checkFreeBufferSize();
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::appendOutputBuffer (char ch)
+{
+  // Appends a single byte of the terminal encoding
+
+  output_buffer.push_back(ch);
+  checkFreeBufferSize();
 }
 
 //----------------------------------------------------------------------
-void FTermOutput::appendOutputBuffer (std::string&& string)
+void FTermOutput::appendOutputBuffer (const std::string& string)
 {
-  auto& last = output_buffer->back();
+  output_buffer.append(string);
+  checkFreeBufferSize();
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::writeOutputBuffer()
+{
+  // Gathers the unwritten rest of the previous output and
+  // the output buffer into a single writev() call
+
+  const auto pending_size = pending_output.size() - pending_offset;
+  std::array<struct iovec, 2> iov{};
+  int iovcnt{0};
+
+  if ( pending_size > 0 )
+  {
+    iov[0] = { &pending_output[pending_offset], pending_size };
+    iovcnt++;
+  }
+
+  iov[std::size_t(iovcnt)] = { &output_buffer[0], output_buffer.size() };
+  iovcnt++;
+  const auto written = writeNonBlocking (iov.data(), iovcnt);
 
-  if ( ! output_buffer->isEmpty() && last.type == OutputType::String )
+  if ( written < pending_size )
   {
-    // Append string data to the back element
-    auto& string_buf = last.data;
-    string_buf.append(string);
+    // Keep the rest of the pending output and the entire output buffer
+    pending_output.erase (0, pending_offset + written);
+    pending_output.append (output_buffer);
   }
   else
   {
-    output_buffer->emplace(OutputType::String, std::move(string));
-    checkFreeBufferSize();
+    // Keep the unwritten rest of the output buffer
+    pending_output.assign (output_buffer, written - pending_size, std::string::npos);
+  }
+
+  pending_offset = 0;
+
+  if ( pending_output.size() > MAX_PENDING_SIZE )
+    waitForPendingOutput();  // The terminal cannot keep up with the output
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::writeNonBlocking (struct iovec* iov, int iovcnt) -> std::size_t
+{
+  // Writes as much data as possible without blocking and returns
+  // the number of bytes written
+
+  static const auto& fsys = FSystem::getInstance();
+  const int fd = getOutputDevice();
+  std::size_t size{0};
+  std::size_t written{0};
+
+  for (int i{0}; i < iovcnt; i++)
+    size += iov[i].iov_len;
+
+  if ( ! non_blocking_output )
+  {
+    // A blocking file descriptor is only written when it is writable
+    struct pollfd fds{fd, POLLOUT, 0};
+
+    if ( poll(&fds, 1, 0) <= 0 )
+      return 0;
+  }
+
+  while ( written < size )
+  {
+    const auto ret = fsys->writev(fd, iov, iovcnt);
+
+    if ( ret < 0 && errno == EINTR )
+      continue;
+
+    if ( ret < 0 && errno != EAGAIN && errno != EWOULDBLOCK )
+      written = size;  // Discard the output on write errors
+
+    if ( ret <= 0 )
+      break;
+
+    auto count = std::size_t(ret);
+    written += count;
+
+    // Skip the completely written iovec elements
+    while ( iovcnt > 0 && count >= iov->iov_len )
+    {
+      count -= iov->iov_len;
+      ++iov;
+      --iovcnt;
+    }
+
+    if ( iovcnt > 0 )
+    {
+      iov->iov_base = static_cast<char*>(iov->iov_base) + count;
+      iov->iov_len -= count;
+    }
+  }
+
+  return written;
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::putStdioChar (int ch) -> int
+{
+  // Unwritten non-blocking output must reach the terminal first
+  if ( active_term_output )
+    active_term_output->waitForPendingOutput();
+
+  static const auto& fsys = FSystem::getInstance();
+  return fsys->putchar(ch);
+}
+
+//----------------------------------------------------------------------
+auto FTermOutput::putStdioString (const std::string& string) -> int
+{
+  if ( active_term_output )
+    active_term_output->waitForPendingOutput();
+
+  static const auto& fsys = FSystem::getInstance();
+  return fsys->fputs(string.c_str(), stdout);
+}
+
+//----------------------------------------------------------------------
+void FTermOutput::waitForPendingOutput()
+{
+  // Blocks until all pending output has been written
+
+  while ( hasPendingOutput() )
+  {
+    struct pollfd fds{getOutputDevice(), POLLOUT, 0};
+
+    if ( poll(&fds, 1, -1) < 0 && errno != EINTR )
+    {
+      pending_output.clear();
+      pending_offset = 0;
+      return;
+    }
+
+    flushPendingOutput();
   }
 }
 
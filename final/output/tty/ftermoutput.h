@@ -44,8 +44,10 @@
 #include <string>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include "final/output/foutput.h"
+#include "final/output/tty/fframepacer.h"
 #include "final/output/tty/fterm.h"
 
 namespace finalcut
@@ -54,14 +56,12 @@ namespace finalcut
 // class forward declaration
 class FStartOptions;
 class FTermData;
-template <typename T, std::size_t Capacity>
-class FRingBuffer;
 
 //----------------------------------------------------------------------
 // class FTermOutput
 //----------------------------------------------------------------------
 
-class FTermOutput final : public FOutput
+class FTermOutput : public FOutput
 {
   public:
     // Constructor
@@ -81,6 +81,9 @@ class FTermOutput final : public FOutput
     auto getMaxColor() const -> int override;
     auto getEncoding() const -> Encoding override;
     auto getKeyName (FKey) const -> FString override;
+    auto getFlushDeadline() const -> TimeValue override;
+    auto getFramePacing() const -> FramePacing override;
+    auto getFramePacer() const & -> const FFramePacer&;
 
     // Mutators
     void setCursor (FPoint) override;
@@ -91,6 +94,8 @@ class FTermOutput final : public FOutput
     auto setVGAFont() -> bool override;
     auto setNewFont() -> bool override;
     void setNonBlockingRead (bool = true) override;
+    void setFramePacing (FramePacing) override;
+    void setTargetFrameRate (uInt) override;
 
     // Inquiries
     auto isCursorHideable() const -> bool override;
@@ -104,6 +109,7 @@ class FTermOutput final : public FOutput
     auto hasHalfBlockCharacter() const -> bool override;
     auto hasShadowCharacter() const -> bool override;
     auto areMetaAndArrowKeysSupported() const -> bool override;
+    auto hasPendingOutput() const -> bool override;
 
     // Methods
     void initTerminal (FVTerm::FTermArea*) override;
@@ -118,6 +124,8 @@ class FTermOutput final : public FOutput
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
     void flush() override;
+    void flushPendingOutput() override;
+    void measureOutputBacklog() override;
     void beep() const override;
 
   private:
@@ -143,48 +151,41 @@ class FTermOutput final : public FOutput
       NotOptimized
     };
 
-    enum class OutputType : uInt8  // Output data type of the terminal
-    {
-      String,
-      Control
-    };
-
     enum class CursorMoved { No, Yes };
 
-    struct OutputData
+    struct PaddingControl  // Control string with a delay ($<..>)
     {
-      OutputData() = default;
-
-      OutputData (OutputType t, std::string s)
-        : type{t}
-        , data{std::move(s)}
-      { }
-
-      OutputType  type{OutputType::String};
+      std::size_t position{};  // Output buffer position
       std::string data{};
     };
 
     // Constants
-    //   Upper and lower flush limit
-    static constexpr uInt64 MIN_FLUSH_WAIT = 16'667;   //  16.6 ms = 60 Hz
-    static constexpr uInt64 MAX_FLUSH_WAIT = 200'000;  // 200.0 ms = 5 Hz
     //   Output buffer size
-    static constexpr std::size_t BUFFER_SIZE = 32'768;  // 32 KB
+    static constexpr std::size_t BUFFER_SIZE = 65'536;  // 64 KB
+    //   Maximum amount of unwritten output before waiting for the terminal
+    static constexpr std::size_t MAX_PENDING_SIZE = 262'144;  // 256 KB
 
     // Using-declaration
-    using OutputBuffer = FRingBuffer<OutputData, BUFFER_SIZE>;
+    using OutputBuffer = std::string;
+    using PaddingControls = std::vector<PaddingControl>;
 
     // Accessors
     auto getFSetPaletteRef() const & -> const FSetPalette& override;
 
     // Methods
     auto getStartOptions() & -> FStartOptions&;
+    virtual auto getOutputBacklog() const -> std::size_t;
     auto isInputCursorInsideTerminal() const -> bool;
     auto isDefaultPaletteTheme() const -> bool override;
     void redefineColorPalette() override;
     void restoreColorPalette() override;
+    virtual void initTerminalDevice();
+    void openOutputDevice();
+    void closeOutputDevice();
+    auto getOutputDevice() const noexcept -> int;
     void init_characterLengths();
     void init_combined_character();
+    void init_synchronized_output();
     auto canClearToEOL (uInt, uInt) const -> bool;
     auto canClearLeadingWS (uInt&, uInt) const -> bool;
     auto canClearTrailingWS (uInt&, uInt) const -> bool;
@@ -207,9 +208,13 @@ class FTermOutput final : public FOutput
     auto isFullWidthPaddingChar (const FChar&) const -> bool;
     void cursorWrap() const;
     void adjustCursorPosition (FPoint&) const;
+    void beginSynchronizedUpdate();
+    void endSynchronizedUpdate (bool);
+    auto scrollChangedLines() -> bool;
+    auto getScrollRegionString (const FVTerm::FLineShift&) const -> std::string;
+    auto getInsertDeleteLineString (const FVTerm::FLineShift&) const -> std::string;
     auto updateTerminalLine (uInt) -> bool;
     auto updateTerminalCursor() -> bool;
-    void flushTimeAdjustment();
     void markAsPrinted (uInt, uInt) const;
     void markAsPrinted (uInt, uInt, uInt) const;
     void newFontChanges (FChar&) const;
@@ -224,26 +229,38 @@ class FTermOutput final : public FOutput
     void checkFreeBufferSize();
     void appendOutputBuffer (const FTermControl&);
     void appendOutputBuffer (const UniChar&);
-    void appendOutputBuffer (std::string&&);
+    void appendOutputBuffer (wchar_t);
+    void appendOutputBuffer (char);
+    void appendOutputBuffer (const std::string&);
+    void writeOutputBuffer();
+    virtual auto writeNonBlocking (struct iovec*, int) -> std::size_t;
+    static auto putStdioChar (int) -> int;
+    static auto putStdioString (const std::string&) -> int;
+    void waitForPendingOutput();
 
     // Data members
     FTerm                         fterm{};
     static FVTerm::FTermArea*     vterm;
     static FTermData*             fterm_data;
-    std::shared_ptr<OutputBuffer> output_buffer{};
+    static FTermOutput*           active_term_output;
+    OutputBuffer                  output_buffer{};
+    PaddingControls               padding_controls{};
+    std::string                   pending_output{};  // unwritten output
+    std::size_t                   pending_offset{0};  // write position
+    int                           output_fd{-1};  // terminal output
+    bool                          non_blocking_output{false};
     std::shared_ptr<FPoint>       term_pos{};  // terminal cursor position
-    TimeValue                     time_last_flush{};
+    FFramePacer                   frame_pacer{};
     FChar                         term_attribute{};
     bool                          cursor_hideable{false};
     bool                          combined_char_support{false};
+    bool                          synchronized_output{false};
+    std::size_t                   sync_update_start{0};
     uInt                          erase_char_length{};
     uInt                          repeat_char_length{};
     uInt                          clr_bol_length{};
     uInt                          clr_eol_length{};
     uInt                          cursor_address_length{};
-    uInt64                        flush_wait{MIN_FLUSH_WAIT};
-    uInt64                        flush_average{MIN_FLUSH_WAIT};
-    uInt64                        flush_median{MIN_FLUSH_WAIT};
 };
 
 // FTermOutput inline functions
@@ -255,6 +272,22 @@ inline auto FTermOutput::getClassName() const -> FString
 inline auto FTermOutput::getFTerm() & -> FTerm&
 { return fterm; }
 
+//----------------------------------------------------------------------
+inline auto FTermOutput::getFramePacing() const -> FramePacing
+{ return frame_pacer.getPacing(); }
+
+//----------------------------------------------------------------------
+inline auto FTermOutput::getFramePacer() const & -> const FFramePacer&
+{ return frame_pacer; }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::setFramePacing (FramePacing pacing)
+{ frame_pacer.setPacing(pacing); }
+
+//----------------------------------------------------------------------
+inline void FTermOutput::setTargetFrameRate (uInt rate)
+{ frame_pacer.setTargetFrameRate(rate); }
+
 //----------------------------------------------------------------------
 inline void FTermOutput::showCursor()
 { return hideCursor(false); }
@@ -263,6 +296,10 @@ inline void FTermOutput::showCursor()
 inline auto FTermOutput::isCursorHideable() const -> bool
 { return cursor_hideable; }
 
+//----------------------------------------------------------------------
+inline auto FTermOutput::hasPendingOutput() const -> bool
+{ return pending_offset < pending_output.size(); }
+
 //----------------------------------------------------------------------
 inline auto FTermOutput::getFSetPaletteRef() const & -> const FSetPalette&
 {
@@ -170,6 +170,17 @@ void FTermXTerminal::setFocusSupport (bool enable)
     disableXTermFocus();
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::setBracketedPaste (bool enable)
+{
+  // activate/deactivate the bracketed paste mode
+
+  if ( enable )
+    enableXTermBracketedPaste();
+  else
+    disableXTermBracketedPaste();
+}
+
 //----------------------------------------------------------------------
 void FTermXTerminal::metaSendsESC (bool enable)
 {
@@ -962,6 +973,32 @@ void FTermXTerminal::disableXTermFocus()
   focus_support = false;
 }
 
+//----------------------------------------------------------------------
+void FTermXTerminal::enableXTermBracketedPaste()
+{
+  // Activate the bracketed paste mode
+
+  if ( bracketed_paste )
+    return;  // The bracketed paste mode is already activated
+
+  FTerm::paddingPrint (CSI "?2004h");  // enable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste = true;
+}
+
+//----------------------------------------------------------------------
+void FTermXTerminal::disableXTermBracketedPaste()
+{
+  // Deactivate the bracketed paste mode
+
+  if ( ! bracketed_paste )
+    return;  // The bracketed paste mode was already deactivated
+
+  FTerm::paddingPrint (CSI "?2004l");  // disable bracketed paste
+  std::fflush(stdout);
+  bracketed_paste = false;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermXTerminal::canUseXTermMetaSendsESC() const -> bool
 {
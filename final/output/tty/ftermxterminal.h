@@ -69,6 +69,8 @@ class FTermXTerminal final
     void  unsetMouseSupport();
     void  setFocusSupport (bool enable = true);
     void  unsetFocusSupport();
+    void  setBracketedPaste (bool enable = true);
+    void  unsetBracketedPaste();
     void  metaSendsESC (bool = true);
 
     // Accessors
@@ -152,6 +154,8 @@ class FTermXTerminal final
     void  disableXTermMouse();
     void  enableXTermFocus();
     void  disableXTermFocus();
+    void  enableXTermBracketedPaste();
+    void  disableXTermBracketedPaste();
     auto  canUseXTermMetaSendsESC() const -> bool;
     void  enableXTermMetaSendsESC();
     void  disableXTermMetaSendsESC();
@@ -159,6 +163,7 @@ class FTermXTerminal final
     // Data members
     bool              mouse_support{false};
     bool              focus_support{false};
+    bool              bracketed_paste{false};
     bool              meta_sends_esc{false};
     bool              xterm_default_colors{false};
     bool              title_was_changed{false};
@@ -237,6 +242,10 @@ inline void FTermXTerminal::unsetMouseSupport()
 inline void FTermXTerminal::unsetFocusSupport()
 { setFocusSupport (false); }
 
+//----------------------------------------------------------------------
+inline void FTermXTerminal::unsetBracketedPaste()
+{ setBracketedPaste (false); }
+
 }  // namespace finalcut
 
 #endif  // FTERMXTERMINAL_H
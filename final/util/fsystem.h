@@ -45,6 +45,7 @@
 #include "final/ftypes.h"
 
 // struct forward declaration
+struct iovec;
 struct kevent;
 
 namespace finalcut
@@ -78,6 +79,7 @@ class FSystem
     virtual auto fclose (FILE*) -> int = 0;
     virtual auto fputs (const char*, FILE*) -> int = 0;
     virtual auto putchar (int) -> int = 0;
+    virtual auto writev (int, const struct iovec*, int) -> ssize_t = 0;
     virtual auto sigaction ( int, const struct sigaction*
                            , struct sigaction* ) -> int = 0;
     virtual auto timer_create ( clockid_t, struct sigevent*
@@ -60,6 +60,7 @@
 #include <sys/ioctl.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 
 #include <cstdarg>
 #include <fcntl.h>
@@ -167,6 +168,12 @@ class FSystemImpl : public FSystem
 #endif
     }
 
+    inline auto writev ( int file_descriptor, const struct iovec* iov
+                       , int iovcnt ) -> ssize_t override
+    {
+      return ::writev (file_descriptor, iov, iovcnt);
+    }
+
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction* ) -> int override;
     auto timer_create ( clockid_t, struct sigevent*
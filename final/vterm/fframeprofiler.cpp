@@ -0,0 +1,220 @@
+/***********************************************************************
+* fframeprofiler.cpp - Timing statistics of the render pipeline        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+#include "final/util/flog.h"
+#include "final/vterm/fframeprofiler.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// struct FFrameProfiler::FrameRecord
+//----------------------------------------------------------------------
+
+auto FFrameProfiler::FrameRecord::getTotalTime() const noexcept -> Duration
+{
+  return std::accumulate (phase_time.cbegin(), phase_time.cend(), Duration{});
+}
+
+
+//----------------------------------------------------------------------
+// class FFrameProfiler
+//----------------------------------------------------------------------
+
+// public methods of FFrameProfiler
+//----------------------------------------------------------------------
+auto FFrameProfiler::getInstance() -> FFrameProfiler&
+{
+  static const auto& profiler = std::make_unique<FFrameProfiler>();
+  return *profiler;
+}
+
+//----------------------------------------------------------------------
+auto FFrameProfiler::getFrame (std::size_t n) const -> const FrameRecord&
+{
+  // Returns the n-th most recent frame (0 = last finished frame)
+
+  if ( n >= frame_count )
+    throw std::out_of_range{"Frame index out of range"};
+
+  return frames[(next_index + capacity - 1 - n) % capacity];
+}
+
+//----------------------------------------------------------------------
+auto FFrameProfiler::getFrames() const -> std::vector<FrameRecord>
+{
+  // Returns all stored frames from the oldest to the most recent
+
+  std::vector<FrameRecord> list{};
+  list.reserve(frame_count);
+
+  for (auto n{frame_count}; n > 0; n--)
+    list.push_back(getFrame(n - 1));
+
+  return list;
+}
+
+//----------------------------------------------------------------------
+void FFrameProfiler::setCapacity (std::size_t size)
+{
+  // Changes the number of stored frames and keeps the newest ones
+
+  if ( size == 0 )
+    throw std::invalid_argument{"The capacity must be at least one frame"};
+
+  auto list = getFrames();
+
+  if ( list.size() > size )
+    list.erase(list.begin(), list.end() - std::ptrdiff_t(size));
+
+  capacity = size;
+  frame_count = list.size();
+  next_index = frame_count % capacity;
+  frames = std::move(list);
+
+  if ( enabled )
+    frames.resize(capacity);
+}
+
+//----------------------------------------------------------------------
+void FFrameProfiler::enable (bool enable)
+{
+  if ( enabled == enable )
+    return;
+
+  enabled = enable;
+  current = FrameRecord{};
+  active_phase = Phase::None;
+
+  if ( enabled )
+    frames.resize(capacity);
+}
+
+//----------------------------------------------------------------------
+void FFrameProfiler::clear()
+{
+  frames.assign(enabled ? capacity : 0, FrameRecord{});
+  next_index = 0;
+  frame_count = 0;
+  current = FrameRecord{};
+}
+
+//----------------------------------------------------------------------
+void FFrameProfiler::finishFrame()
+{
+  // Completes the current frame and stores it in the frame ring
+
+  if ( ! enabled )
+  {
+    current = FrameRecord{};
+    return;
+  }
+
+  // The rest of a running phase belongs to the next frame
+  chargeActivePhase (Clock::now());
+
+  if ( hasFrameActivity() )
+  {
+    frame_number++;
+    current.frame = frame_number;
+    current.end_time = TimeValue::clock::now();
+    frames[next_index] = current;
+    next_index = (next_index + 1) % capacity;
+    frame_count = std::min(frame_count + 1, capacity);
+
+    if ( logging )
+      logFrame (current);
+  }
+
+  current = FrameRecord{};
+}
+
+
+// private methods of FFrameProfiler
+//----------------------------------------------------------------------
+auto FFrameProfiler::enterPhase (Phase phase) -> Phase
+{
+  // A nested phase pauses the time measurement of the outer phase
+
+  chargeActivePhase (Clock::now());
+  const auto previous = active_phase;
+  active_phase = phase;
+  return previous;
+}
+
+//----------------------------------------------------------------------
+void FFrameProfiler::leavePhase (Phase previous)
+{
+  chargeActivePhase (Clock::now());
+  active_phase = previous;
+}
+
+//----------------------------------------------------------------------
+inline void FFrameProfiler::chargeActivePhase (Clock::time_point now)
+{
+  if ( active_phase < Phase::None )
+  {
+    auto& phase_time = current.phase_time[std::size_t(active_phase)];
+    phase_time += std::chrono::duration_cast<Duration>(now - phase_start);
+  }
+
+  phase_start = now;
+}
+
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::hasFrameActivity() const noexcept -> bool
+{
+  return current.getTime(Phase::Draw) > Duration{}
+      || current.cells_emitted > 0
+      || current.bytes_written > 0;
+}
+
+//----------------------------------------------------------------------
+void FFrameProfiler::logFrame (const FrameRecord& record) const
+{
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  const auto usec = [&record] (Phase phase)
+  {
+    return duration_cast<microseconds>(record.getTime(phase)).count();
+  };
+
+  std::clog << FLog::LogLevel::Info
+            << "Frame " << record.frame
+            << ": draw " << usec(Phase::Draw) << " us"
+            << ", compose " << usec(Phase::Compose) << " us"
+            << ", diff " << usec(Phase::Diff) << " us"
+            << ", encode " << usec(Phase::Encode) << " us"
+            << ", flush " << usec(Phase::Flush) << " us"
+            << ", compared " << record.cells_compared << " cells"
+            << ", emitted " << record.cells_emitted << " cells"
+            << ", written " << record.bytes_written << " bytes"
+            << std::endl;
+}
+
+}  // namespace finalcut
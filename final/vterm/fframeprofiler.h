@@ -0,0 +1,254 @@
+/***********************************************************************
+* fframeprofiler.h - Timing statistics of the render pipeline          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FFrameProfiler ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The frame profiler measures the time of each render phase and
+ *  counts the processed cells and written bytes. A frame ends with
+ *  every FVTerm::flush() call. Frames without drawing and without
+ *  terminal output are discarded. The profiler is disabled by
+ *  default and only costs a flag test per phase in this state.
+ *
+ *  Usage:
+ *    auto& profiler = finalcut::FFrameProfiler::getInstance();
+ *    profiler.enable();
+ *    ...
+ *    const auto& last = profiler.getFrame(0);  // Most recent frame
+ */
+
+#ifndef FFRAMEPROFILER_H
+#define FFRAMEPROFILER_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <array>
+#include <chrono>
+#include <vector>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FFrameProfiler
+//----------------------------------------------------------------------
+
+class FFrameProfiler final
+{
+  public:
+    // Enumeration
+    enum class Phase : uInt8
+    {
+      Draw,     // Widget drawing
+      Compose,  // Compositing of the virtual terminal (updateVTerm)
+      Diff,     // Comparison with the terminal content (updateTerminal)
+      Encode,   // Output of the changed lines and the cursor
+      Flush,    // Writing the output buffer
+      None      // No active phase
+    };
+
+    // Constant
+    static constexpr std::size_t PHASE_COUNT{std::size_t(Phase::None)};
+
+    // Using-declarations
+    using Duration = std::chrono::nanoseconds;
+
+    struct FrameRecord
+    {
+      // Accessors
+      auto getTime (Phase) const noexcept -> Duration;
+      auto getTotalTime() const noexcept -> Duration;
+
+      // Data members
+      uInt64 frame{0};           // Sequential frame number
+      TimeValue end_time{};      // Time of the final flush
+      std::array<Duration, PHASE_COUNT> phase_time{};
+      uInt64 cells_compared{0};  // Cells compared with the terminal
+      uInt64 cells_emitted{0};   // Cells written to the terminal
+      uInt64 bytes_written{0};   // Bytes passed to the terminal
+    };
+
+    class ScopedPhase final
+    {
+      public:
+        // Constructor
+        explicit ScopedPhase (Phase);
+
+        // Disable copy constructor
+        ScopedPhase (const ScopedPhase&) = delete;
+
+        // Destructor
+        ~ScopedPhase() noexcept;
+
+        // Disable copy assignment operator (=)
+        auto operator = (const ScopedPhase&) -> ScopedPhase& = delete;
+
+      private:
+        // Data members
+        bool  active{false};
+        Phase previous{Phase::None};
+    };
+
+    // Constant
+    static constexpr std::size_t DEFAULT_CAPACITY{128};
+
+    // Constructor
+    FFrameProfiler() = default;
+
+    // Accessors
+    static auto getClassName() -> FString;
+    static auto getInstance() -> FFrameProfiler&;
+    auto getCapacity() const noexcept -> std::size_t;
+    auto getFrameCount() const noexcept -> std::size_t;
+    auto getFrame (std::size_t) const -> const FrameRecord&;
+    auto getFrames() const -> std::vector<FrameRecord>;
+    auto getCurrentFrame() const noexcept -> const FrameRecord&;
+
+    // Mutators
+    void setCapacity (std::size_t);
+    void enable (bool = true);
+    void disable();
+    void setLogging (bool = true) noexcept;
+    void unsetLogging() noexcept;
+
+    // Inquiries
+    auto isEnabled() const noexcept -> bool;
+    auto isLogging() const noexcept -> bool;
+
+    // Methods
+    void clear();
+    void addCellsCompared (uInt64) noexcept;
+    void addCellsEmitted (uInt64) noexcept;
+    void addBytesWritten (uInt64) noexcept;
+    void finishFrame();
+
+  private:
+    // Using-declaration
+    using Clock = std::chrono::steady_clock;
+
+    // Methods
+    auto enterPhase (Phase) -> Phase;
+    void leavePhase (Phase);
+    void chargeActivePhase (Clock::time_point);
+    auto hasFrameActivity() const noexcept -> bool;
+    void logFrame (const FrameRecord&) const;
+
+    // Data members
+    std::vector<FrameRecord> frames{};
+    std::size_t       next_index{0};
+    std::size_t       frame_count{0};
+    std::size_t       capacity{DEFAULT_CAPACITY};
+    FrameRecord       current{};
+    uInt64            frame_number{0};
+    Clock::time_point phase_start{};
+    Phase             active_phase{Phase::None};
+    bool              enabled{false};
+    bool              logging{false};
+};
+
+// FFrameProfiler inline functions
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::getClassName() -> FString
+{ return "FFrameProfiler"; }
+
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::getCapacity() const noexcept -> std::size_t
+{ return capacity; }
+
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::getFrameCount() const noexcept -> std::size_t
+{ return frame_count; }
+
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::getCurrentFrame() const noexcept -> const FrameRecord&
+{ return current; }
+
+//----------------------------------------------------------------------
+inline void FFrameProfiler::disable()
+{ enable(false); }
+
+//----------------------------------------------------------------------
+inline void FFrameProfiler::setLogging (bool enable) noexcept
+{ logging = enable; }
+
+//----------------------------------------------------------------------
+inline void FFrameProfiler::unsetLogging() noexcept
+{ setLogging(false); }
+
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::isEnabled() const noexcept -> bool
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::isLogging() const noexcept -> bool
+{ return logging; }
+
+//----------------------------------------------------------------------
+inline void FFrameProfiler::addCellsCompared (uInt64 n) noexcept
+{ current.cells_compared += n; }
+
+//----------------------------------------------------------------------
+inline void FFrameProfiler::addCellsEmitted (uInt64 n) noexcept
+{ current.cells_emitted += n; }
+
+//----------------------------------------------------------------------
+inline void FFrameProfiler::addBytesWritten (uInt64 n) noexcept
+{ current.bytes_written += n; }
+
+//----------------------------------------------------------------------
+inline FFrameProfiler::ScopedPhase::ScopedPhase (Phase phase)
+{
+  static auto& profiler = FFrameProfiler::getInstance();
+
+  if ( ! profiler.isEnabled() )
+    return;
+
+  active = true;
+  previous = profiler.enterPhase(phase);
+}
+
+//----------------------------------------------------------------------
+inline FFrameProfiler::ScopedPhase::~ScopedPhase() noexcept  // destructor
+{
+  if ( active )
+    FFrameProfiler::getInstance().leavePhase(previous);
+}
+
+//----------------------------------------------------------------------
+inline auto FFrameProfiler::FrameRecord::getTime (Phase phase) const noexcept -> Duration
+{
+  return ( phase < Phase::None ) ? phase_time[std::size_t(phase)] : Duration{};
+}
+
+}  // namespace finalcut
+
+#endif  // FFRAMEPROFILER_H
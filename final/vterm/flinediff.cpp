@@ -0,0 +1,460 @@
+/***********************************************************************
+* flinediff.cpp - Fast comparison of virtual terminal lines            *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <cstddef>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) \
+    && __SIZEOF_WCHAR_T__ == 4
+  #define USE_X86_LINE_DIFF_KERNELS
+  #include <immintrin.h>
+#endif
+
+#include "final/ftypes.h"
+#include "final/vterm/flinediff.h"
+#include "final/vterm/fvterm.h"
+
+namespace finalcut
+{
+
+namespace internal
+{
+
+using FCellPlanes = FVTerm::FCellPlanes;
+using FindDifferenceFunction = std::size_t (*) ( const FChar*, const FCellPlanes&
+                                               , std::size_t, std::size_t );
+using CountUnchangedFunction = std::size_t (*) (const FChar*, std::size_t);
+
+struct LineDiffFunctions
+{
+  LineDiffKernel         kernel;
+  FindDifferenceFunction find_first;
+  FindDifferenceFunction find_last;
+  CountUnchangedFunction count_unchanged;
+};
+
+constexpr auto getNoChangesMask() -> uInt32
+{
+  FCharAttribute mask{};
+  mask.no_changes = true;
+  return FCharAttribute_to_uInt32(mask);
+}
+
+constexpr uInt32 no_changes_mask = getNoChangesMask();
+
+// Scalar kernel
+//----------------------------------------------------------------------
+auto findFirstDifferenceScalar ( const FChar* cells, const FCellPlanes& planes
+                               , std::size_t index, std::size_t length ) -> std::size_t
+{
+  for (std::size_t i{0}; i < length; i++)
+    if ( ! planes.isEqual(index + i, cells[i]) )
+      return i;
+
+  return length;
+}
+
+//----------------------------------------------------------------------
+auto findLastDifferenceScalar ( const FChar* cells, const FCellPlanes& planes
+                              , std::size_t index, std::size_t length ) -> std::size_t
+{
+  auto i = length;
+
+  while ( i > 0 )
+  {
+    --i;
+
+    if ( ! planes.isEqual(index + i, cells[i]) )
+      return i;
+  }
+
+  return length;
+}
+
+//----------------------------------------------------------------------
+auto countUnchangedCellsScalar (const FChar* cells, std::size_t length) -> std::size_t
+{
+  std::size_t i{0};
+
+  while ( i < length && cells[i].attr.bit.no_changes )
+    i++;
+
+  return i;
+}
+
+#if defined(USE_X86_LINE_DIFF_KERNELS)
+
+// Word offsets within an FChar
+constexpr int ch_offset = int(offsetof(FChar, ch) / sizeof(uInt32));
+constexpr int color_offset = int(offsetof(FChar, color) / sizeof(uInt32));
+constexpr int attr_offset = int(offsetof(FChar, attr) / sizeof(uInt32));
+constexpr int fchar_words = int(sizeof(FChar) / sizeof(uInt32));
+
+static_assert ( sizeof(FChar) == 3 * sizeof(__m128i)
+              , "The SSE2 kernel expects 48-byte FChar cells" );
+static_assert ( ch_offset == 0 && color_offset == 10 && attr_offset == 11
+              , "The SSE2 kernel expects the color and attribute "
+                "words at the end of an FChar cell" );
+
+// SSE2 kernel
+//----------------------------------------------------------------------
+__attribute__((target("sse2")))
+inline auto loadPlane (const FCellPlanes::FCodeVec& plane, std::size_t index) -> __m128i
+{
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(&plane[index]));
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("sse2")))
+inline auto compareCellsSSE2 ( const FChar* cells, const FCellPlanes& planes
+                             , std::size_t index ) -> unsigned
+{
+  // Returns a bit mask of the 4 cells that may differ
+
+  const auto* vec = reinterpret_cast<const __m128i*>(cells);
+  // Transpose ch[0] and ch[1] of the 4 cells
+  const auto ch_ab = _mm_unpacklo_epi32 ( _mm_loadu_si128(vec)
+                                        , _mm_loadu_si128(vec + 3) );
+  const auto ch_cd = _mm_unpacklo_epi32 ( _mm_loadu_si128(vec + 6)
+                                        , _mm_loadu_si128(vec + 9) );
+  const auto ch0 = _mm_unpacklo_epi64(ch_ab, ch_cd);
+  const auto ch1 = _mm_unpackhi_epi64(ch_ab, ch_cd);
+  // Transpose color and attr of the 4 cells
+  const auto tail_ab = _mm_unpackhi_epi32 ( _mm_loadu_si128(vec + 2)
+                                          , _mm_loadu_si128(vec + 5) );
+  const auto tail_cd = _mm_unpackhi_epi32 ( _mm_loadu_si128(vec + 8)
+                                          , _mm_loadu_si128(vec + 11) );
+  const auto color = _mm_unpacklo_epi64(tail_ab, tail_cd);
+  const auto attr = _mm_unpackhi_epi64(tail_ab, tail_cd);
+  const auto mask = _mm_set1_epi32(int(getCompareBitMask()));
+
+  auto equal = _mm_and_si128 ( _mm_cmpeq_epi32(ch0, loadPlane(planes.code, index))
+                             , _mm_cmpeq_epi32(ch1, _mm_setzero_si128()) );
+  equal = _mm_and_si128 ( equal
+                        , _mm_cmpeq_epi32(color, loadPlane(planes.color, index)) );
+  equal = _mm_and_si128 ( equal
+                        , _mm_cmpeq_epi32 ( _mm_and_si128(attr, mask)
+                                          , _mm_and_si128(loadPlane(planes.attr, index), mask) ) );
+  return ~unsigned(_mm_movemask_ps(_mm_castsi128_ps(equal))) & 0xfU;
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("sse2")))
+auto findFirstDifferenceSSE2 ( const FChar* cells, const FCellPlanes& planes
+                             , std::size_t index, std::size_t length ) -> std::size_t
+{
+  std::size_t i{0};
+
+  for (; i + 4 <= length; i += 4)
+  {
+    auto diff = compareCellsSSE2 (cells + i, planes, index + i);
+
+    while ( diff )  // Combining characters are compared in the side table
+    {
+      const auto lane = std::size_t(__builtin_ctz(diff));
+
+      if ( ! planes.isEqual(index + i + lane, cells[i + lane]) )
+        return i + lane;
+
+      diff &= diff - 1;
+    }
+  }
+
+  const auto rest = findFirstDifferenceScalar ( cells + i, planes
+                                              , index + i, length - i );
+  return i + rest;
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("sse2")))
+auto findLastDifferenceSSE2 ( const FChar* cells, const FCellPlanes& planes
+                            , std::size_t index, std::size_t length ) -> std::size_t
+{
+  auto i = length;
+
+  while ( i >= 4 )
+  {
+    i -= 4;
+    auto diff = compareCellsSSE2 (cells + i, planes, index + i);
+
+    while ( diff )
+    {
+      const auto lane = std::size_t(31 - __builtin_clz(diff));
+
+      if ( ! planes.isEqual(index + i + lane, cells[i + lane]) )
+        return i + lane;
+
+      diff &= ~(1U << lane);
+    }
+  }
+
+  const auto rest = findLastDifferenceScalar (cells, planes, index, i);
+  return ( rest == i ) ? length : rest;
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("sse2")))
+auto countUnchangedCellsSSE2 (const FChar* cells, std::size_t length) -> std::size_t
+{
+  const auto mask = _mm_set1_epi32(int(no_changes_mask));
+  std::size_t i{0};
+
+  for (; i + 4 <= length; i += 4)
+  {
+    const auto* vec = reinterpret_cast<const __m128i*>(cells + i);
+    const auto tail_ab = _mm_unpackhi_epi32 ( _mm_loadu_si128(vec + 2)
+                                            , _mm_loadu_si128(vec + 5) );
+    const auto tail_cd = _mm_unpackhi_epi32 ( _mm_loadu_si128(vec + 8)
+                                            , _mm_loadu_si128(vec + 11) );
+    const auto attr = _mm_unpackhi_epi64(tail_ab, tail_cd);
+    const auto unchanged = _mm_cmpeq_epi32(_mm_and_si128(attr, mask), mask);
+    const auto bits = unsigned(_mm_movemask_ps(_mm_castsi128_ps(unchanged)));
+
+    if ( bits != 0xfU )
+      return i + std::size_t(__builtin_ctz(~bits));
+  }
+
+  return i + countUnchangedCellsScalar (cells + i, length - i);
+}
+
+// AVX2 kernel
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline auto gatherWords (const FChar* cells, int offset) -> __m256i
+{
+  const auto indices = _mm256_setr_epi32 ( 0 * fchar_words, 1 * fchar_words
+                                         , 2 * fchar_words, 3 * fchar_words
+                                         , 4 * fchar_words, 5 * fchar_words
+                                         , 6 * fchar_words, 7 * fchar_words );
+  const auto* base = reinterpret_cast<const int*>(cells) + offset;
+  return _mm256_i32gather_epi32(base, indices, sizeof(uInt32));
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline auto loadPlane256 (const FCellPlanes::FCodeVec& plane, std::size_t index) -> __m256i
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&plane[index]));
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+inline auto compareCellsAVX2 ( const FChar* cells, const FCellPlanes& planes
+                             , std::size_t index ) -> unsigned
+{
+  // Returns a bit mask of the 8 cells that may differ
+
+  const auto mask = _mm256_set1_epi32(int(getCompareBitMask()));
+  const auto attr = _mm256_and_si256(gatherWords(cells, attr_offset), mask);
+  const auto old_attr = _mm256_and_si256(loadPlane256(planes.attr, index), mask);
+
+  auto equal = _mm256_and_si256 ( _mm256_cmpeq_epi32 ( gatherWords(cells, ch_offset)
+                                                     , loadPlane256(planes.code, index) )
+                                , _mm256_cmpeq_epi32 ( gatherWords(cells, ch_offset + 1)
+                                                     , _mm256_setzero_si256() ) );
+  equal = _mm256_and_si256 ( equal
+                           , _mm256_cmpeq_epi32 ( gatherWords(cells, color_offset)
+                                                , loadPlane256(planes.color, index) ) );
+  equal = _mm256_and_si256 (equal, _mm256_cmpeq_epi32(attr, old_attr));
+  return ~unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(equal))) & 0xffU;
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+auto findFirstDifferenceAVX2 ( const FChar* cells, const FCellPlanes& planes
+                             , std::size_t index, std::size_t length ) -> std::size_t
+{
+  std::size_t i{0};
+
+  for (; i + 8 <= length; i += 8)
+  {
+    auto diff = compareCellsAVX2 (cells + i, planes, index + i);
+
+    while ( diff )  // Combining characters are compared in the side table
+    {
+      const auto lane = std::size_t(__builtin_ctz(diff));
+
+      if ( ! planes.isEqual(index + i + lane, cells[i + lane]) )
+        return i + lane;
+
+      diff &= diff - 1;
+    }
+  }
+
+  const auto rest = findFirstDifferenceSSE2 ( cells + i, planes
+                                            , index + i, length - i );
+  return i + rest;
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+auto findLastDifferenceAVX2 ( const FChar* cells, const FCellPlanes& planes
+                            , std::size_t index, std::size_t length ) -> std::size_t
+{
+  auto i = length;
+
+  while ( i >= 8 )
+  {
+    i -= 8;
+    auto diff = compareCellsAVX2 (cells + i, planes, index + i);
+
+    while ( diff )
+    {
+      const auto lane = std::size_t(31 - __builtin_clz(diff));
+
+      if ( ! planes.isEqual(index + i + lane, cells[i + lane]) )
+        return i + lane;
+
+      diff &= ~(1U << lane);
+    }
+  }
+
+  const auto rest = findLastDifferenceSSE2 (cells, planes, index, i);
+  return ( rest == i ) ? length : rest;
+}
+
+//----------------------------------------------------------------------
+__attribute__((target("avx2")))
+auto countUnchangedCellsAVX2 (const FChar* cells, std::size_t length) -> std::size_t
+{
+  const auto mask = _mm256_set1_epi32(int(no_changes_mask));
+  std::size_t i{0};
+
+  for (; i + 8 <= length; i += 8)
+  {
+    const auto attr = gatherWords(cells + i, attr_offset);
+    const auto unchanged = _mm256_cmpeq_epi32(_mm256_and_si256(attr, mask), mask);
+    const auto bits = unsigned(_mm256_movemask_ps(_mm256_castsi256_ps(unchanged)));
+
+    if ( bits != 0xffU )
+      return i + std::size_t(__builtin_ctz(~bits));
+  }
+
+  return i + countUnchangedCellsSSE2 (cells + i, length - i);
+}
+
+#endif  // defined(USE_X86_LINE_DIFF_KERNELS)
+
+//----------------------------------------------------------------------
+auto getLineDiffFunctions (LineDiffKernel kernel) -> LineDiffFunctions
+{
+#if defined(USE_X86_LINE_DIFF_KERNELS)
+  if ( kernel == LineDiffKernel::AVX2 )
+    return { kernel, &findFirstDifferenceAVX2
+           , &findLastDifferenceAVX2, &countUnchangedCellsAVX2 };
+
+  if ( kernel == LineDiffKernel::SSE2 )
+    return { kernel, &findFirstDifferenceSSE2
+           , &findLastDifferenceSSE2, &countUnchangedCellsSSE2 };
+#endif
+
+  return { LineDiffKernel::Scalar, &findFirstDifferenceScalar
+         , &findLastDifferenceScalar, &countUnchangedCellsScalar };
+}
+
+//----------------------------------------------------------------------
+auto getBestLineDiffKernel() -> LineDiffKernel
+{
+  if ( isLineDiffKernelSupported(LineDiffKernel::AVX2) )
+    return LineDiffKernel::AVX2;
+
+  if ( isLineDiffKernelSupported(LineDiffKernel::SSE2) )
+    return LineDiffKernel::SSE2;
+
+  return LineDiffKernel::Scalar;
+}
+
+//----------------------------------------------------------------------
+auto getLineDiffFunctionTable() -> LineDiffFunctions&
+{
+  // The kernel is selected on first use
+  static auto table = getLineDiffFunctions(getBestLineDiffKernel());
+  return table;
+}
+
+}  // namespace internal
+
+
+// non-member functions
+//----------------------------------------------------------------------
+auto getLineDiffKernel() noexcept -> LineDiffKernel
+{
+  return internal::getLineDiffFunctionTable().kernel;
+}
+
+//----------------------------------------------------------------------
+auto setLineDiffKernel (LineDiffKernel kernel) noexcept -> bool
+{
+  if ( ! isLineDiffKernelSupported(kernel) )
+    return false;
+
+  internal::getLineDiffFunctionTable() = internal::getLineDiffFunctions(kernel);
+  return true;
+}
+
+//----------------------------------------------------------------------
+auto isLineDiffKernelSupported (LineDiffKernel kernel) noexcept -> bool
+{
+  if ( kernel == LineDiffKernel::Scalar )
+    return true;
+
+#if defined(USE_X86_LINE_DIFF_KERNELS)
+  __builtin_cpu_init();
+
+  if ( kernel == LineDiffKernel::SSE2 )
+    return __builtin_cpu_supports("sse2");
+
+  if ( kernel == LineDiffKernel::AVX2 )
+    return __builtin_cpu_supports("avx2");
+#endif
+
+  return false;
+}
+
+//----------------------------------------------------------------------
+auto findFirstDifference ( const FChar* cells, const FVTerm::FCellPlanes& planes
+                         , std::size_t index, std::size_t length ) noexcept -> std::size_t
+{
+  // Returns the position of the first cell that differs from
+  // the planes, or length if all cells are equal
+
+  return internal::getLineDiffFunctionTable().find_first (cells, planes, index, length);
+}
+
+//----------------------------------------------------------------------
+auto findLastDifference ( const FChar* cells, const FVTerm::FCellPlanes& planes
+                        , std::size_t index, std::size_t length ) noexcept -> std::size_t
+{
+  // Returns the position of the last cell that differs from
+  // the planes, or length if all cells are equal
+
+  return internal::getLineDiffFunctionTable().find_last (cells, planes, index, length);
+}
+
+//----------------------------------------------------------------------
+auto countUnchangedCells (const FChar* cells, std::size_t length) noexcept -> std::size_t
+{
+  // Returns the number of leading cells marked with no_changes
+
+  return internal::getLineDiffFunctionTable().count_unchanged (cells, length);
+}
+
+}  // namespace finalcut
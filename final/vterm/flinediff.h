@@ -0,0 +1,62 @@
+/***********************************************************************
+* flinediff.h - Fast comparison of virtual terminal lines              *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  The line comparison functions compare a run of FChar cells with
+ *  the compact cell planes of the previous terminal content.
+ *  On x86 processors, an SSE2 or AVX2 kernel is selected at runtime.
+ *  All other processors use the scalar kernel.
+ */
+
+#ifndef FLINEDIFF_H
+#define FLINEDIFF_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include "final/ftypes.h"
+#include "final/vterm/fvterm.h"
+
+namespace finalcut
+{
+
+// Enumeration
+enum class LineDiffKernel
+{
+  Scalar,  // Portable cell by cell comparison
+  SSE2,    // 4 cells per step
+  AVX2     // 8 cells per step
+};
+
+// non-member function forward declarations
+auto getLineDiffKernel() noexcept -> LineDiffKernel;
+auto setLineDiffKernel (LineDiffKernel) noexcept -> bool;
+auto isLineDiffKernelSupported (LineDiffKernel) noexcept -> bool;
+auto findFirstDifference ( const FChar*, const FVTerm::FCellPlanes&
+                         , std::size_t, std::size_t ) noexcept -> std::size_t;
+auto findLastDifference ( const FChar*, const FVTerm::FCellPlanes&
+                        , std::size_t, std::size_t ) noexcept -> std::size_t;
+auto countUnchangedCells (const FChar*, std::size_t) noexcept -> std::size_t;
+
+}  // namespace finalcut
+
+#endif  // FLINEDIFF_H
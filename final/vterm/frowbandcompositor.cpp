@@ -0,0 +1,237 @@
+/***********************************************************************
+* frowbandcompositor.cpp - Parallel layer compositing                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <memory>
+
+#include "final/vterm/frowbandcompositor.h"
+
+namespace finalcut
+{
+
+// static class attributes
+constexpr std::size_t FRowBandCompositor::DEFAULT_MIN_CELLS;
+constexpr std::size_t FRowBandCompositor::MIN_BAND_HEIGHT;
+
+
+//----------------------------------------------------------------------
+// class FRowBandCompositor
+//----------------------------------------------------------------------
+
+// constructors and destructor
+//----------------------------------------------------------------------
+FRowBandCompositor::~FRowBandCompositor()  // destructor
+{
+  stopWorkers();
+}
+
+
+// public methods of FRowBandCompositor
+//----------------------------------------------------------------------
+auto FRowBandCompositor::getInstance() -> FRowBandCompositor&
+{
+  static const auto& compositor = std::make_unique<FRowBandCompositor>();
+  return *compositor;
+}
+
+//----------------------------------------------------------------------
+auto FRowBandCompositor::getBandCount (std::size_t rows) const noexcept -> std::size_t
+{
+  // Returns the number of row bands for the given number of rows
+
+  const auto bands = std::min(thread_count, rows / MIN_BAND_HEIGHT);
+  return std::max(bands, std::size_t(1));
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositor::setThreadCount (std::size_t count)
+{
+  // Sets the number of threads including the calling thread
+  // (0 = number of hardware threads)
+
+  if ( count == 0 )
+    count = std::max(std::thread::hardware_concurrency(), 1U);
+
+  if ( count == thread_count )
+    return;
+
+  stopWorkers();  // The workers are restarted on demand
+  thread_count = count;
+}
+
+//----------------------------------------------------------------------
+auto FRowBandCompositor::isParallel ( std::size_t width
+                                    , std::size_t height ) const noexcept -> bool
+{
+  return enabled
+      && width * height >= min_cells
+      && getBandCount(height) > 1;
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositor::begin (std::size_t rows, std::size_t layers)
+{
+  // Starts collecting the line copies of all layers. Each layer adds
+  // at most one line copy per row, so addLine() never allocates.
+
+  lines.clear();
+  lines.reserve(rows * layers);
+  collect_rows = rows;
+  collecting = true;
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositor::finish (const LineHandler& handler)
+{
+  // Executes the collected line copies band by band. Within a band,
+  // the lines keep the order of the layers (from bottom to top).
+
+  collecting = false;
+
+  if ( lines.empty() )
+    return;
+
+  forEachBand ( collect_rows
+              , [this, &handler] (std::size_t first, std::size_t last)
+                {
+                  for (const auto& line : lines)
+                    if ( line.row >= first && line.row < last )
+                      handler(line);
+                } );
+  lines.clear();
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositor::forEachBand ( std::size_t rows
+                                     , const BandHandler& handler )
+{
+  // Calls the handler with the row range [first, last) of each band
+  // and returns after all bands are done
+
+  const auto bands = getBandCount(rows);
+
+  if ( bands < 2 )
+  {
+    handler (0, rows);
+    return;
+  }
+
+  startWorkers();
+  uInt64 current_generation{};
+
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    band_handler = &handler;
+    band_rows = rows;
+    band_count = bands;
+    next_band = 0;
+    finished_bands = 0;
+    generation++;
+    current_generation = generation;
+  }
+
+  start_condition.notify_all();
+  processBands (current_generation);  // The calling thread helps out
+  std::unique_lock<std::mutex> lock{mutex};
+  done_condition.wait (lock, [this] { return finished_bands == band_count; });
+  band_handler = nullptr;
+}
+
+
+// private methods of FRowBandCompositor
+//----------------------------------------------------------------------
+void FRowBandCompositor::startWorkers()
+{
+  if ( ! workers.empty() || thread_count < 2 )
+    return;
+
+  for (std::size_t n{1}; n < thread_count; n++)
+    workers.emplace_back ([this] { runWorker(); });
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositor::stopWorkers()
+{
+  if ( workers.empty() )
+    return;
+
+  {
+    std::lock_guard<std::mutex> lock{mutex};
+    stop = true;
+  }
+
+  start_condition.notify_all();
+
+  for (auto& worker : workers)
+    worker.join();
+
+  workers.clear();
+  stop = false;
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositor::runWorker()
+{
+  std::unique_lock<std::mutex> lock{mutex};
+  auto seen_generation = generation;
+
+  while ( true )
+  {
+    start_condition.wait ( lock
+                         , [this, &seen_generation]
+                           {
+                             return stop || generation != seen_generation;
+                           } );
+
+    if ( stop )
+      return;
+
+    seen_generation = generation;
+    lock.unlock();
+    processBands (seen_generation);
+    lock.lock();
+  }
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositor::processBands (uInt64 run_generation)
+{
+  // Takes the next free band until all bands of the run are taken
+
+  std::unique_lock<std::mutex> lock{mutex};
+
+  while ( generation == run_generation && next_band < band_count )
+  {
+    const auto band = next_band++;
+    const auto first = band_rows * band / band_count;
+    const auto last = band_rows * (band + 1) / band_count;
+    const auto& handler = *band_handler;
+    lock.unlock();
+    handler (first, last);
+    lock.lock();
+
+    if ( ++finished_bands == band_count )
+      done_condition.notify_all();
+  }
+}
+
+}  // namespace finalcut
@@ -0,0 +1,200 @@
+/***********************************************************************
+* frowbandcompositor.h - Parallel layer compositing                    *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Standalone class
+ *  ════════════════
+ *
+ * ▕▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▔▏
+ * ▕ FRowBandCompositor ▏
+ * ▕▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▁▏
+ */
+
+/*  The row band compositor distributes the layer compositing of
+ *  FVTerm::updateVTerm() to a worker pool. While the layers are
+ *  added from bottom to top, the line copies are only collected.
+ *  Afterward, the virtual terminal is split into row bands, and
+ *  each band executes its line copies in the collected order.
+ *  Since a line copy only reads and writes cells of its own row,
+ *  the result is identical to the serial compositing.
+ *
+ *  The compositor is disabled by default. Small terminals are
+ *  always composited serially because the synchronization would
+ *  cost more time than it saves.
+ *
+ *  Usage:
+ *    auto& compositor = finalcut::FRowBandCompositor::getInstance();
+ *    compositor.enable();
+ */
+
+#ifndef FROWBANDCOMPOSITOR_H
+#define FROWBANDCOMPOSITOR_H
+
+#if !defined (USE_FINAL_H) && !defined (COMPILE_FINAL_CUT)
+  #error "Only <final/final.h> can be included directly."
+#endif
+
+#include <cassert>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "final/ftypes.h"
+#include "final/util/fstring.h"
+
+namespace finalcut
+{
+
+//----------------------------------------------------------------------
+// class FRowBandCompositor
+//----------------------------------------------------------------------
+
+class FRowBandCompositor final
+{
+  public:
+    struct LineCopy
+    {
+      const FChar* src{nullptr};  // Area characters
+      FChar*       dst{nullptr};  // Virtual terminal characters
+      std::size_t  length{0};
+      std::size_t  row{0};        // Virtual terminal row
+      bool         transparent{false};
+    };
+
+    // Using-declarations
+    using LineHandler = std::function<void(const LineCopy&)>;
+    using BandHandler = std::function<void(std::size_t, std::size_t)>;
+
+    // Constants
+    //   Smaller terminals are composited serially
+    static constexpr std::size_t DEFAULT_MIN_CELLS{32'768};
+    //   Lower limit of rows per band
+    static constexpr std::size_t MIN_BAND_HEIGHT{8};
+
+    // Constructor
+    FRowBandCompositor() = default;
+
+    // Disable copy constructor
+    FRowBandCompositor (const FRowBandCompositor&) = delete;
+
+    // Destructor
+    ~FRowBandCompositor();
+
+    // Disable copy assignment operator (=)
+    auto operator = (const FRowBandCompositor&) -> FRowBandCompositor& = delete;
+
+    // Accessors
+    static auto getClassName() -> FString;
+    static auto getInstance() -> FRowBandCompositor&;
+    auto getThreadCount() const noexcept -> std::size_t;
+    auto getMinimumCells() const noexcept -> std::size_t;
+    auto getBandCount (std::size_t) const noexcept -> std::size_t;
+
+    // Mutators
+    void enable (bool = true) noexcept;
+    void disable() noexcept;
+    void setThreadCount (std::size_t);
+    void setMinimumCells (std::size_t) noexcept;
+
+    // Inquiries
+    auto isEnabled() const noexcept -> bool;
+    auto isParallel (std::size_t, std::size_t) const noexcept -> bool;
+    auto isCollecting() const noexcept -> bool;
+
+    // Methods
+    void begin (std::size_t, std::size_t = 1);
+    void addLine (const LineCopy&) noexcept;
+    void finish (const LineHandler&);
+    void forEachBand (std::size_t, const BandHandler&);
+
+  private:
+    // Methods
+    void startWorkers();
+    void stopWorkers();
+    void runWorker();
+    void processBands (uInt64);
+
+    // Data members
+    std::vector<LineCopy>    lines{};
+    std::vector<std::thread> workers{};
+    std::mutex               mutex{};
+    std::condition_variable  start_condition{};
+    std::condition_variable  done_condition{};
+    const BandHandler*       band_handler{nullptr};
+    std::size_t              band_rows{0};     // Rows of the current run
+    std::size_t              band_count{0};
+    std::size_t              next_band{0};
+    std::size_t              finished_bands{0};
+    std::size_t              collect_rows{0};  // Rows while collecting
+    std::size_t              thread_count{std::thread::hardware_concurrency()};
+    std::size_t              min_cells{DEFAULT_MIN_CELLS};
+    uInt64                   generation{0};
+    bool                     enabled{false};
+    bool                     collecting{false};
+    bool                     stop{false};
+};
+
+// FRowBandCompositor inline functions
+//----------------------------------------------------------------------
+inline auto FRowBandCompositor::getClassName() -> FString
+{ return "FRowBandCompositor"; }
+
+//----------------------------------------------------------------------
+inline auto FRowBandCompositor::getThreadCount() const noexcept -> std::size_t
+{ return thread_count; }
+
+//----------------------------------------------------------------------
+inline auto FRowBandCompositor::getMinimumCells() const noexcept -> std::size_t
+{ return min_cells; }
+
+//----------------------------------------------------------------------
+inline void FRowBandCompositor::enable (bool enable) noexcept
+{ enabled = enable; }
+
+//----------------------------------------------------------------------
+inline void FRowBandCompositor::disable() noexcept
+{ enable(false); }
+
+//----------------------------------------------------------------------
+inline void FRowBandCompositor::setMinimumCells (std::size_t cells) noexcept
+{ min_cells = cells; }
+
+//----------------------------------------------------------------------
+inline auto FRowBandCompositor::isEnabled() const noexcept -> bool
+{ return enabled; }
+
+//----------------------------------------------------------------------
+inline auto FRowBandCompositor::isCollecting() const noexcept -> bool
+{ return collecting; }
+
+//----------------------------------------------------------------------
+inline void FRowBandCompositor::addLine (const LineCopy& line) noexcept
+{
+  // begin() has reserved one line copy per row and layer
+  assert ( lines.size() < lines.capacity() );
+  lines.push_back(line);
+}
+
+}  // namespace finalcut
+
+#endif  // FROWBANDCOMPOSITOR_H
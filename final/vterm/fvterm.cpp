@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <numeric>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
@@ -36,6 +37,9 @@
 #include "final/util/fsize.h"
 #include "final/util/fsystem.h"
 #include "final/vterm/fcolorpair.h"
+#include "final/vterm/fframeprofiler.h"
+#include "final/vterm/flinediff.h"
+#include "final/vterm/frowbandcompositor.h"
 #include "final/vterm/fstyle.h"
 #include "final/vterm/fvterm.h"
 
@@ -108,9 +112,130 @@ bool                 FVTerm::no_terminal_updates{false};
 bool                 FVTerm::force_terminal_update{false};
 FVTerm::FTermArea*   FVTerm::active_area{nullptr};
 int                  FVTerm::tabstop{8};
+constexpr uInt32     FVTerm::FCellPlanes::GRAPHEME_INDEX;
 
 using TransparentInvisibleLookupMap = std::unordered_set<wchar_t>;
 
+//----------------------------------------------------------------------
+static auto countTransparentCells (const FChar* fchar, std::size_t length) -> uInt
+{
+  // Counts the transparent characters of a line segment
+
+  return uInt(std::count_if ( fchar, fchar + length
+                            , [] (const FChar& ch)
+                              {
+                                return ( ch.attr.byte[1]
+                                       & internal::var::b1_transparent_mask ) != 0;
+                              } ));
+}
+
+//----------------------------------------------------------------------
+static inline void hashCell (uInt64& hash, uInt32 code, uInt32 color, uInt32 attr) noexcept
+{
+  // FNV-1a hash step over the compared properties of a cell
+
+  constexpr uInt64 fnv_prime = 0x100000001b3;
+  hash = (hash ^ code) * fnv_prime;
+  hash = (hash ^ color) * fnv_prime;
+  hash = (hash ^ (attr & getCompareBitMask())) * fnv_prime;
+}
+
+//----------------------------------------------------------------------
+static auto hashLine (const FChar* line, std::size_t length) noexcept -> uInt64
+{
+  uInt64 hash{0xcbf29ce484222325};
+
+  for (std::size_t i{0}; i < length; i++)
+    hashCell (hash, uInt32(line[i].ch[0]), line[i].color.data, line[i].attr.data);
+
+  return hash;
+}
+
+//----------------------------------------------------------------------
+static auto hashLine ( const FVTerm::FCellPlanes& planes
+                     , std::size_t index, std::size_t length ) noexcept -> uInt64
+{
+  // Same hash value as hashLine() for the FChar cells
+  // that have been stored in the cell planes
+
+  uInt64 hash{0xcbf29ce484222325};
+
+  for (auto i = index; i < index + length; i++)
+  {
+    auto code = planes.code[i];
+
+    if ( code & FVTerm::FCellPlanes::GRAPHEME_INDEX )
+      code = uInt32(planes.graphemes[code & ~FVTerm::FCellPlanes::GRAPHEME_INDEX][0]);
+
+    hashCell (hash, code, planes.color[i], planes.attr[i]);
+  }
+
+  return hash;
+}
+
+//----------------------------------------------------------------------
+static auto getLineOutputCost ( const FChar* line, const FVTerm::FCellPlanes& planes
+                              , std::size_t index, std::size_t length
+                              , uInt move_cost ) noexcept -> uInt
+{
+  // Estimates the number of bytes to print a line
+  // over the old line content
+
+  std::size_t changed{0};
+
+  for (std::size_t i{0}; i < length; i++)
+    if ( ! planes.isEqual(index + i, line[i]) )
+      changed++;
+
+  return changed == 0 ? 0 : uInt(changed) + move_cost;
+}
+
+//----------------------------------------------------------------------
+static auto getLineShiftVote ( const std::vector<uInt64>& new_hash
+                             , const std::vector<uInt64>& old_hash ) -> int
+{
+  // Each changed line with a unique old position votes for a distance
+
+  const auto count = int(new_hash.size());
+  std::unordered_map<uInt64, int> old_lines{};  // Unique old lines
+
+  for (auto i{0}; i < count; i++)
+  {
+    const auto result = old_lines.emplace(old_hash[std::size_t(i)], i);
+
+    if ( ! result.second )
+      result.first->second = -1;  // Line content is not unique
+  }
+
+  std::unordered_map<int, int> votes{};
+  int distance{0};
+  int max_votes{0};
+
+  for (auto i{0}; i < count; i++)
+  {
+    const auto& hash = new_hash[std::size_t(i)];
+
+    if ( hash == old_hash[std::size_t(i)] )
+      continue;
+
+    const auto iter = old_lines.find(hash);
+
+    if ( iter == old_lines.end() || iter->second < 0 )
+      continue;
+
+    const auto d = iter->second - i;
+    const auto n = ++votes[d];
+
+    if ( n > max_votes || (n == max_votes && std::abs(d) < std::abs(distance)) )
+    {
+      max_votes = n;
+      distance = d;
+    }
+  }
+
+  return distance;
+}
+
 //----------------------------------------------------------------------
 static auto getTransparentInvisibleLookupMap() -> TransparentInvisibleLookupMap
 {
@@ -263,7 +388,7 @@ void FVTerm::createVTerm (const FSize& size) noexcept
 
   const FRect box{0, 0, size.getWidth(), size.getHeight()};
   vterm = createArea(box);
-  vterm_old = createArea(box);
+  vterm_old = createCompactArea(box);  // Only used for comparisons
 }
 
 //----------------------------------------------------------------------
@@ -311,8 +436,9 @@ auto FVTerm::updateTerminal() const -> bool
 void FVTerm::reduceTerminalLineUpdates (uInt y)
 {
   static const auto& init_object = getGlobalFVTermInstance();
-  static const auto& vterm = init_object->vterm;
-  static const auto& vterm_old = init_object->vterm_old;
+  // The global instance can be replaced by a new FVTerm object
+  const auto& vterm = init_object->vterm;
+  const auto& vterm_old = init_object->vterm_old;
   auto& vterm_changes = vterm->changes[unsigned(y)];
   uInt& xmin = vterm_changes.xmin;
   uInt& xmax = vterm_changes.xmax;
@@ -320,32 +446,222 @@ void FVTerm::reduceTerminalLineUpdates (uInt y)
   if ( xmin > xmax )  // No changes
     return;
 
-  const auto* first = &vterm->getFChar(int(xmin), int(y));
-  const auto* first_old = &vterm_old->getFChar(int(xmin), int(y));
-  auto* last = &vterm->getFChar(int(xmax), int(y));
-  const auto* last_old = &vterm_old->getFChar(int(xmax), int(y));
+  static auto& profiler = FFrameProfiler::getInstance();
+  profiler.addCellsCompared (xmax - xmin + 1);
+  const auto& old_planes = vterm_old->planes;
+  auto* line = &vterm->getFChar(0, int(y));
+  const auto line_index = vterm_old->getIndex(0, int(y));
+
+  // Skip unchanged characters at the beginning of the line
+  xmin += uInt(findFirstDifference ( line + xmin, old_planes
+                                   , line_index + xmin, xmax - xmin ));
+
+  // Skip unchanged characters at the end of the line
+  const std::size_t length = xmax - xmin + 1;
+  const auto last = findLastDifference ( line + xmin, old_planes
+                                       , line_index + xmin, length );
+
+  if ( last == length )  // No changes
+  {
+    if ( xmin == 0 )
+      xmin = uInt(vterm->size.width);
+    else
+      xmax = xmin - 1;
+
+    return;
+  }
+
+  xmax = xmin + uInt(last);
+
+  // Mark the unchanged characters between the first and last change
+  auto x = xmin + 1;
+
+  while ( x < xmax )
+  {
+    const auto end = x + uInt(findFirstDifference ( line + x, old_planes
+                                                  , line_index + x, xmax - x ));
+
+    for (; x < end; x++)
+      line[x].attr.bit.no_changes = true;
+
+    x++;  // Skip the changed character
+  }
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::findTerminalLineShift (uInt move_cost) -> FLineShift
+{
+  // Searches for a block of lines that has moved vertically since the
+  // last terminal update. The returned distance is only non-zero if
+  // a terminal scroll of this block saves output bytes.
+
+  const auto& init_object = getGlobalFVTermInstance();
+  const auto& vterm = init_object->vterm;
+  const auto& vterm_old = init_object->vterm_old;
+  FLineShift shift{0, 0, 0, 0};
+  const auto width = uInt(vterm->size.width);
+  const auto height = uInt(vterm->size.height);
+  uInt first{height};
+  uInt last{0};
+  uInt xmin{width};
+  uInt xmax{0};
+  const auto scrolled = vterm->scroll_distance;
+  vterm->scroll_distance = 0;  // The record applies to this update
 
-  while ( xmin < xmax && *first == *first_old )
+  // Get the rectangle with all changed lines
+  for (uInt y{0}; y < height; y++)
   {
-    xmin++;
-    first++;
-    first_old++;
+    const auto& line_changes = vterm->changes[y];
+
+    if ( line_changes.xmin > line_changes.xmax )
+      continue;
+
+    first = std::min(first, y);
+    last = y;
+    xmin = std::min(xmin, line_changes.xmin);
+    xmax = std::max(xmax, line_changes.xmax);
   }
 
-  while ( last >= first && *last == *last_old )
+  if ( first >= last || xmax >= width )  // Less than two changed lines
+    return shift;
+
+  const auto count = int(last - first + 1);
+  const auto length = std::size_t(xmax - xmin + 1);
+  const auto& old_planes = vterm_old->planes;
+  std::vector<uInt64> new_hash(std::size_t(count), 0);
+  std::vector<uInt64> old_hash(std::size_t(count), 0);
+
+  for (auto i{0}; i < count; i++)
   {
-    xmax--;
-    last--;
-    last_old--;
+    const auto y = int(first) + i;
+    const auto index = std::size_t(i);
+    new_hash[index] = hashLine (&vterm->getFChar(int(xmin), y), length);
+    old_hash[index] = hashLine (old_planes, vterm_old->getIndex(int(xmin), y), length);
   }
 
-  while ( last > first )
+  const auto is_moved = [&new_hash, &old_hash, count] (int i, int distance)
   {
-    if ( *last == *last_old )
-      last->attr.bit.no_changes = true;
+    const auto j = i + distance;
+    return i >= 0 && i < count && j >= 0 && j < count
+        && new_hash[std::size_t(i)] == old_hash[std::size_t(j)];
+  };
 
-    last--;
-    last_old--;
+  // A recorded area scroll replaces the vote of the changed lines
+  const auto distance = ( scrolled != 0 )
+                      ? scrolled
+                      : getLineShiftVote (new_hash, old_hash);
+
+  if ( distance == 0 )
+    return shift;
+
+  // Moved block from the first to the last voting line
+  auto a = count;
+  auto b{-1};
+
+  for (auto i{0}; i < count; i++)
+  {
+    if ( new_hash[std::size_t(i)] != old_hash[std::size_t(i)]
+      && is_moved(i, distance) )
+    {
+      a = std::min(a, i);
+      b = i;
+    }
+  }
+
+  if ( b < a )  // No moved line
+    return shift;
+
+  while ( is_moved(a - 1, distance) )
+    a--;
+
+  while ( is_moved(b + 1, distance) )
+    b++;
+
+  // The scroll region contains the moved and the exposed lines
+  a += int(first);
+  b += int(first);
+  const auto top = uInt(std::min(a, a + distance));
+  const auto bottom = uInt(std::max(b, b + distance));
+
+  const auto line_cost = [&vterm, &vterm_old, &old_planes, width, move_cost] (int y, int old_y)
+  {
+    return getLineOutputCost ( &vterm->getFChar(0, y), old_planes
+                             , vterm_old->getIndex(0, old_y), width, move_cost );
+  };
+
+  uInt repaint_cost{0};
+  uInt scroll_cost = uInt(std::abs(distance)) * (width + move_cost);
+
+  for (auto y = int(top); y <= int(bottom); y++)
+    repaint_cost += line_cost(y, y);
+
+  for (auto y = a; y <= b; y++)
+    scroll_cost += line_cost(y, y + distance);
+
+  if ( scroll_cost >= repaint_cost )
+    return shift;
+
+  return { top, bottom, distance, repaint_cost - scroll_cost };
+}
+
+//----------------------------------------------------------------------
+void FVTerm::shiftTerminalLines (const FLineShift& shift)
+{
+  // Moves the lines of the previous terminal content in the same way
+  // as the terminal has scrolled them. The content of the exposed lines
+  // is unknown, so they will be printed completely.
+
+  if ( shift.distance == 0 || shift.top >= shift.bottom )
+    return;
+
+  const auto& init_object = getGlobalFVTermInstance();
+  const auto& vterm = init_object->vterm;
+  const auto& vterm_old = init_object->vterm_old;
+  auto& old_planes = vterm_old->planes;
+  const auto width = std::size_t(vterm->size.width);
+  const auto distance = std::size_t(std::abs(shift.distance)) * width;
+  const auto region = std::size_t(shift.bottom - shift.top + 1) * width;
+
+  if ( distance >= region )
+    return;
+
+  const auto upper = vterm_old->getIndex(0, int(shift.top));
+  const auto lower = upper + distance;
+  const auto moved = region - distance;
+
+  const auto move_cells = [&shift, upper, lower, moved] (auto& plane)
+  {
+    auto* cells = plane.data();
+
+    if ( shift.distance > 0 )  // Scroll up
+      std::copy (cells + lower, cells + lower + moved, cells + upper);
+    else  // Scroll down
+      std::copy_backward (cells + upper, cells + upper + moved, cells + lower + moved);
+  };
+
+  move_cells (old_planes.code);
+  move_cells (old_planes.color);
+  move_cells (old_planes.attr);
+
+  // An undefined color never matches a virtual terminal character
+  FChar unknown_char{};
+  unknown_char.ch[0] = L' ';
+  unknown_char.color.pair.fg = FColor::Undefined;
+  unknown_char.color.pair.bg = FColor::Undefined;
+  const auto exposed = ( shift.distance > 0 ) ? upper + moved : upper;
+
+  for (auto i = exposed; i < exposed + distance; i++)
+    old_planes.setFChar (i, unknown_char);
+
+  // Compare the whole scroll region again
+  for (auto y = shift.top; y <= shift.bottom; y++)
+  {
+    auto& line_changes = vterm->changes[y];
+    line_changes.xmin = 0;
+    line_changes.xmax = uInt(width - 1);
+    auto* line = &vterm->getFChar(0, int(y));
+    std::for_each ( line, line + width
+                  , [] (FChar& fchar) { fchar.attr.bit.no_changes = false; } );
   }
 }
 
@@ -423,8 +739,8 @@ auto FVTerm::print (const FString& string) noexcept -> int
   if ( string.isEmpty() )
     return 0;
 
-  vterm_buffer.print(string);
-  return print (vterm_buffer);
+  auto area = getPrintArea();
+  return area ? printString (area, string) : -1;
 }
 
 //----------------------------------------------------------------------
@@ -433,8 +749,7 @@ auto FVTerm::print (FTermArea* area, const FString& string) noexcept -> int
   if ( ! area || string.isEmpty() )
     return -1;
 
-  vterm_buffer.print(string);
-  return print (area, vterm_buffer);
+  return printString (area, string);
 }
 
 //----------------------------------------------------------------------
@@ -575,7 +890,14 @@ auto FVTerm::print (FTermArea* area, const FChar& term_char) const noexcept -> i
 //----------------------------------------------------------------------
 void FVTerm::flush() const
 {
-  foutput->flush();
+  {
+    FFrameProfiler::ScopedPhase flush_phase{FFrameProfiler::Phase::Flush};
+    foutput->flush();
+  }
+
+  // A flush completes the frame
+  static auto& profiler = FFrameProfiler::getInstance();
+  profiler.finishFrame();
 }
 
 
@@ -624,6 +946,20 @@ auto FVTerm::createArea (const FRect& box) -> std::unique_ptr<FTermArea>
   return createArea ({box, no_shadow});
 }
 
+//----------------------------------------------------------------------
+auto FVTerm::createCompactArea (const FRect& box) -> std::unique_ptr<FTermArea>
+{
+  // Initialize an area with structure-of-arrays cell storage.
+  // Its cells can only be accessed via FTermArea::planes
+
+  auto area = std::make_unique<FTermArea>();
+  area->setOwner<FVTerm*>(this);
+  area->layout = FTermArea::Layout::Planes;
+  area->encoding = foutput->getEncoding();
+  resizeArea ({box, FSize(0, 0)}, area.get());
+  return area;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::resizeArea ( const FShadowBox& shadowbox
                         , FTermArea* area ) const
@@ -635,6 +971,8 @@ void FVTerm::resizeArea ( const FShadowBox& shadowbox
   if ( ! area )
     return;
 
+  invalidateOcclusionMap();
+
   if ( isSizeEqual(area, shadowbox) )
   {
     area->position.x = shadowbox.box.getX();
@@ -667,7 +1005,11 @@ void FVTerm::resizeArea (const FRect& box, FTermArea* area) const
 //----------------------------------------------------------------------
 void FVTerm::restoreVTerm (const FRect& box) const noexcept
 {
-  if ( ! vterm || box.getWidth() == 0 || box.getHeight() == 0 )
+  // Rebuilds the virtual terminal content inside the given box.
+  // Cells with an opaque top-most window only reprint this window,
+  // transparent cells reprint all layers below them.
+
+  if ( ! vterm || ! vdesktop || box.getWidth() == 0 || box.getHeight() == 0 )
     return;
 
   const auto* win_list = getWindowList();
@@ -675,21 +1017,68 @@ void FVTerm::restoreVTerm (const FRect& box) const noexcept
   if ( ! win_list || win_list->empty() )
     return;
 
-  const FSize vterm_size{ static_cast<std::size_t>(vterm->size.width)
-                        , static_cast<std::size_t>(vterm->size.height) };
+  updateOcclusionMap();
+  const auto& map = *occlusion_map;
+  const int x_start = std::max(box.getX1() - 1, 0);
+  const int y_start = std::max(box.getY1() - 1, 0);
+  const int x_end = std::min(box.getX2() - 1, map.width - 1);
+  const int y_end = std::min(box.getY2() - 1, map.height - 1);
 
-  if ( vdesktop && vdesktop->reprint(box, vterm_size) )
-    addLayer(vdesktop.get());
+  if ( x_start > x_end || y_start > y_end )
+    return;
+
+  auto& reprinted = occlusion_map->reprinted;
+  reprinted.clear();
+  bool desktop_reprinted{false};
 
-  for (const auto& win_obj : *win_list)
+  auto reprint_cell = [this, &reprinted] (const FTermArea* area, int x, int y)
   {
-    if ( ! win_obj )
-      continue;
+    if ( std::find(reprinted.cbegin(), reprinted.cend(), area) == reprinted.cend() )
+      reprinted.push_back(area);
 
-    auto* win = win_obj->getVWin();
+    markCellForReprint (const_cast<FTermArea*>(area), x, y);
+  };
+
+  for (auto y{y_start}; y <= y_end; y++)  // Line loop
+  {
+    const auto* owner = &map.owner[unsigned(y * map.width + x_start)];
+
+    for (auto x{x_start}; x <= x_end; x++)
+    {
+      const auto* win = *owner;
+      std::advance(owner, 1);
+
+      if ( win && ! isFCharTransparent(win->getFChar(x - win->position.x, y - win->position.y)) )
+      {
+        reprint_cell (win, x, y);  // Only the top-most window is visible
+        continue;
+      }
+
+      // Reprint all layers of a transparent or uncovered cell
+      markCellForReprint (vdesktop.get(), x, y);
+      desktop_reprinted = true;
 
-    if ( win && win->visible && win->layer > 0 && win->reprint(box, vterm_size) )
-      addLayer(win);
+      if ( ! win )
+        continue;
+
+      for (const auto& entry : map.entries)
+      {
+        if ( entry.box.contains(x, y) )
+          reprint_cell (entry.area, x, y);
+
+        if ( entry.area == win )
+          break;
+      }
+    }
+  }
+
+  if ( desktop_reprinted )
+    addLayer(vdesktop.get());
+
+  for (const auto& entry : map.entries)  // Bottom to top
+  {
+    if ( std::find(reprinted.cbegin(), reprinted.cend(), entry.area) != reprinted.cend() )
+      addLayer(const_cast<FTermArea*>(entry.area));
   }
 }
 
@@ -827,8 +1216,12 @@ void FVTerm::addLayer (FTermArea* area) const noexcept
   const int y_end = std::min(vterm->size.height - ay, height);
   const int xmax_inside_vterm = vterm_width - area_x - 1;
 
+  if ( area->scroll_distance != 0 )
+    passScrollToVTerm(area);
+
   // Call the preprocessing handler methods (child area change handling)
   callPreprocessingHandler(area);
+  static auto& compositor = FRowBandCompositor::getInstance();
   auto* line_changes = &area->changes[0];
 
   for (auto y{0}; y < y_end; y++)  // Line loop
@@ -855,7 +1248,13 @@ void FVTerm::addLayer (FTermArea* area) const noexcept
     const auto& ac = area->getFChar(line_xmin, y);  // Area character
     auto& tc = vterm->getFChar(tx, ty);  // Terminal character
 
-    if ( line_changes->trans_count > 0 )
+    if ( compositor.isCollecting() )
+    {
+      // The row band compositor copies the line later
+      const bool transparent = line_changes->trans_count > 0;
+      compositor.addLine ({&ac, &tc, length, std::size_t(ty), transparent});
+    }
+    else if ( line_changes->trans_count > 0 )
     {
       // Line with hidden and transparent characters
       addAreaLineWithTransparency (&ac, &tc, length);
@@ -948,6 +1347,7 @@ void FVTerm::determineWindowLayers() noexcept
 {
   // Determination of the window layer for all virtual windows
 
+  invalidateOcclusionMap();
   const auto* win_list = getWindowList();
 
   if ( ! win_list || win_list->empty() )
@@ -964,6 +1364,18 @@ void FVTerm::determineWindowLayers() noexcept
   }
 }
 
+//----------------------------------------------------------------------
+void FVTerm::invalidateOcclusionMap() noexcept
+{
+  // Rebuilds the occlusion map on its next use. Necessary after a
+  // window was moved, resized, shown, hidden, raised or lowered.
+
+  const auto* fvterm = getGlobalFVTermInstance();
+
+  if ( fvterm && fvterm->occlusion_map )
+    fvterm->occlusion_map->dirty = true;
+}
+
 //----------------------------------------------------------------------
 void FVTerm::scrollAreaForward (FTermArea* area)
 {
@@ -974,17 +1386,11 @@ void FVTerm::scrollAreaForward (FTermArea* area)
 
   const int y_max = area->size.height - 1;
   const int x_max = area->size.width - 1;
-  auto* line_changes = &area->changes[0];
 
-  for (auto y{0}; y < y_max; y++)
-  {
-    auto& dc = area->getFChar(0, y);  // destination character
-    const auto& sc = area->getFChar(0, y + 1);  // source character
-    putAreaLine (sc, dc, unsigned(area->size.width));
-    line_changes->xmin = 0;
-    line_changes->xmax = uInt(x_max);
-    std::advance(line_changes, 1);
-  }
+  // Rotate the lines and record the scroll instead of copying
+  // the character data and marking every line as changed
+  area->rotateLines(1);
+  area->scroll_distance++;
 
   // insert a new line below
   const auto& lc = area->getFChar(x_max, area->size.height - 2);  // last character
@@ -997,6 +1403,8 @@ void FVTerm::scrollAreaForward (FTermArea* area)
   auto& new_line_changes = area->changes[unsigned(y_max)];
   new_line_changes.xmin = 0;
   new_line_changes.xmax = uInt(x_max);
+  const auto full_width = std::size_t(getFullAreaWidth(area));
+  new_line_changes.trans_count = countTransparentCells(&dc, full_width);
   area->has_changes = true;
 
   if ( area == vdesktop.get() )
@@ -1011,19 +1419,12 @@ void FVTerm::scrollAreaReverse (FTermArea* area)
   if ( ! area || area->size.height <= 1 )
     return;
 
-  const int y_max = area->size.height - 1;
   const int x_max = area->size.width - 1;
-  auto* line_changes = &area->changes[0];
 
-  for (auto y = y_max; y > 0; y--)
-  {
-    auto& dc = area->getFChar(0, y);  // destination character
-    const auto& sc = area->getFChar(0, y - 1);  // source character
-    putAreaLine (sc, dc, unsigned(area->size.width));
-    line_changes->xmin = 0;
-    line_changes->xmax = uInt(x_max);
-    std::advance(line_changes, 1);
-  }
+  // Rotate the lines and record the scroll instead of copying
+  // the character data and marking every line as changed
+  area->rotateLines(-1);
+  area->scroll_distance--;
 
   // insert a new line above
   const auto& lc = area->getFChar(0, 1);  // last character
@@ -1033,9 +1434,11 @@ void FVTerm::scrollAreaReverse (FTermArea* area)
   nc.ch[1] = L'\0';
   auto& dc = area->getFChar(0, 0);  // destination character
   std::fill (&dc, &dc + area->size.width, nc);
-  auto& new_line_changes = area->changes[unsigned(y_max)];
+  auto& new_line_changes = area->changes[0];
   new_line_changes.xmin = 0;
   new_line_changes.xmax = uInt(x_max);
+  const auto full_width = std::size_t(getFullAreaWidth(area));
+  new_line_changes.trans_count = countTransparentCells(&dc, full_width);
   area->has_changes = true;
 
   if ( area == vdesktop.get() )
@@ -1207,8 +1610,14 @@ inline void FVTerm::resetTextAreaToDefault ( FTermArea* area
     { { FColor::Default, FColor::Default } },
     { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3 (byte 2 = 0x08 = char_width 1)
   };
-  std::fill (area->data.begin(), area->data.end(), default_char);
 
+  if ( area->layout == FTermArea::Layout::Planes )
+    area->planes.fill (default_char);
+  else
+    std::fill (area->data.begin(), area->data.end(), default_char);
+
+  area->row_offset = 0;  // Linear line order
+  area->scroll_distance = 0;
   FLineChanges unchanged { uInt(size.getWidth()), 0, 0 };
   std::fill (area->changes.begin(), area->changes.end(), unchanged);
 }
@@ -1231,7 +1640,12 @@ inline auto FVTerm::resizeTextArea (FTermArea* area, std::size_t size) const ->
 {
   // Resize text area to "size" FChar elements
 
-  area->data.resize(size);
+  if ( area->layout == FTermArea::Layout::Planes )
+    area->planes.resize(size);
+  else
+    area->data.resize(size);
+
+  area->row_offset = 0;  // Linear line order
   return true;
 }
 
@@ -1246,6 +1660,35 @@ auto FVTerm::isCovered (const FPoint& pos, const FTermArea* area) const noexcept
     || win_list->back()->getVWin() == area )
     return CoveredState::None;
 
+  updateOcclusionMap();
+  const auto& map = *occlusion_map;
+  const auto x = pos.getX();
+  const auto y = pos.getY();
+
+  if ( x < 0 || y < 0 || x >= map.width || y >= map.height
+    || ( area != vdesktop.get() && ! (area->visible && area->contains(pos)) ) )
+    return isCoveredByWindows (pos, area);
+
+  const auto* owner = map.owner[unsigned(y * map.width + x)];
+
+  if ( ! owner || owner == area )  // No window above the area
+    return CoveredState::None;
+
+  const auto& ch = owner->getFChar(x - owner->position.x, y - owner->position.y);
+
+  if ( ! ch.attr.bit.color_overlay && ! ch.attr.bit.transparent )
+    return CoveredState::Full;  // The top-most window is opaque
+
+  return isCoveredByWindows (pos, area);
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::isCoveredByWindows (const FPoint& pos, const FTermArea* area) const noexcept -> CoveredState
+{
+  // Determines the covered state by checking all windows
+  // above the area (required for transparent windows)
+
+  const auto* win_list{getWindowList()};
   auto is_covered{CoveredState::None};  // Initial state: no coverage
   bool found{ area == vdesktop.get() };
   const auto pos_x = pos.getX();
@@ -1341,6 +1784,155 @@ inline void FVTerm::updateAreaProperties (FTermArea* area, const FShadowBox& sha
   area->has_changes     = false;
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::getOcclusionBox (const FTermArea* area) const noexcept -> FRect
+{
+  // Returns the terminal cells occupied by the area (0-based)
+
+  const int height = area->minimized ? area->min_size.height
+                                     : getFullAreaHeight(area);
+  return { FPoint{area->position.x, area->position.y}
+         , FPoint{ area->position.x + getFullAreaWidth(area) - 1
+                 , area->position.y + height - 1 } };
+}
+
+//----------------------------------------------------------------------
+void FVTerm::updateOcclusionMap() const
+{
+  // Synchronizes the occlusion map with the window list. Only the
+  // cells of windows that have been moved, resized, shown, hidden,
+  // raised or lowered since the last call are recalculated.
+
+  auto& map = *occlusion_map;
+  const bool term_resized = map.width != vterm->size.width
+                         || map.height != vterm->size.height;
+
+  if ( ! map.dirty && ! term_resized )
+    return;  // The window layout is unchanged
+
+  map.dirty = false;
+  auto& entries = map.new_entries;
+  entries.clear();
+  const auto* win_list = getWindowList();
+
+  if ( win_list )
+  {
+    for (const auto& win_obj : *win_list)  // Bottom to top
+    {
+      const auto* win = win_obj ? win_obj->getVWin() : nullptr;
+
+      if ( win && win->visible && win->layer > 0 )
+        entries.push_back({win, getOcclusionBox(win)});
+    }
+  }
+
+  if ( term_resized )
+  {
+    // New terminal size
+    map.width = vterm->size.width;
+    map.height = vterm->size.height;
+    map.owner.assign(std::size_t(map.width * map.height), nullptr);
+    map.entries.swap(entries);
+    paintOcclusionMap (FRect{FPoint{0, 0}, FPoint{map.width - 1, map.height - 1}});
+    return;
+  }
+
+  auto is_equal = [] (const FOcclusionEntry& lhs, const FOcclusionEntry& rhs)
+  {
+    return lhs.area == rhs.area && lhs.box == rhs.box;
+  };
+
+  if ( std::equal(entries.cbegin(), entries.cend(), map.entries.cbegin(), map.entries.cend(), is_equal) )
+    return;  // Nothing has changed
+
+  auto find_index = [] (const FOcclusionMap::FEntryVec& list, const FTermArea* area)
+  {
+    auto iter = std::find_if ( list.cbegin(), list.cend()
+                             , [area] (const FOcclusionEntry& entry)
+                               {
+                                 return entry.area == area;
+                               } );
+    return iter - list.cbegin();
+  };
+
+  auto& dirty_boxes = map.dirty_boxes;
+  dirty_boxes.clear();
+  const auto old_size = map.entries.size();
+  const auto new_size = entries.size();
+
+  for (const auto& entry : map.entries)  // Hidden, moved or resized
+  {
+    const auto i = std::size_t(find_index(entries, entry.area));
+
+    if ( i == new_size || entries[i].box != entry.box )
+      dirty_boxes.push_back(entry.box);
+  }
+
+  for (std::size_t i{0}; i < new_size; i++)
+  {
+    const auto old_i = std::size_t(find_index(map.entries, entries[i].area));
+
+    if ( old_i == old_size || map.entries[old_i].box != entries[i].box )
+    {
+      dirty_boxes.push_back(entries[i].box);  // Shown, moved or resized
+      continue;
+    }
+
+    for (std::size_t j{i + 1}; j < new_size; j++)  // Raised or lowered
+    {
+      const auto old_j = std::size_t(find_index(map.entries, entries[j].area));
+
+      if ( old_j < old_i && entries[i].box.overlap(entries[j].box) )
+        dirty_boxes.push_back(entries[i].box.intersect(entries[j].box));
+    }
+  }
+
+  map.entries.swap(entries);
+
+  for (const auto& box : dirty_boxes)
+    paintOcclusionMap (box);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::paintOcclusionMap (const FRect& box) const
+{
+  // Recalculates the top-most window for the cells in box
+
+  auto& map = *occlusion_map;
+  const FRect term_box{FPoint{0, 0}, FPoint{map.width - 1, map.height - 1}};
+
+  auto fill = [&map, &term_box, &box] (const FRect& rect, const FTermArea* owner)
+  {
+    const auto r = rect.intersect(box).intersect(term_box);
+
+    if ( r.getX2() < r.getX1() || r.getY2() < r.getY1() )
+      return;
+
+    for (auto y{r.getY1()}; y <= r.getY2(); y++)
+    {
+      auto line = map.owner.begin() + y * map.width;
+      std::fill (line + r.getX1(), line + r.getX2() + 1, owner);
+    }
+  };
+
+  fill (box, nullptr);
+
+  for (const auto& entry : map.entries)  // Painter's algorithm
+    fill (entry.box, entry.area);
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::markCellForReprint (FTermArea* area, int x, int y) const noexcept
+{
+  // Adds the terminal cell (x, y) to the changes of the area
+
+  auto& line_changes = area->changes[unsigned(y - area->position.y)];
+  const auto ax = uInt(x - area->position.x);
+  line_changes.xmin = std::min(line_changes.xmin, ax);
+  line_changes.xmax = std::max(line_changes.xmax, ax);
+  area->has_changes = true;
+}
+
 //----------------------------------------------------------------------
 constexpr auto FVTerm::getFullAreaWidth (const FTermArea* area) const noexcept -> int
 {
@@ -1473,20 +2065,45 @@ void FVTerm::updateVTerm() const
 {
   // Updates the character data from all areas to VTerm
 
-  updateVTermDesktop();
+  FFrameProfiler::ScopedPhase compose_phase{FFrameProfiler::Phase::Compose};
+  static auto& compositor = FRowBandCompositor::getInstance();
+  const auto width = std::size_t(vterm->size.width);
+  const auto height = std::size_t(vterm->size.height);
+  const bool parallel = compositor.isParallel(width, height);
 
-  if ( ! window_list || window_list->empty() )
-    return;
+  if ( parallel )
+  {
+    // Collect the line copies of the desktop and all windows
+    const auto layers = ( window_list ) ? window_list->size() + 1 : 1;
+    compositor.begin(height, layers);
+  }
+
+  updateVTermDesktop();
 
-  for (auto&& window : *window_list)  // List from bottom to top
+  if ( window_list )
   {
-    auto v_win = window->getVWin();
+    for (auto&& window : *window_list)  // List from bottom to top
+    {
+      auto v_win = window->getVWin();
 
-    if ( ! (v_win && v_win->visible && v_win->layer > 0) )
-      continue;
+      if ( ! (v_win && v_win->visible && v_win->layer > 0) )
+        continue;
 
-    updateVTermWindow(v_win);
+      updateVTermWindow(v_win);
+    }
   }
+
+  if ( ! parallel )
+    return;
+
+  // Composite all layers in row bands
+  compositor.finish ([this] (const FRowBandCompositor::LineCopy& line)
+  {
+    if ( line.transparent )
+      addAreaLineWithTransparency (line.src, line.dst, line.length);
+    else
+      putAreaLine (*line.src, *line.dst, line.length);
+  });
 }
 
 //----------------------------------------------------------------------
@@ -1516,6 +2133,34 @@ inline void FVTerm::updateVTermWindow (FTermArea* v_win) const
   }
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm::passScrollToVTerm (FTermArea* area) const noexcept
+{
+  // Copies the moved lines of a scrolled area and passes the recorded
+  // distance to the terminal line shift detection
+
+  const auto distance = area->scroll_distance;
+  const auto height = area->size.height;
+  area->scroll_distance = 0;
+
+  if ( std::abs(distance) >= height )
+    return;  // No line remained in the area
+
+  if ( vterm->scroll_distance == 0 )
+    vterm->scroll_distance = distance;
+
+  const auto first = std::max(0, -distance);
+  const auto last = height - 1 - std::max(0, distance);
+  const auto x_max = uInt(area->size.width - 1);
+
+  for (auto y = first; y <= last; y++)
+  {
+    auto& line_changes = area->changes[unsigned(y)];
+    line_changes.xmin = 0;
+    line_changes.xmax = std::max(line_changes.xmax, x_max);
+  }
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::scrollTerminalForward() const
 {
@@ -1527,6 +2172,7 @@ inline void FVTerm::scrollTerminalForward() const
     return;
 
   // Avoid update lines from 0 to (height - 2)
+  vdesktop->scroll_distance = 0;
   auto* vdesktop_changes = &vdesktop->changes[0];
   const auto* vdesktop_changes_end = vdesktop_changes
                                    + unsigned(vdesktop->size.height - 1);
@@ -1554,6 +2200,7 @@ inline void FVTerm::scrollTerminalReverse() const
     return;
 
   // avoid update lines from 1 to (height - 1)
+  vdesktop->scroll_distance = 0;
   auto* vdesktop_changes = &vdesktop->changes[1];
   const auto* vdesktop_changes_end = vdesktop_changes
                                    + unsigned(vdesktop->size.height);
@@ -1679,7 +2326,7 @@ void FVTerm::finish() const
 inline void FVTerm::saveCurrentVTerm() const
 {
   // Save the content of the virtual terminal
-  std::memcpy(vterm_old->data.data(), vterm->data.data(), vterm->data.size() * sizeof(FChar));
+  vterm_old->planes.setFChars (vterm->data);
 }
 
 
@@ -1995,6 +2642,175 @@ inline auto FVTerm::printCharacterOnCoordinate ( FTermArea* area
   return ac->attr.bit.char_width;
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm::isSingleColumnChar (wchar_t wchar) noexcept -> bool
+{
+  // Printable ASCII and Latin-1 characters always occupy one column
+  return ( wchar >= L' ' && wchar <= L'~' )
+      || ( wchar >= L'\U000000a0' && wchar <= L'\U000000ff' );
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::findSingleColumnRun ( const FString& string
+                                 , std::size_t pos ) noexcept -> std::size_t
+{
+  // Returns the end of the single-column character run at pos
+
+  const auto* str = string.wc_str();
+  const auto length = string.getLength();
+  auto end = pos;
+
+  while ( end < length && isSingleColumnChar(str[end]) )
+    end++;
+
+  if ( end == pos || end == length )
+    return end;
+
+  // A following zero-width character joins the last character
+  // to a grapheme cluster
+  const auto next = str[end];
+
+  if ( getColumnWidth(next) == 0 && ! std::iswcntrl(wint_t(next)) )
+    end--;
+
+  return end;
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::printString (FTermArea* area, const FString& string) noexcept -> int
+{
+  // Runs of single-column characters are written directly into
+  // the area. All other characters (control codes, wide characters
+  // and grapheme clusters) are prepared in the FVTermBuffer.
+
+  const auto length = string.getLength();
+  std::size_t pos{0};
+  int len{0};
+  bool has_output{false};
+
+  while ( pos < length )
+  {
+    auto end = findSingleColumnRun(string, pos);
+
+    if ( end > pos )
+    {
+      has_output = true;
+      const auto count = printSingleColumnRun (area, string.wc_str() + pos, end - pos);
+      len += int(count);
+
+      if ( count < end - pos )
+        break;  // End of area reached
+
+      pos = end;
+      continue;
+    }
+
+    while ( end < length && findSingleColumnRun(string, end) == end )
+      end++;
+
+    const auto first = string.cbegin() + std::ptrdiff_t(pos);
+    const auto last = string.cbegin() + std::ptrdiff_t(end);
+    vterm_buffer.print(first, last);
+    const auto buffer_size = int(vterm_buffer.getLength());
+
+    if ( buffer_size > 0 )
+    {
+      has_output = true;
+      const auto count = print (area, vterm_buffer);
+      len += count;
+
+      if ( count < buffer_size )
+        break;  // End of area reached
+    }
+
+    pos = end;
+  }
+
+  return has_output ? len : -1;  // -1 = Nothing to print
+}
+
+//----------------------------------------------------------------------
+auto FVTerm::printSingleColumnRun ( FTermArea* area
+                                  , const wchar_t* str
+                                  , std::size_t length ) noexcept -> std::size_t
+{
+  // Prints the characters line by line without an intermediate
+  // buffer. The result is the same as with print(area, FChar)
+  // for each character.
+
+  static const auto& next_attr = getAttribute();
+  nc.color.data = next_attr.color.data;
+  nc.attr.byte[0] = next_attr.attr.byte[0];
+  nc.attr.byte[1] = next_attr.attr.byte[1];
+  nc.attr.byte[2] = 0;
+  nc.attr.byte[3] = 0;
+  nc.attr.bit.char_width = 1;
+  nc.ch[1] = L'\0';
+  const int full_width = getFullAreaWidth(area);
+  const int full_height = getFullAreaHeight(area);
+  std::size_t printed{0};
+
+  while ( printed < length )
+  {
+    if ( ! area->checkPrintPos() || printWrap(area) )
+      break;  // Cursor position out of range or end of area reached
+
+    const int ax = area->cursor.x - 1;
+    const int ay = area->cursor.y - 1;
+    const auto count = std::min(length - printed, std::size_t(full_width - ax));
+    auto* ac = &area->getFChar(ax, ay);  // area character
+    auto& line_changes = area->changes[unsigned(ay)];
+    bool has_changes{false};
+    uInt xmin{0};
+    uInt xmax{0};
+
+    for (auto x = uInt(ax); x < uInt(ax) + count; x++, ac++)
+    {
+      nc.ch[0] = str[printed];
+      printed++;
+
+      if ( *ac == nc )
+        continue;
+
+      if ( changedToTransparency(*ac, nc) )
+        line_changes.trans_count++;
+
+      if ( changedFromTransparency(*ac, nc) )
+        line_changes.trans_count--;
+
+      *ac = nc;
+
+      if ( ! has_changes )
+        xmin = x;
+
+      xmax = x;
+      has_changes = true;
+    }
+
+    if ( has_changes && xmin < line_changes.xmin )
+      line_changes.xmin = xmin;
+
+    if ( has_changes && xmax > line_changes.xmax )
+      line_changes.xmax = xmax;
+
+    area->cursor.x += int(count);
+    area->has_changes = true;
+
+    // Line break at right margin
+    if ( area->cursor.x > full_width )
+    {
+      area->cursor.x = 1;
+      area->cursor.y++;
+    }
+
+    // Prevent up scrolling
+    if ( area->cursor.y > full_height )
+      area->cursor.y--;
+  }
+
+  return printed;
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm::printPaddingCharacter (FTermArea* area, const FChar& term_char) const
 {
@@ -2075,4 +2891,72 @@ auto FVTerm::hasPendingUpdates (const FTermArea* area) noexcept -> bool
   return (area && area->has_changes);
 }
 
+
+//----------------------------------------------------------------------
+// struct FVTerm::FCellPlanes
+//----------------------------------------------------------------------
+
+// public methods of FVTerm::FCellPlanes
+//----------------------------------------------------------------------
+auto FVTerm::FCellPlanes::getFChar (std::size_t index) const noexcept -> FChar
+{
+  FChar fchar{};
+  const auto& cell_code = code[index];
+
+  if ( cell_code & GRAPHEME_INDEX )
+    fchar.ch = graphemes[cell_code & ~GRAPHEME_INDEX];
+  else
+    fchar.ch[0] = wchar_t(cell_code);
+
+  fchar.color.data = color[index];
+  fchar.attr.data = attr[index];
+  return fchar;
+}
+
+//----------------------------------------------------------------------
+void FVTerm::FCellPlanes::setFChars ( std::size_t index
+                                    , const FChar* fchar
+                                    , std::size_t length )
+{
+  const auto* end = fchar + length;
+
+  while ( fchar < end )
+  {
+    setFChar (index, *fchar);
+    ++index;
+    ++fchar;
+  }
+}
+
+//----------------------------------------------------------------------
+void FVTerm::FCellPlanes::setFChars (const FCharVector& fchars)
+{
+  // Replaces the entire content, so the side table can be rebuilt
+
+  graphemes.clear();
+  setFChars (0, fchars.data(), std::min(fchars.size(), getSize()));
+}
+
+//----------------------------------------------------------------------
+void FVTerm::FCellPlanes::resize (std::size_t size)
+{
+  code.resize(size);
+  color.resize(size);
+  attr.resize(size);
+}
+
+//----------------------------------------------------------------------
+void FVTerm::FCellPlanes::fill (const FChar& fchar)
+{
+  graphemes.clear();
+
+  if ( code.empty() )
+    return;
+
+  setFChar (0, fchar);
+  std::fill (code.begin(), code.end(), code[0]);
+  std::fill (color.begin(), color.end(), color[0]);
+  std::fill (attr.begin(), attr.end(), attr[0]);
+}
+
 }  // namespace finalcut
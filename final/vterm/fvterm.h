@@ -97,6 +97,7 @@ class FVTerm : public FVTermAttribute
 {
   public:
     struct FTermArea;             // forward declaration
+    struct FCellPlanes;           // forward declaration
     struct FVTermPreprocessing;   // forward declaration
 
     struct FLineChanges
@@ -106,6 +107,14 @@ class FVTerm : public FVTermAttribute
       uInt trans_count;    // Number of transparent characters
     };
 
+    struct FLineShift
+    {
+      uInt top;            // First line of the scroll region
+      uInt bottom;         // Last line of the scroll region
+      int  distance;       // Lines to scroll (> 0 = up, < 0 = down)
+      uInt savings;        // Estimated number of saved output bytes
+    };
+
     // Using-declarations
     using FVTermAttribute::print;
     using FCharVector = std::vector<FChar>;
@@ -196,6 +205,8 @@ class FVTerm : public FVTermAttribute
     void  putVTerm() const;
     auto  updateTerminal() const -> bool;
     static void reduceTerminalLineUpdates (uInt);
+    static auto findTerminalLineShift (uInt) -> FLineShift;
+    static void shiftTerminalLines (const FLineShift&);
     virtual void addPreprocessingHandler ( const FVTerm*
                                          , FPreprocessingFunction&& );
     virtual void delPreprocessingHandler (const FVTerm*);
@@ -247,6 +258,7 @@ class FVTerm : public FVTermAttribute
     // Methods
     auto  createArea (const FShadowBox&) -> std::unique_ptr<FTermArea>;
     auto  createArea (const FRect&) -> std::unique_ptr<FTermArea>;
+    auto  createCompactArea (const FRect&) -> std::unique_ptr<FTermArea>;
     void  resizeArea (const FShadowBox&, FTermArea*) const;
     void  resizeArea (const FRect&, FTermArea*) const;
     void  restoreVTerm (const FRect&) const noexcept;
@@ -260,6 +272,7 @@ class FVTerm : public FVTermAttribute
     void  copyArea (FTermArea*, const FPoint&, const FTermArea* const)  const noexcept;
     static auto  getLayer (FVTerm&) noexcept -> int;
     static void  determineWindowLayers() noexcept;
+    static void  invalidateOcclusionMap() noexcept;
     void  scrollAreaForward (FTermArea*);
     void  scrollAreaReverse (FTermArea*);
     void  clearArea (FTermArea*, wchar_t = L' ') noexcept;
@@ -281,6 +294,30 @@ class FVTerm : public FVTermAttribute
       Full
     };
 
+    struct FOcclusionEntry
+    {
+      const FTermArea* area;  // Visible window
+      FRect            box;   // Occupied terminal cells (0-based)
+    };
+
+    struct FOcclusionMap
+    {
+      using FOwnerVec = std::vector<const FTermArea*>;
+      using FEntryVec = std::vector<FOcclusionEntry>;
+
+      using FAreaVec  = std::vector<const FTermArea*>;
+      using FRectVec  = std::vector<FRect>;
+
+      FOwnerVec owner{};        // Top-most window per cell (nullptr = desktop)
+      FEntryVec entries{};      // Windows in the map from bottom to top
+      FEntryVec new_entries{};  // Reused buffers
+      FRectVec  dirty_boxes{};
+      FAreaVec  reprinted{};
+      int       width{0};
+      int       height{0};
+      bool      dirty{true};    // Window layout changed
+    };
+
     // Methods
     static void setGlobalFVTermInstance (FVTerm*);
     static auto getGlobalFVTermInstance() -> FVTerm*&;
@@ -290,6 +327,11 @@ class FVTerm : public FVTermAttribute
     auto  resizeTextArea (FTermArea*, std::size_t, std::size_t ) const -> bool;
     auto  resizeTextArea (FTermArea*, std::size_t) const -> bool;
     auto  isCovered (const FPoint&, const FTermArea*) const noexcept -> CoveredState;
+    auto  isCoveredByWindows (const FPoint&, const FTermArea*) const noexcept -> CoveredState;
+    auto  getOcclusionBox (const FTermArea*) const noexcept -> FRect;
+    void  updateOcclusionMap() const;
+    void  paintOcclusionMap (const FRect&) const;
+    void  markCellForReprint (FTermArea*, int, int) const noexcept;
     auto  isAreaValid (const FShadowBox&) const -> bool;
     auto  isSizeEqual (const FTermArea*, const FShadowBox&) const -> bool;
     constexpr auto  needsHeightResize (const FTermArea*, const std::size_t) const noexcept -> bool;
@@ -308,6 +350,7 @@ class FVTerm : public FVTermAttribute
     void  updateVTerm() const;
     void  updateVTermDesktop() const;
     void  updateVTermWindow (FTermArea*) const;
+    void  passScrollToVTerm (FTermArea*) const noexcept;
     void  scrollTerminalForward() const;
     void  scrollTerminalReverse() const;
     void  callPreprocessingHandler (const FTermArea*) const;
@@ -334,6 +377,11 @@ class FVTerm : public FVTermAttribute
     auto  changedFromTransparency (const FChar&, const FChar&) const -> bool;
     auto  printCharacterOnCoordinate ( FTermArea*
                                      , const FChar&) const noexcept -> std::size_t;
+    static auto isSingleColumnChar (wchar_t) noexcept -> bool;
+    static auto findSingleColumnRun (const FString&, std::size_t) noexcept -> std::size_t;
+    auto  printString (FTermArea*, const FString&) noexcept -> int;
+    auto  printSingleColumnRun ( FTermArea*, const wchar_t*
+                               , std::size_t ) noexcept -> std::size_t;
     void  printPaddingCharacter (FTermArea*, const FChar&) const;
     void  putNonTransparent (std::size_t&, const FChar*, FChar*&) const;
     void  addTransparent (std::size_t&, const FChar*, FChar*&) const;
@@ -349,6 +397,7 @@ class FVTerm : public FVTermAttribute
     std::unique_ptr<FTermArea>   vwin{};                     // Virtual window
     std::shared_ptr<FOutput>     foutput{};                  // Terminal output class
     std::shared_ptr<FVTermList>  window_list{};              // List of all window owner in z-order
+    std::shared_ptr<FOcclusionMap> occlusion_map{};          // Window ownership of the vterm cells
     std::shared_ptr<FTermArea>   vterm{};                    // Virtual terminal
     std::shared_ptr<FTermArea>   vterm_old{};                // Last virtual terminal
     std::shared_ptr<FTermArea>   vdesktop{};                 // Virtual desktop
@@ -365,6 +414,87 @@ class FVTerm : public FVTermAttribute
 };
 
 
+//----------------------------------------------------------------------
+// struct FVTerm::FCellPlanes
+//----------------------------------------------------------------------
+
+struct FVTerm::FCellPlanes  // Compact structure-of-arrays cell storage
+{
+  // Using-declaration
+  using FCodeVec     = std::vector<uInt32>;
+  using FGraphemeVec = std::vector<FUnicode>;
+
+  // Constant
+  static constexpr uInt32 GRAPHEME_INDEX = 0x80000000;  // Side table flag
+
+  // Accessors
+  auto getSize() const noexcept -> std::size_t;
+  auto getFChar (std::size_t) const noexcept -> FChar;
+
+  // Mutators
+  void setFChar (std::size_t, const FChar&);
+  void setFChars (std::size_t, const FChar*, std::size_t);
+  void setFChars (const FCharVector&);
+
+  // Inquiry
+  auto isEqual (std::size_t, const FChar&) const noexcept -> bool;
+
+  // Methods
+  void resize (std::size_t);
+  void fill (const FChar&);
+
+  // Data members
+  FCodeVec     code{};       // Code point or grapheme side table index
+  FCodeVec     color{};      // Foreground and background color
+  FCodeVec     attr{};       // Attributes
+  FGraphemeVec graphemes{};  // Side table for combining sequences
+};
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCellPlanes::getSize() const noexcept -> std::size_t
+{
+  return code.size();
+}
+
+//----------------------------------------------------------------------
+inline auto FVTerm::FCellPlanes::isEqual ( std::size_t index
+                                         , const FChar& fchar ) const noexcept -> bool
+{
+  // Same result as FChar::operator==, but without touching encoded_char
+
+  const auto mask = getCompareBitMask();
+
+  if ( color[index] != fchar.color.data
+    || (attr[index] & mask) != (fchar.attr.data & mask) )
+    return false;
+
+  const auto& cell_code = code[index];
+
+  if ( cell_code & GRAPHEME_INDEX )
+    return isFUnicodeEqual (graphemes[cell_code & ~GRAPHEME_INDEX], fchar.ch);
+
+  return uInt32(fchar.ch[0]) == cell_code && fchar.ch[1] == L'\0';
+}
+
+//----------------------------------------------------------------------
+inline void FVTerm::FCellPlanes::setFChar (std::size_t index, const FChar& fchar)
+{
+  if ( fchar.ch[1] == L'\0' )
+  {
+    code[index] = uInt32(fchar.ch[0]);
+  }
+  else
+  {
+    // Store combining sequences in the side table
+    code[index] = GRAPHEME_INDEX | uInt32(graphemes.size());
+    graphemes.push_back(fchar.ch);
+  }
+
+  color[index] = fchar.color.data;
+  attr[index] = fchar.attr.data;
+}
+
+
 //----------------------------------------------------------------------
 // struct FVTerm::FTermArea
 //----------------------------------------------------------------------
@@ -376,6 +506,13 @@ struct FVTerm::FTermArea  // Define virtual terminal character properties
   using FLineChangesVec = std::vector<FLineChanges>;
   using FCharVec        = std::vector<FChar>;
 
+  // Enumeration
+  enum class Layout
+  {
+    Cells,   // FChar array (data)
+    Planes   // Compact structure-of-arrays (planes)
+  };
+
   // Constructor
   FTermArea() = default;
 
@@ -410,15 +547,31 @@ struct FVTerm::FTermArea  // Define virtual terminal character properties
   auto isOverlapped (const FTermArea*) const noexcept -> bool;
   auto checkPrintPos() const noexcept -> bool;
   auto reprint (const FRect&, const FSize&) noexcept -> bool;
+  void rotateLines (int);
+
+  inline auto getIndex (int x, int y) const noexcept -> std::size_t
+  {
+    auto row = unsigned(y);
+
+    if ( row_offset > 0 && y < size.height )  // Rotated lines
+    {
+      row += unsigned(row_offset);
+
+      if ( row >= unsigned(size.height) )
+        row -= unsigned(size.height);
+    }
+
+    return row * unsigned(size.width + shadow.width) + unsigned(x);
+  }
 
   inline auto getFChar (int x, int y) const noexcept -> const FChar&
   {
-    return data[unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x)];
+    return data[getIndex(x, y)];
   }
 
   inline auto getFChar (int x, int y) noexcept -> FChar&
   {
-    return data[unsigned(y) * unsigned(size.width + shadow.width) + unsigned(x)];
+    return data[getIndex(x, y)];
   }
 
   inline auto getFChar (const FPoint& pos) const noexcept -> const FChar&
@@ -472,6 +625,9 @@ struct FVTerm::FTermArea  // Define virtual terminal character properties
   Coordinate      cursor{0, 0};          // Position for the next write operation
   Coordinate      input_cursor{-1, -1};  // Position of visible input cursor
   int             layer{-1};
+  int             row_offset{0};         // Storage row of the first line
+  int             scroll_distance{0};    // Scrolled lines since the last update
+  Layout          layout{Layout::Cells};
   Encoding        encoding{Encoding::Unknown};
   bool            input_cursor_visible{false};
   bool            has_changes{false};
@@ -481,6 +637,7 @@ struct FVTerm::FTermArea  // Define virtual terminal character properties
   FPreprocVector  preproc_list{};
   FLineChangesVec changes{};
   FCharVec        data{};                // FChar data of the drawing area
+  FCellPlanes     planes{};              // Cell data in the Layout::Planes
 };
 
 //----------------------------------------------------------------------
@@ -588,6 +745,47 @@ inline auto FVTerm::FTermArea::reprint (const FRect& box, const FSize& term_size
   return true;
 }
 
+//----------------------------------------------------------------------
+inline void FVTerm::FTermArea::rotateLines (int distance)
+{
+  // Rotates the lines of the area (without shadow) by distance lines
+  // upwards (distance > 0) or downwards (distance < 0). Only the row
+  // offset and the line changes move, the cells remain in place.
+
+  const auto height = size.height;
+
+  if ( height <= 1 )
+    return;
+
+  const auto shift = (distance % height + height) % height;
+
+  if ( shift == 0 )
+    return;
+
+  // The right shadow keeps its position
+  const auto shadow_width = std::size_t(shadow.width);
+  FCharVec right_shadow{};
+  right_shadow.reserve(std::size_t(height) * shadow_width);
+
+  for (auto y{0}; shadow_width > 0 && y < height; y++)
+  {
+    const auto* shadow_begin = &getFChar(size.width, y);
+    right_shadow.insert(right_shadow.end(), shadow_begin, shadow_begin + shadow_width);
+  }
+
+  row_offset = (row_offset + shift) % height;
+
+  for (auto y{0}; shadow_width > 0 && y < height; y++)
+  {
+    const auto* shadow_begin = &right_shadow[std::size_t(y) * shadow_width];
+    std::copy (shadow_begin, shadow_begin + shadow_width, &getFChar(size.width, y));
+  }
+
+  // The transparent character count belongs to the line content
+  std::rotate ( changes.begin()
+              , changes.begin() + shift
+              , changes.begin() + height );
+}
 
 //----------------------------------------------------------------------
 // struct FVTerm::FVTermPreprocessing
@@ -857,6 +1055,7 @@ inline void FVTerm::init()
     setGlobalFVTermInstance(this);
     foutput     = std::make_shared<FOutputType>(*this);
     window_list = std::make_shared<FVTermList>();
+    occlusion_map = std::make_shared<FOcclusionMap>();
     initSettings();
   }
   else
@@ -864,6 +1063,7 @@ inline void FVTerm::init()
     static const auto& init_object = getGlobalFVTermInstance();
     foutput     = std::shared_ptr<FOutput>(init_object->foutput);
     window_list = std::shared_ptr<FVTermList>(init_object->window_list);
+    occlusion_map = std::shared_ptr<FOcclusionMap>(init_object->occlusion_map);
     vterm       = std::shared_ptr<FTermArea>(init_object->vterm);
     vterm_old   = std::shared_ptr<FTermArea>(init_object->vterm_old);
     vdesktop    = std::shared_ptr<FTermArea>(init_object->vdesktop);
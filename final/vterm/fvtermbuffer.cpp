@@ -73,12 +73,21 @@ auto FVTermBuffer::toString() const -> FString
 //----------------------------------------------------------------------
 auto FVTermBuffer::print (const FString& string) -> int
 {
-  checkCapacity(data, data.size() + string.getLength());
+  return print (string.cbegin(), string.cend());
+}
+
+//----------------------------------------------------------------------
+auto FVTermBuffer::print ( FString::const_iterator first
+                         , FString::const_iterator last ) -> int
+{
+  const auto length = std::size_t(last - first);
+  checkCapacity(data, data.size() + length);
   getNextCharacterAttribute();
-  UnicodeBoundary ucb{string.cbegin(), string.cend(), string.cbegin(), 0};
+  UnicodeBoundary ucb{first, last, first, 0};
 
-  for (auto&& ch : string)
+  for (auto iter = first; iter != last; ++iter)
   {
+    const auto ch = *iter;
     auto width = getColumnWidth(ch);
     auto ctrl_char = std::iswcntrl(wint_t(ch));
 
@@ -105,7 +114,7 @@ auto FVTermBuffer::print (const FString& string) -> int
   if ( ucb.iter == ucb.cend )
     add(ucb);
 
-  return int(string.getLength());
+  return int(length);
 }
 
 //----------------------------------------------------------------------
@@ -117,6 +117,7 @@ class FVTermBuffer
     template <typename... Args>
     auto printf (const FString&, Args&&...) -> int;
     auto print (const FString&) -> int;
+    auto print (FString::const_iterator, FString::const_iterator) -> int;
     auto print (wchar_t) -> int;
     void print (const FStyle&) const;
     void print (const FColorPair&) const;
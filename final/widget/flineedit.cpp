@@ -366,6 +366,43 @@ void FLineEdit::onKeyPress (FKeyEvent* ev)
   }
 }
 
+//----------------------------------------------------------------------
+void FLineEdit::onPaste (FPasteEvent* ev)
+{
+  if ( isReadOnly() )
+    return;
+
+  ev->accept();
+  auto paste_text = filterPasteText(ev->getText());
+  const auto len = text.getLength();
+  const auto end_pos = ( insert_mode ) ? len : cursor_pos;
+  const auto free_space = ( max_length > end_pos ) ? max_length - end_pos : 0;
+
+  if ( paste_text.getLength() > free_space )
+  {
+    FVTerm::getFOutput()->beep();
+    paste_text = paste_text.left(free_space);
+  }
+
+  if ( paste_text.isEmpty() )
+    return;
+
+  // Insert the whole text at once
+  if ( cursor_pos == len )
+    text += paste_text;
+  else if ( insert_mode )
+    text.insert(paste_text, cursor_pos);
+  else
+    text.overwrite(paste_text, cursor_pos);
+
+  cursor_pos += paste_text.getLength();
+  print_text = ( isPasswordField() ) ? getPasswordText() : text;
+  adjustTextOffset();
+  processChanged();
+  drawInputField();
+  forceTerminalUpdate();
+}
+
 //----------------------------------------------------------------------
 void FLineEdit::onMouseDown (FMouseEvent* ev)
 {
@@ -1168,6 +1205,28 @@ inline auto FLineEdit::keyInput (FKey key) -> bool
   return false;
 }
 
+//----------------------------------------------------------------------
+auto FLineEdit::filterPasteText (const FString& str) const -> FString
+{
+  // Removes line breaks, control characters and filtered characters
+
+  std::wstring filtered{};
+  filtered.reserve(str.getLength());
+
+  for (const auto& ch : str)
+  {
+    if ( ch < 0x20 || ch > 0x10ffff || ch == 0x7f )
+      continue;
+
+    const auto c = characterFilter(ch);
+
+    if ( c != L'\0' )
+      filtered.push_back(c);
+  }
+
+  return filtered;
+}
+
 //----------------------------------------------------------------------
 inline auto FLineEdit::characterFilter (const wchar_t c) const -> wchar_t
 {
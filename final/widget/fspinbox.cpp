@@ -369,8 +369,7 @@ inline void FSpinBox::updateInputField()
 {
   input_field.clear();
   input_field << pfix << value << sfix;
-  input_field.redraw();
-  redraw();
+  update();  // Also repaints the input field
 }
 
 //----------------------------------------------------------------------
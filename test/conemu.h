@@ -989,6 +989,16 @@ inline void ConEmu::parseTerminalBuffer (std::size_t length, console con)
 
       i += 4;
     }
+    else if ( i < length - 8  // Request DEC private mode 2026 (DECRQM)
+           && std::memcmp(&buffer[i], "\033[?2026$p", 9) == 0 )
+    {
+      if ( con == console::kitty )
+        write (fd_master, "\033[?2026;2$y", 11);  // Mode reset
+      else if ( con == console::xterm )
+        write (fd_master, "\033[?2026;0$y", 11);  // Not recognized
+
+      i += 8;  // The following DA request must not be skipped
+    }
     else if ( i < length - 4  // Report xterm window's title
            && buffer[i] == '\033'
            && buffer[i + 1] == '['
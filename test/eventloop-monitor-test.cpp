@@ -28,9 +28,15 @@
 #include <cppunit/TestResultCollector.h>
 #include <cppunit/TestRunner.h>
 
+#include <sys/uio.h>
+
+#include <algorithm>
 #include <chrono>
+#include <cstdio>
+#include <memory>
 #include <queue>
 #include <string>
+#include <vector>
 
 #include <final/final.h>
 #define USE_FINAL_H
@@ -218,6 +224,7 @@ class FSystemTest : public finalcut::FSystem
     auto fputs (const char*, FILE*) -> int override;
     auto fclose (FILE*) -> int override;
     auto putchar (int) -> int override;
+    auto writev (int, const struct iovec*, int) -> ssize_t override;
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction*) -> int override;
     auto timer_create ( clockid_t, struct sigevent*
@@ -357,6 +364,12 @@ inline auto FSystemTest::putchar (int c) -> int
 #endif
 }
 
+//----------------------------------------------------------------------
+inline auto FSystemTest::writev (int fd, const struct iovec* iov, int iovcnt) -> ssize_t
+{
+  return ::writev(fd, iov, iovcnt);
+}
+
 //----------------------------------------------------------------------
 inline auto FSystemTest::sigaction ( int signum
                                    , const struct sigaction* act
@@ -603,6 +616,7 @@ class EventloopMonitorTest : public CPPUNIT_NS::TestFixture
     void SignalMonitorTest();
     void TimerMonitorTest();
     void BackendMonitorTest();
+    void manyMonitorsTest();
     void exceptionTest();
 
   private:
@@ -623,6 +637,7 @@ class EventloopMonitorTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (SignalMonitorTest);
     CPPUNIT_TEST (TimerMonitorTest);
     CPPUNIT_TEST (BackendMonitorTest);
+    CPPUNIT_TEST (manyMonitorsTest);
     CPPUNIT_TEST (exceptionTest);
 
     // End of test suite definition
@@ -915,6 +930,80 @@ void EventloopMonitorTest::BackendMonitorTest()
   CPPUNIT_ASSERT ( string_parser.getQueue().empty() );
 }
 
+//----------------------------------------------------------------------
+void EventloopMonitorTest::manyMonitorsTest()
+{
+  // More monitors than the former limit of 50 monitors
+  constexpr std::size_t number_of_pipes{200};
+  finalcut::EventLoop eloop{};
+  auto eloop_ptr = &eloop;
+  std::vector<std::array<int, 2>> pipes(number_of_pipes);
+  std::vector<std::unique_ptr<finalcut::IoMonitor>> io_monitors{};
+  std::vector<int> triggered{};
+
+  for (std::size_t i{0}; i < number_of_pipes; i++)
+  {
+    CPPUNIT_ASSERT ( ::pipe(pipes[i].data()) == 0 );
+    auto callback_handler = [i, &pipes, &triggered, eloop_ptr] (const finalcut::Monitor*, short)
+    {
+      char buf{'\0'};
+      CPPUNIT_ASSERT ( ::read(pipes[i][0], &buf, 1) == 1 );
+      triggered.push_back(int(i));
+
+      if ( triggered.size() == 2 )
+        eloop_ptr->leave();
+    };
+    io_monitors.emplace_back(std::make_unique<finalcut::IoMonitor>(&eloop));
+    io_monitors.back()->init (pipes[i][0], POLLIN, callback_handler, nullptr);
+    io_monitors.back()->resume();
+  }
+
+  CPPUNIT_ASSERT ( ::write(pipes[199][1], "x", 1) == 1 );
+  CPPUNIT_ASSERT ( ::write(pipes[120][1], "y", 1) == 1 );
+  CPPUNIT_ASSERT ( eloop.run() == 0 );  // Run event loop
+  CPPUNIT_ASSERT ( triggered.size() == 2 );
+  CPPUNIT_ASSERT ( std::find(triggered.begin(), triggered.end(), 199) != triggered.end() );
+  CPPUNIT_ASSERT ( std::find(triggered.begin(), triggered.end(), 120) != triggered.end() );
+
+  // A suspended monitor is no longer triggered
+  triggered.clear();
+  io_monitors[10]->suspend();
+  CPPUNIT_ASSERT ( ::write(pipes[10][1], "z", 1) == 1 );
+  CPPUNIT_ASSERT ( ! eloop.processEvents(10) );
+  CPPUNIT_ASSERT ( triggered.empty() );
+  io_monitors[10]->resume();
+  CPPUNIT_ASSERT ( eloop.processEvents(10) );
+  CPPUNIT_ASSERT ( triggered.size() == 1 );
+  CPPUNIT_ASSERT ( triggered[0] == 10 );
+
+  // Removed monitors
+  io_monitors.erase(io_monitors.begin() + 50, io_monitors.end());
+  CPPUNIT_ASSERT ( ::write(pipes[150][1], "w", 1) == 1 );
+  CPPUNIT_ASSERT ( ! eloop.processEvents(10) );
+  io_monitors.clear();
+
+  // A regular file is always readable
+  std::FILE* file = std::tmpfile();
+  CPPUNIT_ASSERT ( file != nullptr );
+  int file_events{0};
+  finalcut::IoMonitor file_monitor{&eloop};
+  auto file_handler = [&file_events] (const finalcut::Monitor*, short)
+  {
+    file_events++;
+  };
+  file_monitor.init (fileno(file), POLLIN, file_handler, nullptr);
+  file_monitor.resume();
+  CPPUNIT_ASSERT ( eloop.processEvents(finalcut::EventLoop::WAIT_INDEFINITELY) );
+  CPPUNIT_ASSERT ( file_events == 1 );
+  std::fclose(file);
+
+  for (const auto& pipe_fd : pipes)
+  {
+    ::close(pipe_fd[0]);
+    ::close(pipe_fd[1]);
+  }
+}
+
 //----------------------------------------------------------------------
 void EventloopMonitorTest::exceptionTest()
 {
@@ -63,6 +63,7 @@ class FEventTest : public CPPUNIT_NS::TestFixture
   protected:
     void feventTest();
     void fkeyeventTest();
+    void fpasteeventTest();
     void fmouseeventTest();
     void fwheeleventTest();
     void ffocuseventTest();
@@ -81,6 +82,7 @@ class FEventTest : public CPPUNIT_NS::TestFixture
     // Add a methods to the test suite
     CPPUNIT_TEST (feventTest);
     CPPUNIT_TEST (fkeyeventTest);
+    CPPUNIT_TEST (fpasteeventTest);
     CPPUNIT_TEST (fmouseeventTest);
     CPPUNIT_TEST (fwheeleventTest);
     CPPUNIT_TEST (ffocuseventTest);
@@ -210,6 +212,28 @@ void FEventTest::fkeyeventTest()
   CPPUNIT_ASSERT ( ! event3.isAccepted() );
 }
 
+//----------------------------------------------------------------------
+void FEventTest::fpasteeventTest()
+{
+  finalcut::FPasteEvent event (finalcut::Event::Paste, "pasted text");
+  CPPUNIT_ASSERT ( event.getType() == finalcut::Event::Paste );
+  CPPUNIT_ASSERT ( event.getText() == "pasted text" );
+  CPPUNIT_ASSERT ( ! event.isAccepted() );  // reject by default
+  event.accept();
+  CPPUNIT_ASSERT ( event.isAccepted() );
+  event.ignore();
+  CPPUNIT_ASSERT ( ! event.isAccepted() );
+
+  finalcut::FPasteEvent event1 (finalcut::Event::Paste, L"\U0001f600 line 1\nline 2");
+  CPPUNIT_ASSERT ( event1.getType() == finalcut::Event::Paste );
+  CPPUNIT_ASSERT ( event1.getText() == L"\U0001f600 line 1\nline 2" );
+  CPPUNIT_ASSERT ( event1.getText().getLength() == 15 );
+  CPPUNIT_ASSERT ( ! event1.isAccepted() );
+
+  finalcut::FPasteEvent event2 (finalcut::Event::Paste, finalcut::FString{});
+  CPPUNIT_ASSERT ( event2.getText().isEmpty() );
+}
+
 //----------------------------------------------------------------------
 void FEventTest::fmouseeventTest()
 {
@@ -0,0 +1,258 @@
+/***********************************************************************
+* fframepacer-test.cpp - FFramePacer unit tests                        *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <stdexcept>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FFramePacerTest
+//----------------------------------------------------------------------
+
+class FFramePacerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FFramePacerTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void pacingModeTest();
+    void frameTimeTest();
+    void throughputTest();
+    void frameDropTest();
+    void resetTest();
+
+  private:
+    using Pacer = finalcut::FFramePacer;
+    using Pacing = finalcut::FramePacing;
+
+    // Helper
+    static auto at (int) -> TimeValue;  // Time in milliseconds
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FFramePacerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (pacingModeTest);
+    CPPUNIT_TEST (frameTimeTest);
+    CPPUNIT_TEST (throughputTest);
+    CPPUNIT_TEST (frameDropTest);
+    CPPUNIT_TEST (resetTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+auto FFramePacerTest::at (int msec) -> TimeValue
+{
+  static const TimeValue start = TimeValue{} + std::chrono::hours(1);
+  return start + std::chrono::milliseconds(msec);
+}
+
+//----------------------------------------------------------------------
+void FFramePacerTest::classNameTest()
+{
+  const finalcut::FString& classname = Pacer::getClassName();
+  CPPUNIT_ASSERT ( classname == "FFramePacer" );
+}
+
+//----------------------------------------------------------------------
+void FFramePacerTest::noArgumentTest()
+{
+  const Pacer pacer{};
+  CPPUNIT_ASSERT ( pacer.getPacing() == Pacing::Adaptive );
+  CPPUNIT_ASSERT ( pacer.getTargetFrameRate() == Pacer::DEFAULT_FRAME_RATE );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == Pacer::MIN_FRAME_TIME );
+  CPPUNIT_ASSERT ( pacer.getBytesPerFrame() == 0 );
+  CPPUNIT_ASSERT ( pacer.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( pacer.getWriteLatency() == 0 );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 0 );
+  CPPUNIT_ASSERT ( ! pacer.isBehind(0) );
+  CPPUNIT_ASSERT ( ! pacer.isBehind(Pacer::MIN_BACKLOG) );
+  CPPUNIT_ASSERT ( pacer.isBehind(Pacer::MIN_BACKLOG + 1) );
+}
+
+//----------------------------------------------------------------------
+void FFramePacerTest::pacingModeTest()
+{
+  Pacer pacer{};
+  pacer.setTargetFrameRate(30);
+  CPPUNIT_ASSERT ( pacer.getPacing() == Pacing::TargetRate );
+  CPPUNIT_ASSERT ( pacer.getTargetFrameRate() == 30 );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == 33'333 );
+  CPPUNIT_ASSERT_THROW ( pacer.setTargetFrameRate(0), std::invalid_argument );
+  CPPUNIT_ASSERT ( pacer.getTargetFrameRate() == 30 );
+
+  pacer.frameWritten (at(0), 1'000, 0);
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(20)) );
+  CPPUNIT_ASSERT ( pacer.isFrameDue(at(34)) );
+
+  // An unthrottled output writes every frame immediately
+  pacer.setPacing (Pacing::Unthrottled);
+  CPPUNIT_ASSERT ( pacer.getPacing() == Pacing::Unthrottled );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == 0 );
+  CPPUNIT_ASSERT ( ! pacer.isBehind(1'000'000) );
+  pacer.frameWritten (at(40), 1'000, 0);
+  pacer.recordBacklog (at(40), 1'000'000);
+  CPPUNIT_ASSERT ( pacer.isFrameDue(at(40)) );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 0 );
+
+  pacer.setPacing (Pacing::Adaptive);
+  CPPUNIT_ASSERT ( pacer.getPacing() == Pacing::Adaptive );
+  CPPUNIT_ASSERT ( pacer.getTargetFrameRate() == 30 );
+}
+
+//----------------------------------------------------------------------
+void FFramePacerTest::frameTimeTest()
+{
+  // Without a backlog, the adaptive mode runs with up to 120 Hz
+  Pacer pacer{};
+  pacer.frameWritten (at(0), 1'000, 0);
+  CPPUNIT_ASSERT ( pacer.getBytesPerFrame() == 1'000 );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == Pacer::MIN_FRAME_TIME );
+  CPPUNIT_ASSERT ( pacer.getNextFrameTime()
+                   == at(0) + std::chrono::microseconds(Pacer::MIN_FRAME_TIME) );
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(1)) );
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(8)) );
+  CPPUNIT_ASSERT ( pacer.isFrameDue(at(9)) );
+
+  // Moving average of the frame size
+  pacer.frameWritten (at(9), 5'000, 0);
+  CPPUNIT_ASSERT ( pacer.getBytesPerFrame() == 2'000 );
+}
+
+//----------------------------------------------------------------------
+void FFramePacerTest::throughputTest()
+{
+  Pacer pacer{};
+  pacer.frameWritten (at(0), 10'000, 10'000);
+  CPPUNIT_ASSERT ( pacer.getThroughput() == 0 );
+
+  // 5000 bytes in 10 ms
+  pacer.measure (at(10), 5'000);
+  CPPUNIT_ASSERT ( pacer.getThroughput() == 500'000 );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == 20'000 );
+  CPPUNIT_ASSERT ( pacer.getWriteLatency() == 0 );
+
+  // The backlog is empty 20 ms after the write
+  pacer.measure (at(20), 0);
+  CPPUNIT_ASSERT ( pacer.getThroughput() == 500'000 );
+  CPPUNIT_ASSERT ( pacer.getWriteLatency() == 20'000 );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == 20'000 );
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(19)) );
+  CPPUNIT_ASSERT ( pacer.isFrameDue(at(20)) );
+
+  // An immediately accepted frame reduces the write latency
+  pacer.frameWritten (at(20), 10'000, 0);
+  CPPUNIT_ASSERT ( pacer.getWriteLatency() == 15'000 );
+
+  // The frame time never exceeds the upper limit
+  pacer.frameWritten (at(40), 1'000'000, 1'000'000);
+  pacer.measure (at(50), 999'000);
+  CPPUNIT_ASSERT ( pacer.getThroughput() < 500'000 );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == Pacer::MAX_FRAME_TIME );
+}
+
+//----------------------------------------------------------------------
+void FFramePacerTest::frameDropTest()
+{
+  Pacer pacer{};
+  pacer.frameWritten (at(0), 5'000, 20'000);
+  CPPUNIT_ASSERT ( pacer.isBehind(20'000) );
+
+  // The link falls behind: the frame is held back
+  pacer.recordBacklog (at(10), 15'000);
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(10)) );
+  CPPUNIT_ASSERT ( pacer.getThroughput() == 500'000 );
+  CPPUNIT_ASSERT ( pacer.getFrameTime() == 10'000 );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 1 );
+
+  // Only one dropped frame is counted per frame time
+  pacer.recordBacklog (at(12), 14'000);
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(12)) );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 1 );
+
+  // The query without a backlog sample changes nothing
+  const auto& const_pacer = pacer;
+  CPPUNIT_ASSERT ( ! const_pacer.isFrameDue(at(25)) );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 1 );
+  CPPUNIT_ASSERT ( pacer.getNextFrameTime() == at(30) );
+
+  // Next attempt after the backlog is reduced to one frame
+  // (9000 bytes with 500000 bytes/s = 18 ms)
+  CPPUNIT_ASSERT ( pacer.getNextFrameTime() == at(30) );
+  pacer.recordBacklog (at(21), 13'000);
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(21)) );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 2 );
+
+  // The terminal has caught up
+  pacer.recordBacklog (at(30), 4'000);
+  CPPUNIT_ASSERT ( pacer.isFrameDue(at(30)) );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 2 );
+  pacer.frameWritten (at(30), 5'000, 9'000);
+  CPPUNIT_ASSERT ( pacer.getFrameTime() > 9'000 );
+  CPPUNIT_ASSERT ( pacer.getNextFrameTime()
+                   == at(30) + std::chrono::microseconds(pacer.getFrameTime()) );
+}
+
+//----------------------------------------------------------------------
+void FFramePacerTest::resetTest()
+{
+  Pacer pacer{};
+  pacer.setTargetFrameRate(50);
+  pacer.frameWritten (at(0), 5'000, 20'000);
+  pacer.recordBacklog (at(20), 15'000);
+  CPPUNIT_ASSERT ( ! pacer.isFrameDue(at(20)) );
+  CPPUNIT_ASSERT ( pacer.getBytesPerFrame() == 5'000 );
+  CPPUNIT_ASSERT ( pacer.getThroughput() > 0 );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 1 );
+
+  pacer.reset();
+  CPPUNIT_ASSERT ( pacer.getPacing() == Pacing::TargetRate );
+  CPPUNIT_ASSERT ( pacer.getTargetFrameRate() == 50 );
+  CPPUNIT_ASSERT ( pacer.getBytesPerFrame() == 0 );
+  CPPUNIT_ASSERT ( pacer.getThroughput() == 0 );
+  CPPUNIT_ASSERT ( pacer.getWriteLatency() == 0 );
+  CPPUNIT_ASSERT ( pacer.getDroppedFrames() == 0 );
+  CPPUNIT_ASSERT ( pacer.getNextFrameTime()
+                   == TimeValue{} + std::chrono::milliseconds(20) );
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FFramePacerTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,251 @@
+/***********************************************************************
+* fframeprofiler-test.cpp - FFrameProfiler unit tests                  *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FFrameProfilerTest
+//----------------------------------------------------------------------
+
+class FFrameProfilerTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FFrameProfilerTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void frameRingTest();
+    void capacityTest();
+    void phaseTest();
+
+  private:
+    using Profiler = finalcut::FFrameProfiler;
+    using Phase = Profiler::Phase;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FFrameProfilerTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (frameRingTest);
+    CPPUNIT_TEST (capacityTest);
+    CPPUNIT_TEST (phaseTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FFrameProfilerTest::classNameTest()
+{
+  const finalcut::FString& classname = Profiler::getClassName();
+  CPPUNIT_ASSERT ( classname == "FFrameProfiler" );
+}
+
+//----------------------------------------------------------------------
+void FFrameProfilerTest::noArgumentTest()
+{
+  Profiler profiler{};
+  CPPUNIT_ASSERT ( ! profiler.isEnabled() );
+  CPPUNIT_ASSERT ( ! profiler.isLogging() );
+  CPPUNIT_ASSERT ( profiler.getCapacity() == Profiler::DEFAULT_CAPACITY );
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( profiler.getFrames().empty() );
+  CPPUNIT_ASSERT_THROW ( profiler.getFrame(0), std::out_of_range );
+
+  // A disabled profiler discards all frames
+  profiler.addCellsEmitted(10);
+  profiler.addBytesWritten(20);
+  CPPUNIT_ASSERT ( profiler.getCurrentFrame().cells_emitted == 10 );
+  profiler.finishFrame();
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( profiler.getCurrentFrame().cells_emitted == 0 );
+  CPPUNIT_ASSERT ( profiler.getCurrentFrame().bytes_written == 0 );
+
+  const Profiler::FrameRecord record{};
+  CPPUNIT_ASSERT ( record.frame == 0 );
+  CPPUNIT_ASSERT ( record.getTotalTime() == Profiler::Duration::zero() );
+  CPPUNIT_ASSERT ( record.getTime(Phase::None) == Profiler::Duration::zero() );
+
+  profiler.setLogging();
+  CPPUNIT_ASSERT ( profiler.isLogging() );
+  profiler.unsetLogging();
+  CPPUNIT_ASSERT ( ! profiler.isLogging() );
+}
+
+//----------------------------------------------------------------------
+void FFrameProfilerTest::frameRingTest()
+{
+  Profiler profiler{};
+  profiler.enable();
+  CPPUNIT_ASSERT ( profiler.isEnabled() );
+
+  // Frames without output are not recorded
+  profiler.addCellsCompared(80);
+  profiler.finishFrame();
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 0 );
+
+  for (uInt64 i{1}; i <= 3; i++)
+  {
+    profiler.addCellsCompared(100 * i);
+    profiler.addCellsEmitted(10 * i);
+    profiler.addBytesWritten(i);
+    profiler.finishFrame();
+  }
+
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 3 );
+  CPPUNIT_ASSERT ( profiler.getFrame(0).frame == 3 );
+  CPPUNIT_ASSERT ( profiler.getFrame(0).cells_compared == 300 );
+  CPPUNIT_ASSERT ( profiler.getFrame(0).cells_emitted == 30 );
+  CPPUNIT_ASSERT ( profiler.getFrame(0).bytes_written == 3 );
+  CPPUNIT_ASSERT ( profiler.getFrame(2).frame == 1 );
+  CPPUNIT_ASSERT ( profiler.getFrame(2).cells_compared == 100 );
+  CPPUNIT_ASSERT ( profiler.getFrame(0).end_time >= profiler.getFrame(2).end_time );
+  CPPUNIT_ASSERT_THROW ( profiler.getFrame(3), std::out_of_range );
+
+  const auto frames = profiler.getFrames();  // Oldest first
+  CPPUNIT_ASSERT ( frames.size() == 3 );
+  CPPUNIT_ASSERT ( frames[0].frame == 1 );
+  CPPUNIT_ASSERT ( frames[1].frame == 2 );
+  CPPUNIT_ASSERT ( frames[2].frame == 3 );
+
+  profiler.clear();
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 0 );
+  CPPUNIT_ASSERT ( profiler.getFrames().empty() );
+
+  // The frame numbering continues after clear()
+  profiler.addBytesWritten(1);
+  profiler.finishFrame();
+  CPPUNIT_ASSERT ( profiler.getFrame(0).frame == 4 );
+
+  profiler.disable();
+  CPPUNIT_ASSERT ( ! profiler.isEnabled() );
+  profiler.addBytesWritten(1);
+  profiler.finishFrame();
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 1 );
+}
+
+//----------------------------------------------------------------------
+void FFrameProfilerTest::capacityTest()
+{
+  Profiler profiler{};
+  CPPUNIT_ASSERT_THROW ( profiler.setCapacity(0), std::invalid_argument );
+  profiler.setCapacity(4);
+  CPPUNIT_ASSERT ( profiler.getCapacity() == 4 );
+  profiler.enable();
+
+  for (uInt64 i{1}; i <= 10; i++)
+  {
+    profiler.addBytesWritten(i);
+    profiler.finishFrame();
+  }
+
+  // Only the newest frames are kept
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 4 );
+  CPPUNIT_ASSERT ( profiler.getFrame(0).bytes_written == 10 );
+  CPPUNIT_ASSERT ( profiler.getFrame(3).bytes_written == 7 );
+
+  profiler.setCapacity(2);
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 2 );
+  CPPUNIT_ASSERT ( profiler.getFrame(0).bytes_written == 10 );
+  CPPUNIT_ASSERT ( profiler.getFrame(1).bytes_written == 9 );
+
+  profiler.setCapacity(8);
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 2 );
+  profiler.addBytesWritten(11);
+  profiler.finishFrame();
+  const auto frames = profiler.getFrames();
+  CPPUNIT_ASSERT ( frames.size() == 3 );
+  CPPUNIT_ASSERT ( frames[0].bytes_written == 9 );
+  CPPUNIT_ASSERT ( frames[1].bytes_written == 10 );
+  CPPUNIT_ASSERT ( frames[2].bytes_written == 11 );
+}
+
+//----------------------------------------------------------------------
+void FFrameProfilerTest::phaseTest()
+{
+  using std::chrono::milliseconds;
+  auto& profiler = Profiler::getInstance();
+  CPPUNIT_ASSERT ( ! profiler.isEnabled() );
+
+  {
+    // No time measurement while the profiler is disabled
+    Profiler::ScopedPhase draw_phase{Phase::Draw};
+    std::this_thread::sleep_for(milliseconds(2));
+  }
+
+  CPPUNIT_ASSERT ( profiler.getCurrentFrame().getTotalTime() == Profiler::Duration::zero() );
+  profiler.enable();
+
+  {
+    Profiler::ScopedPhase draw_phase{Phase::Draw};
+    std::this_thread::sleep_for(milliseconds(2));
+
+    {
+      // A nested phase pauses the outer phase
+      Profiler::ScopedPhase encode_phase{Phase::Encode};
+      std::this_thread::sleep_for(milliseconds(5));
+    }
+  }
+
+  profiler.finishFrame();
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 1 );
+  const auto& frame = profiler.getFrame(0);
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Draw) >= milliseconds(2) );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Draw) < milliseconds(5) );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Encode) >= milliseconds(5) );
+  CPPUNIT_ASSERT ( frame.getTime(Phase::Compose) == Profiler::Duration::zero() );
+  CPPUNIT_ASSERT ( frame.getTotalTime() == frame.getTime(Phase::Draw)
+                                         + frame.getTime(Phase::Encode) );
+
+  // Frames with only compose and diff time are discarded
+  {
+    Profiler::ScopedPhase compose_phase{Phase::Compose};
+    Profiler::ScopedPhase diff_phase{Phase::Diff};
+  }
+
+  profiler.finishFrame();
+  CPPUNIT_ASSERT ( profiler.getFrameCount() == 1 );
+  profiler.disable();
+  profiler.clear();
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FFrameProfilerTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -0,0 +1,303 @@
+/***********************************************************************
+* fheadlessoutput-test.cpp - FHeadlessOutput unit tests                *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <memory>
+#include <string>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FHeadlessVTerm
+//----------------------------------------------------------------------
+
+class FHeadlessVTerm : public finalcut::FVTerm
+{
+  public:
+    // Constructor
+    FHeadlessVTerm();
+
+    // Accessor
+    auto getHeadlessOutput() const -> finalcut::FHeadlessOutput*;
+
+    // Methods
+    void render() const;
+};
+
+//----------------------------------------------------------------------
+inline FHeadlessVTerm::FHeadlessVTerm()
+  : finalcut::FVTerm{finalcut::outputClass<finalcut::FHeadlessOutput>{}}
+{
+  initTerminal();
+}
+
+//----------------------------------------------------------------------
+inline auto FHeadlessVTerm::getHeadlessOutput() const -> finalcut::FHeadlessOutput*
+{
+  return static_cast<finalcut::FHeadlessOutput*>(getFOutput().get());
+}
+
+//----------------------------------------------------------------------
+inline void FHeadlessVTerm::render() const
+{
+  finishDrawing();
+  processTerminalUpdate();
+  flush();
+}
+
+
+//----------------------------------------------------------------------
+// class FHeadlessOutputTest
+//----------------------------------------------------------------------
+
+class FHeadlessOutputTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FHeadlessOutputTest() = default;
+
+  protected:
+    void classNameTest();
+    void profileTest();
+    void xtermOutputTest();
+    void vt100OutputTest();
+    void resizeTest();
+
+  private:
+    using Profile = finalcut::FHeadlessOutput::TermProfile;
+
+    // Methods
+    static auto countOf (const std::string&, const std::string&) -> std::size_t;
+    static auto getString (finalcut::Termcap) -> const char*;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FHeadlessOutputTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (profileTest);
+    CPPUNIT_TEST (xtermOutputTest);
+    CPPUNIT_TEST (vt100OutputTest);
+    CPPUNIT_TEST (resizeTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+auto FHeadlessOutputTest::countOf ( const std::string& haystack
+                                  , const std::string& needle ) -> std::size_t
+{
+  std::size_t count{0};
+  auto pos = haystack.find(needle);
+
+  while ( pos != std::string::npos )
+  {
+    count++;
+    pos = haystack.find(needle, pos + needle.length());
+  }
+
+  return count;
+}
+
+//----------------------------------------------------------------------
+auto FHeadlessOutputTest::getString (finalcut::Termcap cap) -> const char*
+{
+  return finalcut::FTermcap::strings[std::size_t(cap)].string;
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::classNameTest()
+{
+  finalcut::FHeadlessOutput::setProfile (finalcut::FHeadlessOutput::getXTermProfile());
+  FHeadlessVTerm vterm{};
+  const finalcut::FString& classname = vterm.getHeadlessOutput()->getClassName();
+  CPPUNIT_ASSERT ( classname == "FHeadlessOutput" );
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::profileTest()
+{
+  const auto has_capability = [] (const Profile& p, finalcut::Termcap cap)
+  {
+    return std::any_of ( p.capabilities.cbegin(), p.capabilities.cend()
+                       , [cap] (const Profile::Capability& c)
+                         {
+                           return c.first == cap && c.second;
+                         } );
+  };
+
+  const auto xterm = finalcut::FHeadlessOutput::getXTermProfile();
+  CPPUNIT_ASSERT ( xterm.name == "xterm-256color" );
+  CPPUNIT_ASSERT ( xterm.encoding == finalcut::Encoding::UTF8 );
+  CPPUNIT_ASSERT ( xterm.max_color == 256 );
+  CPPUNIT_ASSERT ( xterm.size == finalcut::FSize(80, 24) );
+  CPPUNIT_ASSERT ( xterm.background_color_erase );
+  CPPUNIT_ASSERT ( has_capability(xterm, finalcut::Termcap::t_cursor_address) );
+  CPPUNIT_ASSERT ( has_capability(xterm, finalcut::Termcap::t_repeat_char) );
+  CPPUNIT_ASSERT ( has_capability(xterm, finalcut::Termcap::t_set_a_foreground) );
+
+  const auto vt100 = finalcut::FHeadlessOutput::getVT100Profile();
+  CPPUNIT_ASSERT ( vt100.name == "vt100" );
+  CPPUNIT_ASSERT ( vt100.encoding == finalcut::Encoding::VT100 );
+  CPPUNIT_ASSERT ( vt100.max_color == 1 );
+  CPPUNIT_ASSERT ( ! vt100.background_color_erase );
+  CPPUNIT_ASSERT ( has_capability(vt100, finalcut::Termcap::t_cursor_address) );
+  CPPUNIT_ASSERT ( ! has_capability(vt100, finalcut::Termcap::t_repeat_char) );
+  CPPUNIT_ASSERT ( ! has_capability(vt100, finalcut::Termcap::t_set_a_foreground) );
+
+  auto small = xterm;
+  small.size = finalcut::FSize{40, 10};
+  finalcut::FHeadlessOutput::setProfile (small);
+  CPPUNIT_ASSERT ( finalcut::FHeadlessOutput::getProfile().size == finalcut::FSize(40, 10) );
+  finalcut::FHeadlessOutput::setProfile (xterm);
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::xtermOutputTest()
+{
+  auto profile = finalcut::FHeadlessOutput::getXTermProfile();
+  profile.size = finalcut::FSize{40, 10};
+  finalcut::FHeadlessOutput::setProfile (profile);
+  FHeadlessVTerm vterm{};
+  auto output = vterm.getHeadlessOutput();
+  CPPUNIT_ASSERT ( output->getColumnNumber() == 40 );
+  CPPUNIT_ASSERT ( output->getLineNumber() == 10 );
+  CPPUNIT_ASSERT ( output->getMaxColor() == 256 );
+  CPPUNIT_ASSERT ( output->getEncoding() == finalcut::Encoding::UTF8 );
+  CPPUNIT_ASSERT ( output->isFlushTimeout() );
+  CPPUNIT_ASSERT ( ! output->canChangeColorPalette() );
+  CPPUNIT_ASSERT ( output->getOutput().find(CSI "?25l") != std::string::npos );
+
+  // The termcap capabilities come from the profile
+  CPPUNIT_ASSERT ( finalcut::FTermcap::isInitialized() );
+  CPPUNIT_ASSERT ( finalcut::FTermcap::max_color == 256 );
+  CPPUNIT_ASSERT ( std::string(getString(finalcut::Termcap::t_cursor_address)) == CSI "%i%p1%d;%p2%dH" );
+  CPPUNIT_ASSERT ( getString(finalcut::Termcap::t_flash_screen) == nullptr );
+
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  output->clearOutput();
+
+  // Initial screen
+  vterm.print() << finalcut::FPoint{1, 1} << "Headless";
+  vterm.render();
+  const auto first = output->getOutput();
+  CPPUNIT_ASSERT ( ! first.empty() );
+  CPPUNIT_ASSERT ( first.find("Headless") != std::string::npos );
+
+  // Without changes there is no output
+  output->clearOutput();
+  CPPUNIT_ASSERT ( output->getOutput().empty() );
+  vterm.render();
+  CPPUNIT_ASSERT ( output->getOutput().empty() );
+
+  // A single changed character is reached with a cursor motion
+  vterm.print() << finalcut::FPoint{20, 6} << 'X';
+  vterm.render();
+  const auto& second = output->getOutput();
+  CPPUNIT_ASSERT ( ! second.empty() );
+  CPPUNIT_ASSERT ( second.length() < first.length() );
+  CPPUNIT_ASSERT ( second.find(CSI "6;20H") != std::string::npos );
+  CPPUNIT_ASSERT ( second.find('X') != std::string::npos );
+  CPPUNIT_ASSERT ( countOf(second, "Headless") == 0 );
+
+  // Colors are written with the profile sequences
+  output->clearOutput();
+  vterm.print() << finalcut::FPoint{1, 2}
+                << finalcut::FColorPair{finalcut::FColor::Red, finalcut::FColor::Blue}
+                << "color";
+  vterm.render();
+  CPPUNIT_ASSERT ( output->getOutput().find("44m") != std::string::npos );
+  CPPUNIT_ASSERT ( output->getOutput().find("color") != std::string::npos );
+
+  // The closing output also goes to the memory buffer
+  output->clearOutput();
+  output->finishTerminal();
+  CPPUNIT_ASSERT ( output->getOutput().find(CSI "?25h") != std::string::npos );
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::vt100OutputTest()
+{
+  auto profile = finalcut::FHeadlessOutput::getVT100Profile();
+  profile.size = finalcut::FSize{40, 10};
+  finalcut::FHeadlessOutput::setProfile (profile);
+  FHeadlessVTerm vterm{};
+  auto output = vterm.getHeadlessOutput();
+  CPPUNIT_ASSERT ( output->getColumnNumber() == 40 );
+  CPPUNIT_ASSERT ( output->getLineNumber() == 10 );
+  CPPUNIT_ASSERT ( output->isMonochron() );
+  CPPUNIT_ASSERT ( output->getEncoding() == finalcut::Encoding::VT100 );
+  CPPUNIT_ASSERT ( output->getMaxColor() == 1 );
+  CPPUNIT_ASSERT ( getString(finalcut::Termcap::t_back_tab) == nullptr );
+
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  output->clearOutput();
+
+  vterm.print() << finalcut::FPoint{5, 3} << "vt100";
+  vterm.render();
+  const auto& out = output->getOutput();
+  CPPUNIT_ASSERT ( out.find("vt100") != std::string::npos );
+
+  // The padding delays are removed from the output
+  CPPUNIT_ASSERT ( out.find("$<") == std::string::npos );
+
+  // No color sequences on a monochrome terminal
+  CPPUNIT_ASSERT ( out.find(CSI "38;5;") == std::string::npos );
+  CPPUNIT_ASSERT ( out.find(CSI "48;5;") == std::string::npos );
+  finalcut::FHeadlessOutput::setProfile (finalcut::FHeadlessOutput::getXTermProfile());
+}
+
+//----------------------------------------------------------------------
+void FHeadlessOutputTest::resizeTest()
+{
+  finalcut::FHeadlessOutput::setProfile (finalcut::FHeadlessOutput::getXTermProfile());
+  FHeadlessVTerm vterm{};
+  auto output = vterm.getHeadlessOutput();
+  CPPUNIT_ASSERT ( output->getColumnNumber() == 80 );
+  CPPUNIT_ASSERT ( output->getLineNumber() == 24 );
+  CPPUNIT_ASSERT ( output->allowsTerminalSizeManipulation() );
+  CPPUNIT_ASSERT ( ! output->hasTerminalResized() );
+
+  output->setTerminalSize (finalcut::FSize{100, 30});
+  CPPUNIT_ASSERT ( output->hasTerminalResized() );
+  CPPUNIT_ASSERT ( output->getColumnNumber() == 100 );
+  CPPUNIT_ASSERT ( output->getLineNumber() == 30 );
+  output->commitTerminalResize();
+  CPPUNIT_ASSERT ( ! output->hasTerminalResized() );
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FHeadlessOutputTest);
+
+// The general unit test main part
+#include <main-test.inc>
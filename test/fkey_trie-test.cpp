@@ -0,0 +1,196 @@
+/***********************************************************************
+* fkey_trie-test.cpp - FKeyTrie unit tests                             *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <cstring>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FKeyTrieTest
+//----------------------------------------------------------------------
+
+class FKeyTrieTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FKeyTrieTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void insertTest();
+    void advanceTest();
+    void keyMapTest();
+
+  private:
+    using Match = finalcut::FKeyTrie::Match;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FKeyTrieTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (insertTest);
+    CPPUNIT_TEST (advanceTest);
+    CPPUNIT_TEST (keyMapTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FKeyTrieTest::classNameTest()
+{
+  const finalcut::FString& classname = finalcut::FKeyTrie::getClassName();
+  CPPUNIT_ASSERT ( classname == "FKeyTrie" );
+}
+
+//----------------------------------------------------------------------
+void FKeyTrieTest::noArgumentTest()
+{
+  const finalcut::FKeyTrie trie{};
+  CPPUNIT_ASSERT ( trie.getNodeCount() == 1 );  // Root node
+  CPPUNIT_ASSERT ( trie.find("", 0) == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( trie.find("\033[A", 3) == finalcut::FKey::None );
+
+  finalcut::FKeyTrie::Cursor cursor{};
+  CPPUNIT_ASSERT ( cursor.depth == 0 );
+  CPPUNIT_ASSERT ( cursor.match == Match::Prefix );
+  CPPUNIT_ASSERT ( trie.getKey(cursor) == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '\033') == Match::None );
+  CPPUNIT_ASSERT ( cursor.depth == 0 );
+}
+
+//----------------------------------------------------------------------
+void FKeyTrieTest::insertTest()
+{
+  finalcut::FKeyTrie trie{};
+  CPPUNIT_ASSERT ( trie.insert("\033[A", 3, finalcut::FKey::Up) );
+  CPPUNIT_ASSERT ( trie.getNodeCount() == 4 );
+  CPPUNIT_ASSERT ( trie.insert("\033[B", 3, finalcut::FKey::Down) );
+  CPPUNIT_ASSERT ( trie.getNodeCount() == 5 );  // Shared prefix
+
+  // The first inserted key has priority
+  CPPUNIT_ASSERT ( ! trie.insert("\033[A", 3, finalcut::FKey::F1) );
+  CPPUNIT_ASSERT ( trie.find("\033[A", 3) == finalcut::FKey::Up );
+  CPPUNIT_ASSERT ( trie.find("\033[B", 3) == finalcut::FKey::Down );
+
+  // Invalid sequences
+  CPPUNIT_ASSERT ( ! trie.insert(nullptr, 3, finalcut::FKey::F2) );
+  CPPUNIT_ASSERT ( ! trie.insert("\033OQ", 0, finalcut::FKey::F2) );
+  CPPUNIT_ASSERT ( trie.getNodeCount() == 5 );
+
+  // A prefix becomes a key
+  CPPUNIT_ASSERT ( trie.find("\033[", 2) == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( trie.insert("\033[", 2, finalcut::FKey::Meta_left_square_bracket) );
+  CPPUNIT_ASSERT ( trie.find("\033[", 2) == finalcut::FKey::Meta_left_square_bracket );
+  CPPUNIT_ASSERT ( trie.getNodeCount() == 5 );
+
+  trie.clear();
+  CPPUNIT_ASSERT ( trie.getNodeCount() == 1 );
+  CPPUNIT_ASSERT ( trie.find("\033[A", 3) == finalcut::FKey::None );
+}
+
+//----------------------------------------------------------------------
+void FKeyTrieTest::advanceTest()
+{
+  finalcut::FKeyTrie trie{};
+  trie.insert ("\033[11~", 5, finalcut::FKey::F1);
+  trie.insert ("\033[1;5A", 6, finalcut::FKey::Ctrl_up);
+  trie.insert ("\033[", 2, finalcut::FKey::Meta_left_square_bracket);
+
+  // One byte at a time
+  finalcut::FKeyTrie::Cursor cursor{};
+  CPPUNIT_ASSERT ( trie.advance(cursor, '\033') == Match::Prefix );
+  CPPUNIT_ASSERT ( trie.getKey(cursor) == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '[') == Match::Prefix );
+  CPPUNIT_ASSERT ( trie.getKey(cursor) == finalcut::FKey::Meta_left_square_bracket );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '1') == Match::Prefix );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '1') == Match::Prefix );
+  CPPUNIT_ASSERT ( trie.getKey(cursor) == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '~') == Match::Complete );
+  CPPUNIT_ASSERT ( trie.getKey(cursor) == finalcut::FKey::F1 );
+  CPPUNIT_ASSERT ( cursor.depth == 5 );
+
+  // No continuation after a complete sequence
+  CPPUNIT_ASSERT ( trie.advance(cursor, 'x') == Match::None );
+  CPPUNIT_ASSERT ( cursor.depth == 5 );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '~') == Match::None );
+
+  // No match is reported with the first wrong byte
+  cursor = {};
+  CPPUNIT_ASSERT ( trie.advance(cursor, '\033') == Match::Prefix );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '[') == Match::Prefix );
+  CPPUNIT_ASSERT ( trie.advance(cursor, '_') == Match::None );
+  CPPUNIT_ASSERT ( cursor.depth == 2 );
+  CPPUNIT_ASSERT ( trie.find("\033[1;5", 5) == finalcut::FKey::None );
+  CPPUNIT_ASSERT ( trie.find("\033[1;5A", 6) == finalcut::FKey::Ctrl_up );
+  CPPUNIT_ASSERT ( trie.find("\033[1;5AA", 7) == finalcut::FKey::None );
+}
+
+//----------------------------------------------------------------------
+void FKeyTrieTest::keyMapTest()
+{
+  // Every entry of the built-in key table can be found
+  finalcut::FKeyTrie trie{};
+  const auto& key_map = finalcut::FKeyMap::getKeyMap();
+
+  for (const auto& item : key_map)
+    if ( item.length != 0 )
+      trie.insert (item.string.data(), item.length, item.num);
+
+  for (const auto& item : key_map)
+  {
+    if ( item.length == 0 )
+      continue;
+
+    const auto found = trie.find(item.string.data(), item.length);
+    CPPUNIT_ASSERT ( found != finalcut::FKey::None );
+
+    // Only the first entry of a duplicate sequence is stored
+    const auto first = std::find_if ( key_map.cbegin(), key_map.cend()
+                                    , [&item] (const auto& entry)
+                                      {
+                                        return entry.length == item.length
+                                            && std::memcmp ( entry.string.data()
+                                                           , item.string.data()
+                                                           , item.length ) == 0;
+                                      } );
+    CPPUNIT_ASSERT ( found == first->num );
+  }
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FKeyTrieTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -307,6 +307,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void mouseTest();
     void utf8Test();
     void unknownKeyTest();
+    void bracketedPasteTest();
+    void keyboardProtocolTest();
 
   private:
     // Adds code needed to register the test suite
@@ -326,6 +328,8 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (mouseTest);
     CPPUNIT_TEST (utf8Test);
     CPPUNIT_TEST (unknownKeyTest);
+    CPPUNIT_TEST (bracketedPasteTest);
+    CPPUNIT_TEST (keyboardProtocolTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -339,8 +343,11 @@ class FKeyboardTest : public CPPUNIT_NS::TestFixture
     void keyReleased();
     void escapeKeyPressed();
     void mouseTracking();
+    void textPasted();
 
     // Data members
+    std::string pasted_text{};
+    int number_of_pastes{0};
     finalcut::FKey key_pressed{finalcut::FKey::None};
     finalcut::FKey key_released{finalcut::FKey::None};
     int number_of_keys{0};
@@ -3140,10 +3147,269 @@ void FKeyboardTest::unknownKeyTest()
   CPPUNIT_ASSERT ( keyboard->getKeyName(finalcut::FKey(0xf8d0)) == "" );
 
   // Unknown input
-  input("\033[_.");
+  input("\033[_");
   processInput();
   CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::None );
   CPPUNIT_ASSERT ( keyboard->getKeyName(key_pressed) == "" );
+  clear();
+
+  input("\033[_.");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('.') );
+  clear();
+
+  // A known key after an unknown sequence
+  input("\033[_\033[B");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Down );
+  clear();
+
+  // Text after an unknown sequence
+  input("\033[99;9Zab");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 2 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('b') );
+  clear();
+
+  input("\033O5Xc");  // Unknown SS3 sequence
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('c') );
+  clear();
+
+  // Meta + UTF-8 character (ä) after the keypress timeout
+  input("\033\xc3\xa4");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey(0xe4) );
+  clear();
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::bracketedPasteTest()
+{
+  // Higher timeout for systems with high load
+  keyboard->setKeypressTimeout(250000);  // 250 ms
+  std::cout << std::endl;
+
+  CPPUNIT_ASSERT ( keyboard->getKeyName(finalcut::FKey::Bracketed_paste)
+                   == "bracketed paste" );
+
+  // Pasted text with a line break and an escape sequence
+  input("\033[200~Hello\nWorld \033[A\033[201~");
+  processInput();
+  std::cout << " - Paste: " << pasted_text << std::endl;
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text == "Hello\nWorld \033[A" );
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( ! keyboard->isInPasteMode() );
+  CPPUNIT_ASSERT ( keyboard->getPasteText().empty() );
+  clear();
+
+  // Key input after the pasted text
+  input("\033[200~abc\033[201~x");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text == "abc" );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('x') );
+  clear();
+
+  // Empty paste
+  input("\033[200~\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text.empty() );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::None );
+  clear();
+
+  // Pasted emoji outside the basic multilingual plane
+  input("\033[200~\xf0\x9f\x98\x80 ok\033[201~");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text == "\xf0\x9f\x98\x80 ok" );
+  clear();
+
+  // Paste without an end sequence
+  input("\033[200~abc");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  CPPUNIT_ASSERT ( keyboard->isInPasteMode() );
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 1 );
+  CPPUNIT_ASSERT ( pasted_text == "abc" );
+  CPPUNIT_ASSERT ( ! keyboard->isInPasteMode() );
+  clear();
+
+  // Key input after the paste timeout
+  input("y");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_pastes == 0 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('y') );
+  clear();
+}
+
+//----------------------------------------------------------------------
+void FKeyboardTest::keyboardProtocolTest()
+{
+  // Progressive keyboard enhancement (CSI u)
+  CPPUNIT_ASSERT ( ! keyboard->hasKeyboardProtocol() );
+
+  // Not decoded without the protocol
+  input("\033[27u");
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::None );
+  clear();
+
+  keyboard->enableKeyboardProtocol();
+  CPPUNIT_ASSERT ( keyboard->hasKeyboardProtocol() );
+  CPPUNIT_ASSERT ( ! keyboard->hasKeyReleaseEvents() );
+
+  // Without the event types flag every key is released immediately
+  input("\033[97;5u");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_a );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::Ctrl_a );
+  clear();
+
+  input("\033[A");  // Legacy key sequence
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Up );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::Up );
+  clear();
+
+  keyboard->enableKeyReleaseEvents();
+  CPPUNIT_ASSERT ( keyboard->hasKeyReleaseEvents() );
+
+  // Escape key without keypress timeout
+  input("\033[27u");
+  keyboard->escapeKeyHandling();
+  keyboard->clearKeyBufferOnTimeout();
+
+  if ( keyboard->isKeyPressed() )
+    keyboard->fetchKeyCode();
+
+  keyboard->processQueuedInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Escape );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::None );
+  std::this_thread::sleep_for(std::chrono::milliseconds(75));
+  clear();
+
+  // Escape key release
+  input("\033[27;1:3u");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::Escape );
+  clear();
+
+  // Key release without a reported key press
+  input("\033[97;1:3u");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::None );
+  clear();
+
+  // Modifiers
+  input("\033[97;5u");  // Ctrl-a
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_a );
+  clear();
+
+  input("\033[97;3u");  // Meta-a
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Meta_a );
+  clear();
+
+  input("\033[97;4u");  // Shift-Meta-a
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Meta_A );
+  clear();
+
+  // Lock states, super, hyper and meta are ignored
+  input("\033[97;129u");  // a with num lock
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('a') );
+  clear();
+
+  input("\033[97;197u");  // Ctrl-a with caps lock and num lock
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_a );
+  clear();
+
+  input("\033[1;133A");  // Ctrl-Up with num lock
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_up );
+  clear();
+
+  input("\033[97;9u");  // Super-a
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey('a') );
+  clear();
+
+  input("\033[32;5u");  // Ctrl-Space
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_space );
+  clear();
+
+  input("\033[9;2u");  // Shift-Tab
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Back_tab );
+  clear();
+
+  // Enter is reported without a key release
+  input("\033[13;2u");
+  processInput();
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Return );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::Return );
+  clear();
+
+  // Function keys with event type
+  input("\033[1;5A\033[1;5:2A\033[1;5:3A");  // Press, repeat, release
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 2 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Ctrl_up );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::Ctrl_up );
+  clear();
+
+  input("\033[P\033[1;1:3P");  // F1
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::F1 );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::F1 );
+  clear();
+
+  input("\033[15;3~\033[15;3:3~");  // F53 (Meta-F5)
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::F53 );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::F53 );
+  clear();
+
+  // Legacy sequences without a key release
+  input("\033[I");  // Focus in
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 1 );
+  CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::Term_Focus_In );
+  CPPUNIT_ASSERT ( key_released == finalcut::FKey::Term_Focus_In );
+  clear();
+
+  // Keys in the private use area (e.g. media keys) are ignored
+  input("\033[57428u");
+  processInput();
+  CPPUNIT_ASSERT ( number_of_keys == 0 );
+  clear();
+
+  keyboard->disableKeyboardProtocol();
+  CPPUNIT_ASSERT ( ! keyboard->hasKeyboardProtocol() );
+  CPPUNIT_ASSERT ( ! keyboard->hasKeyReleaseEvents() );
 }
 
 //----------------------------------------------------------------------
@@ -3157,14 +3423,17 @@ void FKeyboardTest::init()
   auto cmd2 = [this] () { this->keyReleased(); };
   auto cmd3 = [this] () { this->escapeKeyPressed(); };
   auto cmd4 = [this] () { this->mouseTracking(); };
+  auto cmd5 = [this] () { this->textPasted(); };
   finalcut::FKeyboardCommand key_cmd1 (cmd1);
   finalcut::FKeyboardCommand key_cmd2 (cmd2);
   finalcut::FKeyboardCommand key_cmd3 (cmd3);
   finalcut::FKeyboardCommand key_cmd4 (cmd4);
+  finalcut::FKeyboardCommand key_cmd5 (cmd5);
   keyboard->setPressCommand (key_cmd1);
   keyboard->setReleaseCommand (key_cmd2);
   keyboard->setEscPressedCommand (key_cmd3);
   keyboard->setMouseTrackingCommand (key_cmd4);
+  keyboard->setPasteCommand (key_cmd5);
   keyboard->setKeypressTimeout (100000);  // 100 ms
   processInput();
   CPPUNIT_ASSERT ( key_pressed == finalcut::FKey::None );
@@ -3262,6 +3531,8 @@ void FKeyboardTest::processInput()
 void FKeyboardTest::clear()
 {
   keyboard->clearKeyBuffer();
+  pasted_text.clear();
+  number_of_pastes = 0;
   number_of_keys = 0;
   key_pressed = finalcut::FKey::None;
   key_released = finalcut::FKey::None;
@@ -3294,6 +3565,13 @@ void FKeyboardTest::mouseTracking()
   key_pressed = keyboard->getKey();
 }
 
+//----------------------------------------------------------------------
+void FKeyboardTest::textPasted()
+{
+  pasted_text = keyboard->getPasteText();
+  number_of_pastes++;
+}
+
 // Put the test suite in the registry
 CPPUNIT_TEST_SUITE_REGISTRATION (FKeyboardTest);
 
@@ -0,0 +1,302 @@
+/***********************************************************************
+* flinediff-test.cpp - Line comparison unit tests                      *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+namespace test
+{
+
+//----------------------------------------------------------------------
+auto getDefaultChar() -> finalcut::FChar
+{
+  return
+  {
+    { { L' ',  L'\0', L'\0', L'\0', L'\0' } },
+    { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
+    { { finalcut::FColor::Default, finalcut::FColor::Default } },
+    { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
+  };
+}
+
+//----------------------------------------------------------------------
+auto getKernels() -> std::vector<finalcut::LineDiffKernel>
+{
+  std::vector<finalcut::LineDiffKernel> kernels{};
+
+  for (const auto& kernel : { finalcut::LineDiffKernel::Scalar
+                            , finalcut::LineDiffKernel::SSE2
+                            , finalcut::LineDiffKernel::AVX2 })
+  {
+    if ( finalcut::isLineDiffKernelSupported(kernel) )
+      kernels.push_back(kernel);
+  }
+
+  return kernels;
+}
+
+}  // namespace test
+
+
+//----------------------------------------------------------------------
+// class FLineDiffTest
+//----------------------------------------------------------------------
+
+class FLineDiffTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FLineDiffTest() = default;
+
+  protected:
+    void kernelSelectionTest();
+    void equalLineTest();
+    void differenceTest();
+    void maskedAttributeTest();
+    void combiningCharacterTest();
+    void unchangedCellsTest();
+
+  private:
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FLineDiffTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (kernelSelectionTest);
+    CPPUNIT_TEST (equalLineTest);
+    CPPUNIT_TEST (differenceTest);
+    CPPUNIT_TEST (maskedAttributeTest);
+    CPPUNIT_TEST (combiningCharacterTest);
+    CPPUNIT_TEST (unchangedCellsTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+
+//----------------------------------------------------------------------
+void FLineDiffTest::kernelSelectionTest()
+{
+  const auto best_kernel = finalcut::getLineDiffKernel();
+  CPPUNIT_ASSERT ( finalcut::isLineDiffKernelSupported(best_kernel) );
+  CPPUNIT_ASSERT ( finalcut::isLineDiffKernelSupported(finalcut::LineDiffKernel::Scalar) );
+  CPPUNIT_ASSERT ( finalcut::setLineDiffKernel(finalcut::LineDiffKernel::Scalar) );
+  CPPUNIT_ASSERT ( finalcut::getLineDiffKernel() == finalcut::LineDiffKernel::Scalar );
+
+  for (const auto& kernel : test::getKernels())
+  {
+    CPPUNIT_ASSERT ( finalcut::setLineDiffKernel(kernel) );
+    CPPUNIT_ASSERT ( finalcut::getLineDiffKernel() == kernel );
+  }
+
+  if ( ! finalcut::isLineDiffKernelSupported(finalcut::LineDiffKernel::AVX2) )
+  {
+    CPPUNIT_ASSERT ( ! finalcut::setLineDiffKernel(finalcut::LineDiffKernel::AVX2) );
+    CPPUNIT_ASSERT ( finalcut::getLineDiffKernel() != finalcut::LineDiffKernel::AVX2 );
+  }
+
+  CPPUNIT_ASSERT ( finalcut::setLineDiffKernel(best_kernel) );
+}
+
+//----------------------------------------------------------------------
+void FLineDiffTest::equalLineTest()
+{
+  const auto best_kernel = finalcut::getLineDiffKernel();
+
+  for (const auto& kernel : test::getKernels())
+  {
+    finalcut::setLineDiffKernel(kernel);
+
+    // All line lengths up to two AVX2 blocks plus a remainder
+    for (std::size_t length{0}; length < 20; length++)
+    {
+      std::vector<finalcut::FChar> line(length, test::getDefaultChar());
+      finalcut::FVTerm::FCellPlanes planes{};
+      planes.resize(length + 3);
+      planes.fill(test::getDefaultChar());
+      planes.setFChars (3, line.data(), line.size());
+      CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 3, length) == length );
+      CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 3, length) == length );
+    }
+  }
+
+  finalcut::setLineDiffKernel(best_kernel);
+}
+
+//----------------------------------------------------------------------
+void FLineDiffTest::differenceTest()
+{
+  const auto best_kernel = finalcut::getLineDiffKernel();
+  constexpr std::size_t length = 37;
+
+  for (const auto& kernel : test::getKernels())
+  {
+    finalcut::setLineDiffKernel(kernel);
+
+    // A single difference at every position
+    for (std::size_t pos{0}; pos < length; pos++)
+    {
+      std::vector<finalcut::FChar> line(length, test::getDefaultChar());
+      finalcut::FVTerm::FCellPlanes planes{};
+      planes.resize(length);
+      planes.setFChars(line);
+      line[pos].ch[0] = L'x';
+      CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 0, length) == pos );
+      CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == pos );
+    }
+
+    // Two differences
+    std::vector<finalcut::FChar> line(length, test::getDefaultChar());
+    finalcut::FVTerm::FCellPlanes planes{};
+    planes.resize(length);
+    planes.setFChars(line);
+    line[5].color.pair.fg = finalcut::FColor::Red;
+    line[30].attr.bit.bold = true;
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 0, length) == 5 );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == 30 );
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(&line[6], planes, 6, 20) == 20 );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(&line[6], planes, 6, 20) == 20 );
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(&line[6], planes, 6, 25) == 24 );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, 30) == 5 );
+
+    // Character with a second code point
+    line[30].attr.bit.bold = false;
+    line[12].ch[1] = L'\U00000301';
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(&line[6], planes, 6, 31) == 6 );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == 12 );
+  }
+
+  finalcut::setLineDiffKernel(best_kernel);
+}
+
+//----------------------------------------------------------------------
+void FLineDiffTest::maskedAttributeTest()
+{
+  const auto best_kernel = finalcut::getLineDiffKernel();
+  constexpr std::size_t length = 24;
+
+  for (const auto& kernel : test::getKernels())
+  {
+    finalcut::setLineDiffKernel(kernel);
+    std::vector<finalcut::FChar> line(length, test::getDefaultChar());
+    finalcut::FVTerm::FCellPlanes planes{};
+    planes.resize(length);
+    planes.setFChars(line);
+
+    // Attributes which are not relevant for the comparison
+    for (auto& fchar : line)
+    {
+      fchar.encoded_char[0] = L'?';
+      fchar.attr.bit.no_changes = true;
+      fchar.attr.bit.printed = true;
+    }
+
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 0, length) == length );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == length );
+
+    // A relevant attribute
+    line[17].attr.bit.fullwidth_padding = true;
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 0, length) == 17 );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == 17 );
+  }
+
+  finalcut::setLineDiffKernel(best_kernel);
+}
+
+//----------------------------------------------------------------------
+void FLineDiffTest::combiningCharacterTest()
+{
+  const auto best_kernel = finalcut::getLineDiffKernel();
+  constexpr std::size_t length = 19;
+
+  for (const auto& kernel : test::getKernels())
+  {
+    finalcut::setLineDiffKernel(kernel);
+    std::vector<finalcut::FChar> line(length, test::getDefaultChar());
+
+    // Combining sequences are stored in the side table of the planes
+    for (std::size_t pos{1}; pos < length; pos += 3)
+    {
+      line[pos].ch[0] = L'a';
+      line[pos].ch[1] = L'\U00000300';  // Combining grave accent
+    }
+
+    finalcut::FVTerm::FCellPlanes planes{};
+    planes.resize(length);
+    planes.setFChars(line);
+    CPPUNIT_ASSERT ( ! planes.graphemes.empty() );
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 0, length) == length );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == length );
+
+    line[10].ch[1] = L'\U00000301';  // Combining acute accent
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 0, length) == 10 );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == 10 );
+
+    line[10].ch[1] = L'\0';
+    CPPUNIT_ASSERT ( finalcut::findFirstDifference(line.data(), planes, 0, length) == 10 );
+    CPPUNIT_ASSERT ( finalcut::findLastDifference(line.data(), planes, 0, length) == 10 );
+  }
+
+  finalcut::setLineDiffKernel(best_kernel);
+}
+
+//----------------------------------------------------------------------
+void FLineDiffTest::unchangedCellsTest()
+{
+  const auto best_kernel = finalcut::getLineDiffKernel();
+  constexpr std::size_t length = 29;
+
+  for (const auto& kernel : test::getKernels())
+  {
+    finalcut::setLineDiffKernel(kernel);
+    std::vector<finalcut::FChar> line(length, test::getDefaultChar());
+    CPPUNIT_ASSERT ( finalcut::countUnchangedCells(line.data(), 0) == 0 );
+    CPPUNIT_ASSERT ( finalcut::countUnchangedCells(line.data(), length) == 0 );
+
+    for (auto& fchar : line)
+      fchar.attr.bit.no_changes = true;
+
+    CPPUNIT_ASSERT ( finalcut::countUnchangedCells(line.data(), length) == length );
+    CPPUNIT_ASSERT ( finalcut::countUnchangedCells(line.data(), 11) == 11 );
+
+    for (std::size_t pos{length}; pos > 0; pos--)
+    {
+      line[pos - 1].attr.bit.no_changes = false;
+      CPPUNIT_ASSERT ( finalcut::countUnchangedCells(line.data(), length) == pos - 1 );
+    }
+  }
+
+  finalcut::setLineDiffKernel(best_kernel);
+}
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FLineDiffTest);
+
+// The general unit test main part
+#include <main-test.inc>
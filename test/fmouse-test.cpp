@@ -20,6 +20,8 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <vector>
+
 #include <cppunit/BriefTestProgressListener.h>
 #include <cppunit/CompilerOutputter.h>
 #include <cppunit/extensions/HelperMacros.h>
@@ -113,6 +115,7 @@ class FMouseTest : public CPPUNIT_NS::TestFixture
     void sgrMouseTest();
     void urxvtMouseTest();
     void mouseControlTest();
+    void moveCoalescingTest();
 
   private:
     auto insertData (std::initializer_list<char>) -> finalcut::FKeyboard::keybuffer;
@@ -132,6 +135,7 @@ class FMouseTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (sgrMouseTest);
     CPPUNIT_TEST (urxvtMouseTest);
     CPPUNIT_TEST (mouseControlTest);
+    CPPUNIT_TEST (moveCoalescingTest);
 
     // End of test suite definition
     CPPUNIT_TEST_SUITE_END();
@@ -1661,6 +1665,86 @@ void FMouseTest::mouseControlTest()
   mouse_control.disable();
 }
 
+//----------------------------------------------------------------------
+void FMouseTest::moveCoalescingTest()
+{
+  char* pram_0 = finalcut::C_STR("./a.out");
+  char** parms = &pram_0;
+  finalcut::FApplication app(1, parms);
+  CPPUNIT_ASSERT ( ! finalcut::FApplication::isQuit() );  // Need in processQueuedInput()
+
+  finalcut::FMouseControl mouse_control;
+  std::vector<finalcut::FPoint> positions{};
+  std::size_t moves{0};
+  auto cmd = [&positions, &moves] (const finalcut::FMouseData& md)
+             {
+               positions.push_back(md.getPos());
+
+               if ( md.isMoved() )
+                 moves++;
+             };
+  finalcut::FMouseCommand mouse_cmd (cmd);
+  mouse_control.setEventCommand (mouse_cmd);
+  mouse_control.setMaxWidth(100);
+  mouse_control.setMaxHeight(40);
+  CPPUNIT_ASSERT ( mouse_control.hasMoveCoalescing() );
+
+  // Left button drag on an SGR mouse (press, 3 moves, release)
+  const std::initializer_list<char> drag = { 0x1b, '[', '<', '0', ';', '5', ';', '5', 'M'
+                                            , 0x1b, '[', '<', '3', '2', ';', '6', ';', '5', 'M'
+                                            , 0x1b, '[', '<', '3', '2', ';', '7', ';', '5', 'M'
+                                            , 0x1b, '[', '<', '3', '2', ';', '8', ';', '6', 'M'
+                                            , 0x1b, '[', '<', '0', ';', '8', ';', '6', 'm' };
+  auto queueInput = [this, &mouse_control] (std::initializer_list<char> list)
+                    {
+                      auto rawdata = insertData (list);
+                      const auto tv = finalcut::FObjectTimer::getCurrentTime();
+
+                      while ( ! rawdata.isEmpty() )
+                      {
+                        mouse_control.setRawData (finalcut::FMouse::MouseType::Sgr, rawdata);
+                        mouse_control.processEvent (tv);
+                      }
+                    };
+
+  // The moves are combined into the last position
+  queueInput (drag);
+  mouse_control.processQueuedInput();
+  CPPUNIT_ASSERT ( positions.size() == 3 );
+  CPPUNIT_ASSERT ( moves == 1 );
+  CPPUNIT_ASSERT ( positions[0] == finalcut::FPoint(5, 5) );
+  CPPUNIT_ASSERT ( positions[1] == finalcut::FPoint(8, 6) );
+  CPPUNIT_ASSERT ( positions[2] == finalcut::FPoint(8, 6) );
+
+  // Moves with a different modifier key state are not combined
+  positions.clear();
+  moves = 0;
+  queueInput ({ 0x1b, '[', '<', '3', '2', ';', '2', ';', '2', 'M'
+              , 0x1b, '[', '<', '3', '6', ';', '3', ';', '2', 'M'
+              , 0x1b, '[', '<', '3', '6', ';', '4', ';', '2', 'M' });
+  mouse_control.processQueuedInput();
+  CPPUNIT_ASSERT ( positions.size() == 2 );
+  CPPUNIT_ASSERT ( moves == 2 );
+  CPPUNIT_ASSERT ( positions[0] == finalcut::FPoint(2, 2) );
+  CPPUNIT_ASSERT ( positions[1] == finalcut::FPoint(4, 2) );
+
+  // Every move without coalescing
+  positions.clear();
+  moves = 0;
+  mouse_control.unsetMoveCoalescing();
+  CPPUNIT_ASSERT ( ! mouse_control.hasMoveCoalescing() );
+  queueInput (drag);
+  mouse_control.processQueuedInput();
+  CPPUNIT_ASSERT ( positions.size() == 5 );
+  CPPUNIT_ASSERT ( moves == 3 );
+  CPPUNIT_ASSERT ( positions[1] == finalcut::FPoint(6, 5) );
+  CPPUNIT_ASSERT ( positions[2] == finalcut::FPoint(7, 5) );
+  CPPUNIT_ASSERT ( positions[3] == finalcut::FPoint(8, 6) );
+
+  mouse_control.setMoveCoalescing();
+  CPPUNIT_ASSERT ( mouse_control.hasMoveCoalescing() );
+}
+
 //----------------------------------------------------------------------
 auto FMouseTest::insertData (std::initializer_list<char> list) -> finalcut::FKeyboard::keybuffer
 {
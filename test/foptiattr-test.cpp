@@ -66,6 +66,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     void vga2ansiTest();
     void sgrOptimizerTest();
     void fakeReverseTest();
+    void transitionCacheTest();
     void ansiTest();
     void vt100Test();
     void xtermTest();
@@ -89,6 +90,7 @@ class FOptiAttrTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (vga2ansiTest);
     CPPUNIT_TEST (sgrOptimizerTest);
     CPPUNIT_TEST (fakeReverseTest);
+    CPPUNIT_TEST (transitionCacheTest);
     CPPUNIT_TEST (ansiTest);
     CPPUNIT_TEST (vt100Test);
     CPPUNIT_TEST (xtermTest);
@@ -433,6 +435,110 @@ void FOptiAttrTest::fakeReverseTest()
   CPPUNIT_ASSERT ( oa.changeAttribute(from, to).empty() );
 }
 
+//----------------------------------------------------------------------
+void FOptiAttrTest::transitionCacheTest()
+{
+  finalcut::FStartOptions::getInstance().sgr_optimizer = false;
+  finalcut::FOptiAttr oa;
+  oa.setDefaultColorSupport();  // ANSI default color
+  oa.setMaxColor (8);
+  oa.setNoColorVideo (0);
+  oa.set_enter_bold_mode (CSI "1m");
+  oa.set_exit_bold_mode (CSI "22m");
+  oa.set_enter_secure_mode (CSI "8m");
+  oa.set_exit_secure_mode (CSI "28m");
+  oa.set_exit_attribute_mode (CSI "0m");
+  oa.set_a_foreground_color (CSI "3%p1%dm");
+  oa.set_a_background_color (CSI "4%p1%dm");
+  oa.set_orig_pair (CSI "39;49m");
+  oa.initialize();
+
+  finalcut::FChar from{};
+  finalcut::FChar to{};
+  from.color.pair.fg = finalcut::FColor::Default;
+  from.color.pair.bg = finalcut::FColor::Default;
+  to.color.pair.fg = finalcut::FColor::Green;
+  to.color.pair.bg = finalcut::FColor::Black;
+  to.attr.bit.bold = true;
+
+  // Computed transition
+  auto term_1 = from;
+  auto next_1 = to;
+  const std::string seq_1 = oa.changeAttribute(term_1, next_1);
+  CPPUNIT_ASSERT_STRING ( seq_1, CSI "32m" CSI "40m" CSI "1m" );
+  CPPUNIT_ASSERT ( term_1 == next_1 );
+
+  // The same transition from the cache
+  auto term_2 = from;
+  auto next_2 = to;
+  const auto& seq_2 = oa.changeAttribute(term_2, next_2);
+  CPPUNIT_ASSERT_STRING ( seq_2, seq_1 );
+  CPPUNIT_ASSERT ( term_2 == term_1 );
+  CPPUNIT_ASSERT ( next_2 == next_1 );
+
+  // Secure mode is available, the character stays unchanged
+  to.attr.bit.bold = false;
+  to.attr.bit.invisible = true;
+
+  for (int i{0}; i < 2; i++)
+  {
+    auto term = from;
+    auto next = to;
+    next.encoded_char[0] = L'A';
+    CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next)
+                          , CSI "32m" CSI "40m" CSI "8m" );
+    CPPUNIT_ASSERT ( next.encoded_char[0] == L'A' );
+  }
+
+  // A capability change invalidates the cache
+  oa.set_a_foreground_color (CSI "38;5;%p1%dm");
+
+  for (int i{0}; i < 2; i++)
+  {
+    auto term = from;
+    auto next = to;
+    next.encoded_char[0] = L'A';
+    CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term, next)
+                          , CSI "38;5;2m" CSI "40m" CSI "8m" );
+    CPPUNIT_ASSERT ( next.encoded_char[0] == L'A' );
+  }
+
+  to.attr.bit.invisible = false;
+  to.attr.bit.bold = true;
+  auto term_3 = from;
+  auto next_3 = to;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term_3, next_3)
+                        , CSI "38;5;2m" CSI "40m" CSI "1m" );
+
+  oa.setMaxColor (1);  // Monochrome
+  auto term_4 = from;
+  auto next_4 = to;
+  CPPUNIT_ASSERT_STRING ( oa.changeAttribute(term_4, next_4)
+                        , CSI "38;5;0m" CSI "40m" CSI "1m" );
+  CPPUNIT_ASSERT ( term_4 == next_4 );
+
+  // Without secure mode, hidden characters are replaced
+  // by a space on every call
+  finalcut::FOptiAttr oa2;
+  oa2.setDefaultColorSupport();
+  oa2.setMaxColor (8);
+  oa2.set_a_foreground_color (CSI "3%p1%dm");
+  oa2.set_a_background_color (CSI "4%p1%dm");
+  oa2.initialize();
+  to.attr.bit.bold = false;
+  to.attr.bit.invisible = true;
+
+  for (int i{0}; i < 2; i++)
+  {
+    auto term = from;
+    auto next = to;
+    next.encoded_char[0] = L'A';
+    CPPUNIT_ASSERT_STRING ( oa2.changeAttribute(term, next)
+                          , CSI "32m" CSI "40m" );
+    CPPUNIT_ASSERT ( next.encoded_char[0] == L' ' );
+  }
+}
+
 //----------------------------------------------------------------------
 void FOptiAttrTest::ansiTest()
 {
@@ -0,0 +1,190 @@
+/***********************************************************************
+* foptimove-bench.cpp - FOptiMove cursor motion microbenchmark         *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+namespace bench
+{
+
+struct Move
+{
+  int xold;
+  int yold;
+  int xnew;
+  int ynew;
+};
+
+//----------------------------------------------------------------------
+void setXterm (finalcut::FOptiMove& om)
+{
+  om.setBaudRate (38400);
+  om.setTabStop (8);
+  om.set_tabular ("\t");
+  om.set_back_tab (CSI "Z");
+  om.set_cursor_home (CSI "H");
+  om.set_carriage_return ("\r");
+  om.set_cursor_up (CSI "A");
+  om.set_cursor_down ("\n");
+  om.set_cursor_right (CSI "C");
+  om.set_cursor_left ("\b");
+  om.set_cursor_address (CSI "%i%p1%d;%p2%dH");
+  om.set_column_address (CSI "%i%p1%dG");
+  om.set_row_address (CSI "%i%p1%dd");
+  om.set_parm_up_cursor (CSI "%p1%dA");
+  om.set_parm_down_cursor (CSI "%p1%dB");
+  om.set_parm_right_cursor (CSI "%p1%dC");
+  om.set_parm_left_cursor (CSI "%p1%dD");
+}
+
+//----------------------------------------------------------------------
+void setVt100 (finalcut::FOptiMove& om)
+{
+  om.setBaudRate (1200);
+  om.setTabStop (8);
+  om.set_auto_left_margin (true);
+  om.set_tabular ("\t");
+  om.set_cursor_home (CSI "H");
+  om.set_carriage_return ("\r");
+  om.set_cursor_up (CSI "A$<2>");
+  om.set_cursor_down ("\n");
+  om.set_cursor_right (CSI "C$<2>");
+  om.set_cursor_left ("\b");
+  om.set_cursor_address (CSI "%i%p1%d;%p2%dH$<5>");
+  om.set_parm_up_cursor (CSI "%p1%dA");
+  om.set_parm_down_cursor (CSI "%p1%dB");
+  om.set_parm_right_cursor (CSI "%p1%dC");
+  om.set_parm_left_cursor (CSI "%p1%dD");
+}
+
+//----------------------------------------------------------------------
+auto getOutputMoves (int width, int height) -> std::vector<Move>
+{
+  // Cursor jumps between the changed runs of a redrawn screen
+
+  std::vector<Move> moves{};
+  std::srand(1);
+
+  for (int y{0}; y < height; y++)
+  {
+    int x{0};
+
+    while ( x < width - 1 )
+    {
+      const int gap = 1 + std::rand() % 12;
+      const int xnew = std::min(x + gap, width - 1);
+      moves.push_back({x, y, xnew, y});
+      x = xnew + std::rand() % 8;
+    }
+
+    moves.push_back({std::min(x, width - 1), y, std::rand() % 4, y + 1});
+  }
+
+  return moves;
+}
+
+//----------------------------------------------------------------------
+auto getRandomMoves (int width, int height) -> std::vector<Move>
+{
+  std::vector<Move> moves{};
+  std::srand(2);
+
+  for (int i{0}; i < 4096; i++)
+  {
+    moves.push_back ({ std::rand() % width, std::rand() % height
+                     , std::rand() % width, std::rand() % height });
+  }
+
+  return moves;
+}
+
+//----------------------------------------------------------------------
+void run ( const std::string& name
+         , finalcut::FOptiMove& om
+         , const std::vector<Move>& moves
+         , int iterations )
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  std::size_t bytes{0};
+  const auto start = std::chrono::steady_clock::now();
+
+  for (int i{0}; i < iterations; i++)
+  {
+    for (const auto& m : moves)
+      bytes += om.moveCursor(m.xold, m.yold, m.xnew, m.ynew).length();
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  const auto count = double(moves.size()) * iterations;
+  const auto ns = double(duration_cast<nanoseconds>(end - start).count());
+  std::cout << std::left << std::setw(20) << name << std::right
+            << std::fixed << std::setprecision(1)
+            << std::setw(10) << ns / count << " ns/move"
+            << std::setw(10) << double(bytes) / count << " bytes/move\n";
+}
+
+}  // namespace bench
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  const int iterations = ( argc > 1 ) ? std::max(1, std::atoi(argv[1])) : 200;
+  constexpr int width{160};
+  constexpr int height{50};
+
+  finalcut::FTermcap::init();
+  finalcut::FTermcap::setPutCharFunction (::putchar);
+  auto putstr = [] (const std::string& s){ return ::fputs(s.c_str(), stdout); };
+  finalcut::FTermcap::setPutStringFunction (putstr);
+
+  const auto output_moves = bench::getOutputMoves (width, height);
+  const auto random_moves = bench::getRandomMoves (width, height);
+
+  finalcut::FOptiMove xterm;
+  xterm.setTermSize (width, height);
+  bench::setXterm (xterm);
+
+  finalcut::FOptiMove vt100;
+  vt100.setTermSize (width, height);
+  bench::setVt100 (vt100);
+
+  std::cout << "FOptiMove::moveCursor() with " << iterations
+            << " iterations on a " << width << "x" << height
+            << " terminal\n";
+  bench::run ("xterm output runs", xterm, output_moves, iterations);
+  bench::run ("xterm random", xterm, random_moves, iterations);
+  bench::run ("vt100 output runs", vt100, output_moves, iterations);
+  bench::run ("vt100 random", vt100, random_moves, iterations);
+  return 0;
+}
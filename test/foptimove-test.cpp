@@ -130,6 +130,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     void noArgumentTest();
     void homeTest();
     void fromLeftToRightTest();
+    void paramTemplateTest();
     void ansiTest();
     void vt100Test();
     void xtermTest();
@@ -151,6 +152,7 @@ class FOptiMoveTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (noArgumentTest);
     CPPUNIT_TEST (homeTest);
     CPPUNIT_TEST (fromLeftToRightTest);
+    CPPUNIT_TEST (paramTemplateTest);
     CPPUNIT_TEST (ansiTest);
     CPPUNIT_TEST (vt100Test);
     CPPUNIT_TEST (xtermTest);
@@ -260,6 +262,46 @@ void FOptiMoveTest::fromLeftToRightTest()
   CPPUNIT_ASSERT_STRING (om.moveCursor (3, 2, 79, 2), "\r\b" ESC "D");
 }
 
+//----------------------------------------------------------------------
+void FOptiMoveTest::paramTemplateTest()
+{
+  finalcut::FOptiMove om;
+  om.setTermSize (80, 25);
+  om.set_cursor_home (nullptr);
+  om.set_carriage_return (nullptr);
+  om.set_cursor_up (nullptr);
+  om.set_cursor_down (nullptr);
+  om.set_cursor_right (nullptr);
+  om.set_cursor_left (nullptr);
+
+  // Precompiled parameters
+  om.set_cursor_address (CSI "%i%p2%d;%p1%dH");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (0, 0, 5, 9), CSI "6;10H");
+  om.set_cursor_address (CSI "%p1%d;%p2%dH");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (0, 0, 5, 9), CSI "9;5H");
+  om.set_cursor_address ("%%" CSI "%i%p1%d;%p2%d%%H");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (0, 0, 79, 24), "%" CSI "25;80%H");
+  om.set_cursor_address (CSI "%i%p1%d;%p2%dH$<5>");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (-1, -1, 0, 0), CSI "1;1H$<5>");
+
+  // Capabilities with other formats are encoded by FTermcap
+  om.set_cursor_address (CSI "%p1%{1}%+%d;%p2%{1}%+%dH");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (0, 0, 5, 9), CSI "10;6H");
+  om.set_cursor_address (CSI "%i%p1%02d;%p2%03dH");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (0, 0, 5, 9), CSI "10;006H");
+
+  // Parameterized relative movement
+  om.set_cursor_address (nullptr);
+  om.set_parm_up_cursor (CSI "%p1%dA");
+  om.set_parm_down_cursor (CSI "%p1%dB");
+  om.set_parm_right_cursor (CSI "%p1%dC");
+  om.set_parm_left_cursor (CSI "%p1%dD");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (70, 3, 2, 21), CSI "18B" CSI "68D");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (2, 21, 70, 3), CSI "18A" CSI "68C");
+  om.set_column_address (CSI "%i%p1%dG");
+  CPPUNIT_ASSERT_STRING (om.moveCursor (2, 21, 70, 3), CSI "18A" CSI "71G");
+}
+
 //----------------------------------------------------------------------
 void FOptiMoveTest::ansiTest()
 {
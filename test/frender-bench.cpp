@@ -0,0 +1,745 @@
+/***********************************************************************
+* frender-bench.cpp - Rendering benchmark with a headless terminal     *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+/*  Replays canned scenes through the complete render pipeline into
+ *  an FHeadlessOutput and reports frames/s, bytes/frame and heap
+ *  allocations/frame. Bytes and allocations are deterministic and
+ *  can be compared with a baseline file:
+ *
+ *    frender_bench [frames] [--vt100] [--size COLSxROWS]
+ *                  [--parallel THREADS] [--write-baseline FILE]
+ *                  [--baseline FILE] [--tolerance PERCENT]
+ *
+ *  With --baseline, the exit code is 1 if a scene needs more bytes
+ *  or allocations per frame than the baseline plus the tolerance.
+ *  With --parallel, the row band compositor is used for every
+ *  terminal size. The output checksum must not depend on it.
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+
+#include <final/final.h>
+
+using finalcut::FColor;
+using finalcut::FPoint;
+using finalcut::FSize;
+
+namespace bench
+{
+
+// Number of operator new calls (also from the compositor threads)
+std::atomic<std::size_t> allocations{0};
+
+}  // namespace bench
+
+//----------------------------------------------------------------------
+// Counting global allocation functions
+//----------------------------------------------------------------------
+
+auto operator new (std::size_t size) -> void*
+{
+  bench::allocations.fetch_add(1, std::memory_order_relaxed);
+
+  if ( auto ptr = std::malloc(size ? size : 1) )
+    return ptr;
+
+  throw std::bad_alloc{};
+}
+
+//----------------------------------------------------------------------
+void operator delete (void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+//----------------------------------------------------------------------
+void operator delete (void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+
+namespace bench
+{
+
+//----------------------------------------------------------------------
+// class Application
+//----------------------------------------------------------------------
+
+class Application final : public finalcut::FApplication
+{
+  public:
+    // Using-declaration
+    using finalcut::FApplication::FApplication;
+
+    // Methods
+    void renderFrame() const;
+};
+
+//----------------------------------------------------------------------
+void Application::renderFrame() const
+{
+  // The steps of one main loop iteration without input processing
+  processUpdates();
+  processTerminalUpdate();
+  flush();
+}
+
+
+//----------------------------------------------------------------------
+// class Scene
+//----------------------------------------------------------------------
+
+class Scene
+{
+  public:
+    // Constructor
+    Scene() = default;
+
+    // Destructor
+    virtual ~Scene() noexcept = default;
+
+    // Accessor
+    virtual auto getName() const -> std::string = 0;
+
+    // Methods
+    virtual void create (finalcut::FWidget*) = 0;
+    virtual void nextFrame (int) = 0;
+    virtual void destroy() = 0;
+};
+
+
+//----------------------------------------------------------------------
+// class FullRepaint
+//----------------------------------------------------------------------
+
+class FullRepaint final : public Scene
+{
+  public:
+    auto getName() const -> std::string override
+    { return "full repaint"; }
+
+    void create (finalcut::FWidget*) override;
+    void nextFrame (int) override;
+    void destroy() override;
+
+  private:
+    class Canvas final : public finalcut::FWidget
+    {
+      public:
+        using finalcut::FWidget::FWidget;
+        int frame{0};
+
+      private:
+        void draw() override;
+    };
+
+    std::unique_ptr<Canvas> canvas{};
+};
+
+//----------------------------------------------------------------------
+void FullRepaint::Canvas::draw()
+{
+  // Every cell changes its character and color in each frame.
+  // The lines are no shifted copies of the previous frame,
+  // so that the line scrolling cannot be used.
+
+  static constexpr std::array<FColor, 4> colors
+  {{ FColor::Blue, FColor::Red, FColor::Green, FColor::Magenta }};
+  const auto width = int(getWidth());
+  const auto height = int(getHeight());
+
+  for (auto y{0}; y < height; y++)
+  {
+    print() << FPoint{1, 1 + y};
+
+    for (auto x{0}; x < width; x++)
+    {
+      const auto n = x + 7 * y + 3 * frame;
+      print() << finalcut::FColorPair{FColor::White, colors[std::size_t(n / 7) % 4]}
+              << wchar_t(L'A' + n % 26);
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FullRepaint::create (finalcut::FWidget* parent)
+{
+  canvas = std::make_unique<Canvas>(parent);
+  canvas->setGeometry (FPoint{1, 1}, parent->getSize());
+  canvas->show();
+}
+
+//----------------------------------------------------------------------
+void FullRepaint::nextFrame (int frame)
+{
+  canvas->frame = frame;
+  canvas->update();
+}
+
+//----------------------------------------------------------------------
+void FullRepaint::destroy()
+{
+  canvas.reset();
+}
+
+
+//----------------------------------------------------------------------
+// class ScrollingList
+//----------------------------------------------------------------------
+
+class ScrollingList final : public Scene
+{
+  public:
+    auto getName() const -> std::string override
+    { return "scrolling list"; }
+
+    void create (finalcut::FWidget*) override;
+    void nextFrame (int) override;
+    void destroy() override;
+
+  private:
+    static constexpr std::size_t ITEMS{1000};
+    std::unique_ptr<finalcut::FDialog> dialog{};
+    finalcut::FListBox* list{nullptr};
+};
+
+//----------------------------------------------------------------------
+void ScrollingList::create (finalcut::FWidget* parent)
+{
+  dialog = std::make_unique<finalcut::FDialog>("Scrolling list", parent);
+  dialog->setGeometry (FPoint{1, 1}, parent->getSize());
+  list = new finalcut::FListBox(dialog.get());  // Owned by the dialog
+  list->setGeometry ( FPoint{1, 1}
+                    , FSize{dialog->getClientWidth(), dialog->getClientHeight()} );
+
+  for (std::size_t n{1}; n <= ITEMS; n++)
+    list->insert (finalcut::FString{"List item "} << n);
+
+  dialog->show();
+}
+
+//----------------------------------------------------------------------
+void ScrollingList::nextFrame (int)
+{
+  // The selection moves down and scrolls the list by one line
+
+  const auto key = ( list->currentItem() == ITEMS )
+                 ? finalcut::FKey::Home
+                 : finalcut::FKey::Down;
+  finalcut::FKeyEvent ev{finalcut::Event::KeyPress, key};
+  finalcut::FApplication::sendEvent (list, &ev);
+}
+
+//----------------------------------------------------------------------
+void ScrollingList::destroy()
+{
+  list = nullptr;
+  dialog.reset();
+}
+
+
+//----------------------------------------------------------------------
+// class MovingDialog
+//----------------------------------------------------------------------
+
+class MovingDialog final : public Scene
+{
+  public:
+    auto getName() const -> std::string override
+    { return "moving dialog"; }
+
+    void create (finalcut::FWidget*) override;
+    void nextFrame (int) override;
+    void destroy() override;
+
+  private:
+    class Backdrop final : public finalcut::FDialog
+    {
+      public:
+        using finalcut::FDialog::FDialog;
+
+      private:
+        void draw() override;
+    };
+
+    class Overlay final : public finalcut::FDialog
+    {
+      public:
+        using finalcut::FDialog::FDialog;
+
+      private:
+        void draw() override;
+    };
+
+    std::unique_ptr<Backdrop> backdrop{};
+    finalcut::FDialog* mover{nullptr};
+};
+
+//----------------------------------------------------------------------
+void MovingDialog::Backdrop::draw()
+{
+  finalcut::FDialog::draw();
+  const finalcut::FString line{"`._.'   `._.'   `._.'   .-.     .-.     .-.     "};
+  setColor();
+
+  for (auto y{0}; y < int(getClientHeight()); y++)
+  {
+    const auto offset = std::size_t(y * 3) % line.getLength();
+    const auto text = line.mid(offset + 1, line.getLength()) + line.left(offset);
+    print() << FPoint{2, 2 + y} << text.left(getClientWidth());
+  }
+}
+
+//----------------------------------------------------------------------
+void MovingDialog::Overlay::draw()
+{
+  // A color overlay that darkens the windows below
+
+  const auto& wc_shadow = getColorTheme()->shadow;
+  print() << finalcut::FColorPair{wc_shadow.fg, wc_shadow.bg}
+          << finalcut::FStyle{finalcut::Style::ColorOverlay};
+  const finalcut::FString line{getWidth(), L' '};
+
+  for (auto y{1}; y <= int(getHeight()); y++)
+    print() << FPoint{1, y} << line;
+
+  print() << finalcut::FStyle{finalcut::Style::None};
+}
+
+//----------------------------------------------------------------------
+void MovingDialog::create (finalcut::FWidget* parent)
+{
+  backdrop = std::make_unique<Backdrop>("Backdrop", parent);
+  backdrop->setGeometry (FPoint{1, 1}, parent->getSize());
+  backdrop->unsetTransparentShadow();
+
+  auto overlay = new Overlay(backdrop.get());  // Owned by the backdrop
+  overlay->setGeometry (FPoint{20, 6}, FSize{40, 12});
+  overlay->unsetTransparentShadow();
+  overlay->ignorePadding();
+
+  mover = new finalcut::FDialog("Moving dialog", backdrop.get());
+  mover->setGeometry (FPoint{4, 4}, FSize{30, 9});
+  mover->setTransparentShadow();
+  backdrop->show();
+}
+
+//----------------------------------------------------------------------
+void MovingDialog::nextFrame (int frame)
+{
+  // Circles around the overlay center
+
+  const auto a = double(frame) / 8.0;
+  const auto x = 26 + int(std::lround(22.0 * std::cos(a)));
+  const auto y = 8 + int(std::lround(7.0 * std::sin(a)));
+  mover->setPos (FPoint{x, y});
+}
+
+//----------------------------------------------------------------------
+void MovingDialog::destroy()
+{
+  mover = nullptr;
+  backdrop.reset();
+}
+
+
+//----------------------------------------------------------------------
+// class RotoZoomer
+//----------------------------------------------------------------------
+
+class RotoZoomer final : public Scene
+{
+  public:
+    auto getName() const -> std::string override
+    { return "rotozoomer"; }
+
+    void create (finalcut::FWidget*) override;
+    void nextFrame (int) override;
+    void destroy() override;
+
+  private:
+    class Effect final : public finalcut::FDialog
+    {
+      public:
+        explicit Effect (finalcut::FWidget*);
+        int path{0};
+
+      private:
+        void draw() override;
+        std::wstring data{std::wstring(256, L'\0')};
+    };
+
+    std::unique_ptr<Effect> effect{};
+};
+
+//----------------------------------------------------------------------
+RotoZoomer::Effect::Effect (finalcut::FWidget* parent)
+  : finalcut::FDialog{"Rotozoomer", parent}
+{
+  // Checkerboard texture (see examples/rotozoomer.cpp)
+
+  const std::array<wchar_t, 4> init_val{{L' ', L'+', L'x', L' '}};
+  std::size_t h{0};
+
+  for (std::size_t i{0}; i < 2; i++)
+  {
+    for (int j{0}; j < 8; j++)
+    {
+      for (int k{0}; k < 8; k++)
+        data[h++] = init_val[2 * i];
+
+      for (int k{0}; k < 8; k++)
+        data[h++] = init_val[2 * i + 1];
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void RotoZoomer::Effect::draw()
+{
+  finalcut::FDialog::draw();
+  const auto a  = double(path) / 50.0;
+  const auto r  = 128.0 + 96.0 * std::cos(double(path) / 10.0);
+  const auto cx = 40.0 + 40.0 * std::sin(a);
+  const auto cy = 23.0 + 23.0 * std::cos(a);
+  const auto cols = int(getClientWidth());
+  const auto lines = int(getClientHeight());
+  auto ax = int(4096.0 * (cx + r * std::cos(a)));
+  auto ay = int(4096.0 * (cy + r * std::sin(a)));
+  const auto bx = int(4096.0 * (cx + r * std::cos(a + 2.02358)));
+  const auto by = int(4096.0 * (cy + r * std::sin(a + 2.02358)));
+  const auto dx = int(4096.0 * (cx + r * std::cos(a - 1.11701)));
+  const auto dy = int(4096.0 * (cy + r * std::sin(a - 1.11701)));
+  const int dxdx = (bx - ax) / 80;
+  const int dydx = (by - ay) / 80;
+  const int dxdy = (dx - ax) / 23;
+  const int dydy = (dy - ay) / 23;
+
+  for (auto y{0}; y < lines; y++)
+  {
+    auto px = ax;
+    auto py = ay;
+    print() << FPoint{2, 3 + y};
+
+    for (auto x{0}; x < cols; x++)
+    {
+      const auto& ch = data[std::size_t(((py >> 14) & 0xf) + ((px >> 10) & 0xf0))];
+
+      if ( ch == L'+' )
+        print() << finalcut::FColorPair{FColor::Black, FColor::Red};
+      else if ( ch == L'x' )
+        print() << finalcut::FColorPair{FColor::Black, FColor::Cyan};
+      else
+        print() << finalcut::FColorPair{FColor::Black, FColor::White};
+
+      print() << ch;
+      px += dxdx;
+      py += dydx;
+    }
+
+    ax += dxdy;
+    ay += dydy;
+  }
+}
+
+//----------------------------------------------------------------------
+void RotoZoomer::create (finalcut::FWidget* parent)
+{
+  effect = std::make_unique<Effect>(parent);
+  effect->setGeometry (FPoint{1, 1}, parent->getSize());
+  effect->unsetTransparentShadow();
+  effect->show();
+}
+
+//----------------------------------------------------------------------
+void RotoZoomer::nextFrame (int frame)
+{
+  effect->path = frame;
+  effect->update();
+}
+
+//----------------------------------------------------------------------
+void RotoZoomer::destroy()
+{
+  effect.reset();
+}
+
+
+//----------------------------------------------------------------------
+// Measurement
+//----------------------------------------------------------------------
+
+struct Result
+{
+  std::string name{};
+  double frames_per_second{0.0};
+  double bytes_per_frame{0.0};
+  double allocations_per_frame{0.0};
+  uInt32 checksum{2'166'136'261};  // FNV-1a hash of the output
+};
+
+using Baseline = std::map<std::string, Result>;
+
+//----------------------------------------------------------------------
+auto getOutput() -> finalcut::FHeadlessOutput&
+{
+  const auto& foutput = finalcut::FVTerm::getFOutput();
+  return static_cast<finalcut::FHeadlessOutput&>(*foutput);
+}
+
+//----------------------------------------------------------------------
+auto run (Application& app, Scene& scene, int frames) -> Result
+{
+  using std::chrono::duration_cast;
+  using std::chrono::nanoseconds;
+  auto& output = getOutput();
+  scene.create (&app);
+  app.renderFrame();  // The initial screen is not measured
+  output.clearOutput();
+  std::size_t bytes{0};
+  Result result{};
+  const auto start_allocations = allocations.load(std::memory_order_relaxed);
+  const auto start = std::chrono::steady_clock::now();
+
+  for (int frame{1}; frame <= frames; frame++)
+  {
+    scene.nextFrame (frame);
+    app.renderFrame();
+    bytes += output.getOutput().size();
+
+    for (const auto ch : output.getOutput())
+      result.checksum = (result.checksum ^ uInt8(ch)) * 16'777'619;
+
+    output.clearOutput();
+  }
+
+  const auto end = std::chrono::steady_clock::now();
+  const auto frame_allocations = allocations.load(std::memory_order_relaxed)
+                               - start_allocations;
+  scene.destroy();
+  app.renderFrame();
+  output.clearOutput();
+
+  const auto seconds = double(duration_cast<nanoseconds>(end - start).count()) / 1e9;
+  result.name = scene.getName();
+  result.frames_per_second = ( seconds > 0.0 ) ? double(frames) / seconds : 0.0;
+  result.bytes_per_frame = double(bytes) / double(frames);
+  result.allocations_per_frame = double(frame_allocations) / double(frames);
+  return result;
+}
+
+//----------------------------------------------------------------------
+void print (const Result& result)
+{
+  std::cout << std::left << std::setw(16) << result.name << std::right
+            << std::fixed << std::setprecision(1)
+            << std::setw(10) << result.frames_per_second << " frames/s"
+            << std::setw(10) << result.bytes_per_frame << " bytes/frame"
+            << std::setw(10) << result.allocations_per_frame << " allocs/frame"
+            << "  checksum " << std::hex << std::setw(8) << std::setfill('0')
+            << result.checksum << std::dec << std::setfill(' ') << '\n';
+}
+
+//----------------------------------------------------------------------
+auto readBaseline (const std::string& filename) -> Baseline
+{
+  // Line format: <bytes/frame> <allocs/frame> <scene name>
+
+  Baseline baseline{};
+  std::ifstream file{filename};
+
+  if ( ! file )
+  {
+    std::cerr << "Cannot read the baseline file " << filename << '\n';
+    std::exit(EXIT_FAILURE);
+  }
+
+  Result entry{};
+
+  while ( file >> entry.bytes_per_frame >> entry.allocations_per_frame )
+  {
+    std::getline (file >> std::ws, entry.name);
+    baseline[entry.name] = entry;
+  }
+
+  return baseline;
+}
+
+//----------------------------------------------------------------------
+void writeBaseline (const std::string& filename, const std::vector<Result>& results)
+{
+  std::ofstream file{filename};
+
+  for (const auto& result : results)
+  {
+    file << std::fixed << std::setprecision(1)
+         << result.bytes_per_frame << ' '
+         << result.allocations_per_frame << ' '
+         << result.name << '\n';
+  }
+}
+
+//----------------------------------------------------------------------
+auto compare ( const Baseline& baseline, const std::vector<Result>& results
+             , double tolerance ) -> bool
+{
+  // Frames/s depend on the machine and are not compared
+
+  const auto exceeds = [tolerance] (double value, double reference)
+  {
+    return value > reference * (1.0 + tolerance / 100.0) + 0.5;
+  };
+
+  bool ok{true};
+
+  for (const auto& result : results)
+  {
+    const auto iter = baseline.find(result.name);
+
+    if ( iter == baseline.end() )
+      continue;
+
+    const auto& ref = iter->second;
+
+    if ( exceeds(result.bytes_per_frame, ref.bytes_per_frame) )
+    {
+      std::cout << "Regression in " << result.name << ": "
+                << result.bytes_per_frame << " bytes/frame (baseline "
+                << ref.bytes_per_frame << ")\n";
+      ok = false;
+    }
+
+    if ( exceeds(result.allocations_per_frame, ref.allocations_per_frame) )
+    {
+      std::cout << "Regression in " << result.name << ": "
+                << result.allocations_per_frame << " allocs/frame (baseline "
+                << ref.allocations_per_frame << ")\n";
+      ok = false;
+    }
+  }
+
+  return ok;
+}
+
+}  // namespace bench
+
+
+//----------------------------------------------------------------------
+//                               main part
+//----------------------------------------------------------------------
+auto main (int argc, char* argv[]) -> int
+{
+  int frames{200};
+  double tolerance{5.0};
+  std::string baseline_file{};
+  std::string write_file{};
+  std::string size{};
+  std::size_t threads{0};
+  auto profile = finalcut::FHeadlessOutput::getXTermProfile();
+
+  for (int i{1}; i < argc; i++)
+  {
+    const std::string arg{argv[i]};
+
+    if ( arg == "--vt100" )
+      profile = finalcut::FHeadlessOutput::getVT100Profile();
+    else if ( arg == "--size" && i + 1 < argc )
+      size = argv[++i];
+    else if ( arg == "--parallel" && i + 1 < argc )
+      threads = std::size_t(std::max(0, std::atoi(argv[++i])));
+    else if ( arg == "--baseline" && i + 1 < argc )
+      baseline_file = argv[++i];
+    else if ( arg == "--write-baseline" && i + 1 < argc )
+      write_file = argv[++i];
+    else if ( arg == "--tolerance" && i + 1 < argc )
+      tolerance = std::atof(argv[++i]);
+    else
+      frames = std::max(1, std::atoi(argv[i]));
+  }
+
+  const auto delimiter = size.find('x');
+
+  if ( delimiter != std::string::npos )
+  {
+    profile.size.setWidth (std::size_t(std::atoi(size.c_str())));
+    profile.size.setHeight (std::size_t(std::atoi(size.c_str() + delimiter + 1)));
+  }
+
+  if ( threads > 0 )
+  {
+    auto& compositor = finalcut::FRowBandCompositor::getInstance();
+    compositor.setThreadCount (threads);
+    compositor.setMinimumCells (0);
+    compositor.enable();
+  }
+
+  // The first FVTerm object defines the output for all widgets
+  finalcut::FHeadlessOutput::setProfile (profile);
+  finalcut::FVTerm headless_vterm{finalcut::outputClass<finalcut::FHeadlessOutput>{}};
+  int app_argc{1};
+  bench::Application app{app_argc, argv};
+  app.renderFrame();
+  bench::getOutput().clearOutput();
+
+  bench::FullRepaint full_repaint{};
+  bench::ScrollingList scrolling_list{};
+  bench::MovingDialog moving_dialog{};
+  bench::RotoZoomer rotozoomer{};
+  const std::array<bench::Scene*, 4> scenes
+  {{ &full_repaint, &scrolling_list, &moving_dialog, &rotozoomer }};
+  std::vector<bench::Result> results{};
+
+  for (auto scene : scenes)
+    results.push_back (bench::run(app, *scene, frames));
+
+  std::cout << "Rendering of " << frames << " frames on a headless "
+            << profile.name << " terminal ("
+            << profile.size.getWidth() << "x"
+            << profile.size.getHeight() << ")\n";
+
+  for (const auto& result : results)
+    bench::print (result);
+
+  if ( ! write_file.empty() )
+    bench::writeBaseline (write_file, results);
+
+  if ( ! baseline_file.empty()
+    && ! bench::compare(bench::readBaseline(baseline_file), results, tolerance) )
+    return EXIT_FAILURE;
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,240 @@
+/***********************************************************************
+* frowbandcompositor-test.cpp - FRowBandCompositor unit tests          *
+*                                                                      *
+* This file is part of the FINAL CUT widget toolkit                    *
+*                                                                      *
+* Copyright 2024 Markus Gans                                           *
+*                                                                      *
+* FINAL CUT is free software; you can redistribute it and/or modify    *
+* it under the terms of the GNU Lesser General Public License as       *
+* published by the Free Software Foundation; either version 3 of       *
+* the License, or (at your option) any later version.                  *
+*                                                                      *
+* FINAL CUT is distributed in the hope that it will be useful, but     *
+* WITHOUT ANY WARRANTY; without even the implied warranty of           *
+* MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the        *
+* GNU Lesser General Public License for more details.                  *
+*                                                                      *
+* You should have received a copy of the GNU Lesser General Public     *
+* License along with this program.  If not, see                        *
+* <http://www.gnu.org/licenses/>.                                      *
+***********************************************************************/
+
+#include <algorithm>
+#include <mutex>
+#include <vector>
+
+#include <cppunit/BriefTestProgressListener.h>
+#include <cppunit/CompilerOutputter.h>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cppunit/TestFixture.h>
+#include <cppunit/TestResult.h>
+#include <cppunit/TestResultCollector.h>
+#include <cppunit/TestRunner.h>
+
+#include <final/final.h>
+
+//----------------------------------------------------------------------
+// class FRowBandCompositorTest
+//----------------------------------------------------------------------
+
+class FRowBandCompositorTest : public CPPUNIT_NS::TestFixture
+{
+  public:
+    FRowBandCompositorTest() = default;
+
+  protected:
+    void classNameTest();
+    void noArgumentTest();
+    void bandTest();
+    void compositingTest();
+
+  private:
+    using Compositor = finalcut::FRowBandCompositor;
+    using LineCopy = Compositor::LineCopy;
+    using Screen = std::vector<finalcut::FChar>;
+
+    // Methods
+    static void compose (const LineCopy&);
+    static auto isEqual (const Screen&, const Screen&) -> bool;
+
+    // Adds code needed to register the test suite
+    CPPUNIT_TEST_SUITE (FRowBandCompositorTest);
+
+    // Add a methods to the test suite
+    CPPUNIT_TEST (classNameTest);
+    CPPUNIT_TEST (noArgumentTest);
+    CPPUNIT_TEST (bandTest);
+    CPPUNIT_TEST (compositingTest);
+
+    // End of test suite definition
+    CPPUNIT_TEST_SUITE_END();
+};
+
+//----------------------------------------------------------------------
+void FRowBandCompositorTest::compose (const LineCopy& line)
+{
+  // The result depends on the order of the layers
+
+  for (std::size_t x{0}; x < line.length; x++)
+  {
+    auto& dst = line.dst[x];
+
+    if ( line.transparent )
+      dst.ch[0] = wchar_t((uInt32(dst.ch[0]) * 31 + uInt32(line.src[x].ch[0])) % 65'521);
+    else
+      dst = line.src[x];
+  }
+}
+
+//----------------------------------------------------------------------
+auto FRowBandCompositorTest::isEqual (const Screen& lhs, const Screen& rhs) -> bool
+{
+  if ( lhs.size() != rhs.size() )
+    return false;
+
+  for (std::size_t n{0}; n < lhs.size(); n++)
+    if ( lhs[n].ch[0] != rhs[n].ch[0] )
+      return false;
+
+  return true;
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositorTest::classNameTest()
+{
+  const finalcut::FString& classname = Compositor::getClassName();
+  CPPUNIT_ASSERT ( classname == "FRowBandCompositor" );
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositorTest::noArgumentTest()
+{
+  Compositor compositor{};
+  CPPUNIT_ASSERT ( ! compositor.isEnabled() );
+  CPPUNIT_ASSERT ( ! compositor.isCollecting() );
+  CPPUNIT_ASSERT ( compositor.getMinimumCells() == Compositor::DEFAULT_MIN_CELLS );
+  CPPUNIT_ASSERT ( ! compositor.isParallel(500, 150) );
+
+  compositor.setThreadCount(4);
+  CPPUNIT_ASSERT ( compositor.getThreadCount() == 4 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(0) == 1 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(Compositor::MIN_BAND_HEIGHT) == 1 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(3 * Compositor::MIN_BAND_HEIGHT) == 3 );
+  CPPUNIT_ASSERT ( compositor.getBandCount(150) == 4 );
+
+  // The serial path stays active for small terminals
+  compositor.enable();
+  CPPUNIT_ASSERT ( compositor.isEnabled() );
+  CPPUNIT_ASSERT ( compositor.isParallel(500, 150) );
+  CPPUNIT_ASSERT ( ! compositor.isParallel(80, 24) );
+  compositor.setMinimumCells(0);
+  CPPUNIT_ASSERT ( compositor.isParallel(80, 24) );
+  CPPUNIT_ASSERT ( ! compositor.isParallel(80, Compositor::MIN_BAND_HEIGHT) );
+
+  compositor.setThreadCount(1);
+  CPPUNIT_ASSERT ( ! compositor.isParallel(500, 150) );
+  compositor.setThreadCount(0);  // Number of hardware threads
+  CPPUNIT_ASSERT ( compositor.getThreadCount() > 0 );
+  compositor.disable();
+  CPPUNIT_ASSERT ( ! compositor.isEnabled() );
+  CPPUNIT_ASSERT ( ! compositor.isParallel(500, 150) );
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositorTest::bandTest()
+{
+  Compositor compositor{};
+  compositor.setThreadCount(4);
+  std::mutex mutex{};
+
+  for (std::size_t rows : {0U, 7U, 24U, 150U, 1001U})
+  {
+    for (int run{0}; run < 20; run++)
+    {
+      // Every row belongs to exactly one band
+      std::vector<int> visits(rows, 0);
+      std::size_t band_count{0};
+
+      compositor.forEachBand ( rows
+                             , [&mutex, &visits, &band_count] (std::size_t first, std::size_t last)
+                               {
+                                 std::lock_guard<std::mutex> lock{mutex};
+                                 band_count++;
+
+                                 for (auto y{first}; y < last; y++)
+                                   visits[y]++;
+                               } );
+
+      CPPUNIT_ASSERT ( band_count == compositor.getBandCount(rows) );
+
+      for (const auto& count : visits)
+        CPPUNIT_ASSERT ( count == 1 );
+    }
+  }
+}
+
+//----------------------------------------------------------------------
+void FRowBandCompositorTest::compositingTest()
+{
+  constexpr std::size_t width{50};
+  constexpr std::size_t height{150};
+  constexpr std::size_t layers{12};
+  Compositor compositor{};
+  compositor.setThreadCount(4);
+  compositor.setMinimumCells(0);
+  compositor.enable();
+  CPPUNIT_ASSERT ( compositor.isParallel(width, height) );
+
+  // Overlapping layers with opaque and transparent lines
+  std::vector<Screen> areas(layers, Screen(width * height));
+
+  for (std::size_t layer{0}; layer < layers; layer++)
+    for (std::size_t n{0}; n < width * height; n++)
+      areas[layer][n].ch[0] = wchar_t(L'A' + (n * 7 + layer * 13) % 58);
+
+  auto add_layers = [&areas] (Screen& screen, const Compositor::LineHandler& handler)
+  {
+    for (std::size_t layer{0}; layer < layers; layer++)
+    {
+      const auto top = (layer * 11) % height;
+      const auto left = (layer * 3) % width;
+
+      const auto bottom = std::min(top + 40, std::size_t(height));
+
+      for (auto y{top}; y < bottom; y++)
+      {
+        const auto offset = y * width + left;
+        const bool transparent = (y + layer) % 3 == 0;
+        handler ({ &areas[layer][offset], &screen[offset]
+                 , width - left, y, transparent });
+      }
+    }
+  };
+
+  Screen serial(width * height);
+  add_layers (serial, &FRowBandCompositorTest::compose);
+
+  // Repeated runs must produce the same result as the serial path
+  for (int run{0}; run < 10; run++)
+  {
+    Screen parallel(width * height);
+    compositor.begin(height, layers);
+    CPPUNIT_ASSERT ( compositor.isCollecting() );
+    add_layers (parallel, [&compositor] (const LineCopy& line)
+                          {
+                            compositor.addLine(line);
+                          });
+    CPPUNIT_ASSERT ( isEqual(parallel, Screen(width * height)) );
+    compositor.finish (&FRowBandCompositorTest::compose);
+    CPPUNIT_ASSERT ( ! compositor.isCollecting() );
+    CPPUNIT_ASSERT ( isEqual(parallel, serial) );
+  }
+}
+
+
+// Put the test suite in the registry
+CPPUNIT_TEST_SUITE_REGISTRATION (FRowBandCompositorTest);
+
+// The general unit test main part
+#include <main-test.inc>
@@ -994,6 +994,22 @@ void FTermFunctionsTest::FullWidthHalfWidthTest()
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"1234567 one ＣＵＴ more") == 23 );
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"o\U0000031b\U00000323=\U00001ee3") == 3 );
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"STARGΛ̊TE") == 8 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"The quick brown fox jumps over the lazy dog") == 43 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"The quick brown fox 你好 over the lazy dog") == 42 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"0123456789abcdef\U0001f600") == 18 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"0123456789abcde\U00000300f") == 16 );
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"0123456789abcdef", 15) == 15 );
+
+  // Column width from the Unicode width table
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L'\U0001f600') == 2 );  // Emoji
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L'\U00020000') == 2 );  // CJK ideograph extension B
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L'\U0000200b') == 0 );  // Zero width space
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L'\U000000ad') == 1 );  // Soft hyphen
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L'\U00001160') == 0 );  // Hangul jungseong filler
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L'\U000000a7') == 1 );  // Ambiguous width
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(L'\U0010ffff') == 0 );  // Noncharacter
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(wchar_t(0x110000)) == 0 );  // Out of range
+  CPPUNIT_ASSERT ( finalcut::getColumnWidth(wchar_t(finalcut::UniChar::NF_check_mark)) == 1 );
 
   // Column width (FString) with end position
   CPPUNIT_ASSERT ( finalcut::getColumnWidth(L"\v\t 100", 0) == 0 );
@@ -75,6 +75,7 @@ class FSystemTest : public finalcut::FSystem
     auto fclose (FILE*) -> int override;
     auto fputs (const char*, FILE*) -> int override;
     auto putchar (int) -> int override;
+    auto writev (int, const struct iovec*, int) -> ssize_t override;
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction*) -> int override;
     auto timer_create ( clockid_t, struct sigevent*
@@ -561,6 +562,22 @@ auto FSystemTest::putchar (int c) -> int
   return 1;
 }
 
+//----------------------------------------------------------------------
+auto FSystemTest::writev (int fd, const struct iovec* iov, int iovcnt) -> ssize_t
+{
+  std::cerr << "Call: writev (" << fd << ", " << iov << ", " << iovcnt << ")\n";
+  ssize_t count{0};
+
+  for (int i{0}; i < iovcnt; i++)
+  {
+    const auto* data = static_cast<const char*>(iov[i].iov_base);
+    characters.append(data, iov[i].iov_len);
+    count += ssize_t(iov[i].iov_len);
+  }
+
+  return count;
+}
+
 //----------------------------------------------------------------------
 auto FSystemTest::sigaction ( int, const struct sigaction*
                             , struct sigaction* ) -> int
@@ -34,6 +34,8 @@
 #undef row_address      // from term.h
 #undef tab              // from term.h
 
+#include <sys/uio.h>
+
 #include <limits>
 #include <string>
 
@@ -75,6 +77,7 @@ class FSystemTest : public finalcut::FSystem
     auto fputs (const char*, FILE*) -> int override;
     auto fclose (FILE*) -> int override;
     auto putchar (int) -> int override;
+    auto writev (int, const struct iovec*, int) -> ssize_t override;
     auto sigaction ( int, const struct sigaction*
                    , struct sigaction*) -> int override;
     auto timer_create ( clockid_t, struct sigevent*
@@ -279,6 +282,12 @@ auto FSystemTest::putchar (int c) -> int
 #endif
 }
 
+//----------------------------------------------------------------------
+auto FSystemTest::writev (int fd, const struct iovec* iov, int iovcnt) -> ssize_t
+{
+  return ::writev(fd, iov, iovcnt);
+}
+
 //----------------------------------------------------------------------
 auto FSystemTest::sigaction ( int, const struct sigaction*
                             , struct sigaction* ) -> int
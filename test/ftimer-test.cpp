@@ -114,6 +114,8 @@ class FTimerTest : public CPPUNIT_NS::TestFixture
     void classNameTest();
     void timeTest();
     void timerTest();
+    void nextTimeoutTest();
+    void timerOrderTest();
     void performTimerActionTest();
 
   private:
@@ -124,6 +126,8 @@ class FTimerTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (classNameTest);
     CPPUNIT_TEST (timeTest);
     CPPUNIT_TEST (timerTest);
+    CPPUNIT_TEST (nextTimeoutTest);
+    CPPUNIT_TEST (timerOrderTest);
     CPPUNIT_TEST (performTimerActionTest);
 
     // End of test suite definition
@@ -276,6 +280,74 @@ void FTimerTest::timerTest()
   CPPUNIT_ASSERT ( ! t1.delTimer(-1) );
 }
 
+//----------------------------------------------------------------------
+void FTimerTest::nextTimeoutTest()
+{
+  test::FTimer_protected t1;
+  CPPUNIT_ASSERT ( t1.getTimerList()->empty() );
+  CPPUNIT_ASSERT ( finalcut::FObjectTimer::getNextTimeout() == TimeValue::max() );
+
+  const auto start = finalcut::FObjectTimer::getCurrentTime();
+  const int id1 = t1.addTimer(900);
+  const auto timeout1 = finalcut::FObjectTimer::getNextTimeout();
+  CPPUNIT_ASSERT ( timeout1 >= start + std::chrono::milliseconds(900) );
+  CPPUNIT_ASSERT ( timeout1 <= finalcut::FObjectTimer::getCurrentTime()
+                              + std::chrono::milliseconds(900) );
+
+  // The earliest timer determines the next timeout
+  const int id2 = t1.addTimer(300);
+  const auto timeout2 = finalcut::FObjectTimer::getNextTimeout();
+  CPPUNIT_ASSERT ( timeout2 < timeout1 );
+  CPPUNIT_ASSERT ( timeout2 >= start + std::chrono::milliseconds(300) );
+
+  t1.delTimer (id2);
+  CPPUNIT_ASSERT ( finalcut::FObjectTimer::getNextTimeout() == timeout1 );
+  t1.delTimer (id1);
+  CPPUNIT_ASSERT ( t1.getTimerList()->empty() );
+  CPPUNIT_ASSERT ( finalcut::FObjectTimer::getNextTimeout() == TimeValue::max() );
+}
+
+//----------------------------------------------------------------------
+void FTimerTest::timerOrderTest()
+{
+  test::FTimer_protected t1;
+  test::FTimer_protected t2;
+  std::vector<int> ids{};
+
+  for (int i{0}; i < 500; i++)
+  {
+    auto& t = ( i % 2 == 0 ) ? t1 : t2;
+    ids.push_back(t.addTimer(10000 + (i * 7919) % 5000));
+  }
+
+  CPPUNIT_ASSERT ( t1.getTimerList()->size() == 500 );
+
+  // Delete every third timer by its identifier number
+  for (std::size_t i{0}; i < ids.size(); i += 3)
+    CPPUNIT_ASSERT ( t1.delTimer(ids[i]) );
+
+  CPPUNIT_ASSERT ( t1.getTimerList()->size() == 333 );
+  CPPUNIT_ASSERT ( ! t1.delTimer(ids[0]) );
+
+  // Delete all timers of the second object
+  t2.delOwnTimers();
+  CPPUNIT_ASSERT ( t1.getTimerList()->size() == 166 );
+
+  // The remaining timers are removed in the order of their timeout
+  auto last_timeout = TimeValue{};
+
+  while ( ! t1.getTimerList()->empty() )
+  {
+    const auto& top = t1.getTimerList()->top();
+    CPPUNIT_ASSERT ( top.timeout == finalcut::FObjectTimer::getNextTimeout() );
+    CPPUNIT_ASSERT ( ! (top.timeout < last_timeout) );
+    last_timeout = top.timeout;
+    CPPUNIT_ASSERT ( t1.delTimer(top.id) );
+  }
+
+  CPPUNIT_ASSERT ( finalcut::FObjectTimer::getNextTimeout() == TimeValue::max() );
+}
+
 //----------------------------------------------------------------------
 void FTimerTest::performTimerActionTest()
 {
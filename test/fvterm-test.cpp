@@ -53,6 +53,31 @@ void setBellState (bool state = true)
   getBellState() = state;
 }
 
+//----------------------------------------------------------------------
+auto isScrolledAreaEqual ( finalcut::FVTerm::FTermArea* area1
+                         , finalcut::FVTerm::FTermArea* area2 ) -> bool
+{
+  // Compares the areas line by line, because
+  // scrolled lines are stored with a row offset
+
+  if ( ! area1 || ! area2
+    || area1->size.width != area2->size.width
+    || area1->shadow.width != area2->shadow.width
+    || area1->size.height != area2->size.height
+    || area1->shadow.height != area2->shadow.height )
+    return false;
+
+  const auto full_width = area1->size.width + area1->shadow.width;
+  const auto full_height = area1->size.height + area1->shadow.height;
+
+  for (auto y{0}; y < full_height; y++)
+    for (auto x{0}; x < full_width; x++)
+      if ( ! test::isFCharEqual (area1->getFChar(x, y), area2->getFChar(x, y)) )
+        return false;
+
+  return true;
+}
+
 
 //----------------------------------------------------------------------
 // class FTermOutputTest
@@ -76,6 +101,8 @@ class FTermOutputTest : public finalcut::FOutput
     auto getMaxColor() const -> int override;
     auto getEncoding() const -> finalcut::Encoding override;
     auto getKeyName (finalcut::FKey) const -> finalcut::FString override;
+    auto getFlushDeadline() const -> TimeValue override;
+    auto getFramePacing() const -> finalcut::FramePacing override;
 
     // Mutators
     void setCursor (finalcut::FPoint) override;
@@ -86,6 +113,8 @@ class FTermOutputTest : public finalcut::FOutput
     auto setVGAFont() -> bool override;
     auto setNewFont() -> bool override;
     void setNonBlockingRead (bool = true) override;
+    void setFramePacing (finalcut::FramePacing) override;
+    void setTargetFrameRate (uInt) override;
     static void setNoForce (bool = true);
 
     // Inquiries
@@ -100,6 +129,7 @@ class FTermOutputTest : public finalcut::FOutput
     auto hasHalfBlockCharacter() const -> bool override;
     auto hasShadowCharacter() const -> bool override;
     auto areMetaAndArrowKeysSupported() const -> bool override;
+    auto hasPendingOutput() const -> bool override;
 
     // Methods
     void initTerminal (finalcut::FVTerm::FTermArea*) override;
@@ -114,6 +144,7 @@ class FTermOutputTest : public finalcut::FOutput
     void clearTerminalState() override;
     auto clearTerminal (wchar_t = L' ') -> bool override;
     void flush() override;
+    void flushPendingOutput() override;
     void beep() const override;
 
   private:
@@ -131,6 +162,7 @@ class FTermOutputTest : public finalcut::FOutput
 
     // Data member
     bool                                 bell{false};
+    finalcut::FramePacing                frame_pacing{finalcut::FramePacing::Adaptive};
     static bool                          no_force;
     finalcut::FTerm                      fterm{};
     static finalcut::FVTerm::FTermArea*  vterm;
@@ -202,6 +234,18 @@ inline auto FTermOutputTest::getKeyName (finalcut::FKey keynum) const -> finalcu
   return keyboard.getKeyName (keynum);
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::getFlushDeadline() const -> TimeValue
+{
+  return TimeValue::max();
+}
+
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::getFramePacing() const -> finalcut::FramePacing
+{
+  return frame_pacing;
+}
+
 //----------------------------------------------------------------------
 inline auto FTermOutputTest::isCursorHideable() const -> bool
 {
@@ -268,6 +312,12 @@ inline auto FTermOutputTest::areMetaAndArrowKeysSupported() const -> bool
   return true;
 }
 
+//----------------------------------------------------------------------
+inline auto FTermOutputTest::hasPendingOutput() const -> bool
+{
+  return false;
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::setCursor (finalcut::FPoint)
 { }
@@ -309,6 +359,18 @@ inline void FTermOutputTest::setNonBlockingRead (bool enable)
   finalcut::FKeyboard::setReadBlockingTime (blocking_time);
 }
 
+//----------------------------------------------------------------------
+inline void FTermOutputTest::setFramePacing (finalcut::FramePacing pacing)
+{
+  frame_pacing = pacing;
+}
+
+//----------------------------------------------------------------------
+inline void FTermOutputTest::setTargetFrameRate (uInt)
+{
+  frame_pacing = finalcut::FramePacing::TargetRate;
+}
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::setNoForce (bool state)
 {
@@ -390,6 +452,10 @@ inline void FTermOutputTest::flush()
     CPPUNIT_ASSERT ( finalcut::FVTerm::isTerminalUpdateForced() );
 }
 
+//----------------------------------------------------------------------
+inline void FTermOutputTest::flushPendingOutput()
+{ }
+
 //----------------------------------------------------------------------
 inline void FTermOutputTest::beep() const
 {
@@ -474,6 +540,7 @@ class FVTerm_protected : public finalcut::FVTerm
     // Methods
     auto p_createArea (const finalcut::FVTerm::FShadowBox&) -> std::unique_ptr<finalcut::FVTerm::FTermArea>;
     auto p_createArea (const finalcut::FRect&) -> std::unique_ptr<finalcut::FVTerm::FTermArea>;
+    auto p_createCompactArea (const finalcut::FRect&) -> std::unique_ptr<finalcut::FVTerm::FTermArea>;
     void p_resizeArea (const finalcut::FVTerm::FShadowBox&, FTermArea*) const;
     void p_resizeArea (const finalcut::FRect&, FTermArea*) const;
     void p_restoreVTerm (const finalcut::FRect&) const;
@@ -642,6 +709,12 @@ inline auto FVTerm_protected::p_createArea (const finalcut::FRect& box) -> std::
   return finalcut::FVTerm::createArea (box);
 }
 
+//----------------------------------------------------------------------
+inline auto FVTerm_protected::p_createCompactArea (const finalcut::FRect& box) -> std::unique_ptr<finalcut::FVTerm::FTermArea>
+{
+  return finalcut::FVTerm::createCompactArea (box);
+}
+
 //----------------------------------------------------------------------
 inline void FVTerm_protected::p_resizeArea (const finalcut::FVTerm::FShadowBox& shadowbox, FTermArea* area) const
 {
@@ -657,12 +730,15 @@ inline void FVTerm_protected::p_resizeArea (const finalcut::FRect& box, FTermAre
 //----------------------------------------------------------------------
 inline void FVTerm_protected::p_restoreVTerm (const finalcut::FRect& box) const
 {
+  // The tests change the window areas directly
+  finalcut::FVTerm::invalidateOcclusionMap();
   finalcut::FVTerm::restoreVTerm (box);
 }
 
 //----------------------------------------------------------------------
 inline auto FVTerm_protected::p_updateVTermCursor (const FTermArea* area) const -> bool
 {
+  finalcut::FVTerm::invalidateOcclusionMap();
   return finalcut::FVTerm::updateVTermCursor (area);
 }
 
@@ -782,6 +858,9 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     void FVTermScrollTest();
     void FVTermOverlappingWindowsTest();
     void FVTermReduceUpdatesTest();
+    void FVTermLineShiftTest();
+    void FVTermOcclusionTest();
+    void FVTermCellPlanesTest();
     void getFVTermAreaTest();
 
   private:
@@ -798,6 +877,9 @@ class FVTermTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (FVTermScrollTest);
     CPPUNIT_TEST (FVTermOverlappingWindowsTest);
     CPPUNIT_TEST (FVTermReduceUpdatesTest);
+    CPPUNIT_TEST (FVTermLineShiftTest);
+    CPPUNIT_TEST (FVTermOcclusionTest);
+    CPPUNIT_TEST (FVTermCellPlanesTest);
     CPPUNIT_TEST (getFVTermAreaTest);
 
     // End of test suite definition
@@ -1951,6 +2033,38 @@ void FVTermTest::FVTermPrintTest()
     test_vwin_area->data[72] = test_vwin_area->data[71];
     CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
     test::printArea (vwin);
+
+    // FString with single-column character runs (direct area output)
+    // in comparison to the output over an FVTermBuffer
+    for (const auto& string : { finalcut::FString(L"Ab\tc äöx\U00000300y你\U0001f600ÿ-z\nend")
+                              , finalcut::FString(L"\U00000300.-|-._.-|-._.-|-._.-|-._.-|-._.-|-._"
+                                                  L".-|-._.-|-._.-|-._.-|-._.-|-._.-|-._.-|-._"
+                                                  L".-|-._.-|-._.-|-._.-|-._.-|-._.-|-._.-|-._")
+                              , finalcut::FString(L"\U00000301") })
+    {
+      auto direct_area_ptr = p_fvterm.p_createArea ({geometry, Shadow});
+      auto buffer_area_ptr = p_fvterm.p_createArea ({geometry, Shadow});
+      auto direct_area = direct_area_ptr.get();
+      auto buffer_area = buffer_area_ptr.get();
+      direct_area->setCursorPos(12, 7);
+      buffer_area->setCursorPos(12, 7);
+      finalcut::FVTermBuffer string_buffer{};
+      string_buffer.print(string);
+      const auto buffer_length = p_fvterm.print(buffer_area, string_buffer);
+      const auto direct_length = p_fvterm.print(direct_area, string);
+      CPPUNIT_ASSERT ( direct_length == buffer_length );
+      CPPUNIT_ASSERT ( direct_area->cursor.x == buffer_area->cursor.x );
+      CPPUNIT_ASSERT ( direct_area->cursor.y == buffer_area->cursor.y );
+      CPPUNIT_ASSERT ( direct_area->has_changes == buffer_area->has_changes );
+      CPPUNIT_ASSERT ( test::isAreaEqual(direct_area, buffer_area) );
+
+      for (auto i{0}; i < direct_area->size.height + direct_area->shadow.height; i++)
+      {
+        CPPUNIT_ASSERT ( direct_area->changes[i].xmin == buffer_area->changes[i].xmin );
+        CPPUNIT_ASSERT ( direct_area->changes[i].xmax == buffer_area->changes[i].xmax );
+        CPPUNIT_ASSERT ( direct_area->changes[i].trans_count == buffer_area->changes[i].trans_count );
+      }
+    }
   }  // Encoding loop
 }
 
@@ -2164,16 +2278,17 @@ void FVTermTest::FVTermScrollTest()
                                        {5, three_char},
                                        {5, four_char},
                                        {5, five_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaForward (vwin);
+  CPPUNIT_ASSERT ( vwin->row_offset == 1 );  // Lines were rotated
   test::printOnArea (test_vwin_area, { {5, two_char},
                                        {5, three_char},
                                        {5, four_char},
                                        {5, five_char},
                                        {5, space_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaForward (vwin);
@@ -2182,7 +2297,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, five_char},
                                        {5, space_char},
                                        {5, space_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaForward (vwin);
@@ -2191,7 +2306,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, space_char},
                                        {5, space_char},
                                        {5, space_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaForward (vwin);
@@ -2200,7 +2315,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, space_char},
                                        {5, space_char},
                                        {5, space_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaForward (vwin);
@@ -2209,7 +2324,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, space_char},
                                        {5, space_char},
                                        {5, space_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   // Scroll reverse
@@ -2221,7 +2336,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, three_char},
                                        {5, four_char},
                                        {5, five_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaReverse (vwin);
@@ -2230,7 +2345,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, two_char},
                                        {5, three_char},
                                        {5, four_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaReverse (vwin);
@@ -2239,7 +2354,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, one_char},
                                        {5, two_char},
                                        {5, three_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaReverse (vwin);
@@ -2248,7 +2363,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, space_char},
                                        {5, one_char},
                                        {5, two_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaReverse (vwin);
@@ -2257,7 +2372,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, space_char},
                                        {5, space_char},
                                        {5, one_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   p_fvterm.p_scrollAreaReverse (vwin);
@@ -2266,7 +2381,7 @@ void FVTermTest::FVTermScrollTest()
                                        {5, space_char},
                                        {5, space_char},
                                        {5, space_char} } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vwin_area, vwin) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vwin_area, vwin) );
   test::printArea (vwin);
 
   // vdesktop scrolling
@@ -2293,7 +2408,7 @@ void FVTermTest::FVTermScrollTest()
                                       { 5, { {80, space_char} } },
                                       { 1, { {80, one_char} } },
                                       { 6, { {80, space_char} } } } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vdesktop, vdesktop) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vdesktop, vdesktop) );
   test::printArea (vdesktop);
 
   FTermOutputTest::setNoForce(true);
@@ -2306,7 +2421,7 @@ void FVTermTest::FVTermScrollTest()
                                       { 5, { {80, space_char} } },
                                       { 1, { {80, one_char} } },
                                       { 7, { {80, space_char} } } } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vdesktop, vdesktop) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vdesktop, vdesktop) );
   test::printArea (vdesktop);
 
   FTermOutputTest::setNoForce(true);
@@ -2320,7 +2435,7 @@ void FVTermTest::FVTermScrollTest()
                                       { 5, { {80, space_char} } },
                                       { 1, { {80, one_char} } },
                                       { 9, { {80, space_char} } } } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vdesktop, vdesktop) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vdesktop, vdesktop) );
   test::printArea (vdesktop);
 
   FTermOutputTest::setNoForce(true);
@@ -2333,7 +2448,7 @@ void FVTermTest::FVTermScrollTest()
                                       { 5, { {80, space_char} } },
                                       { 1, { {80, one_char} } },
                                       { 8, { {80, space_char} } } } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vdesktop, vdesktop) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vdesktop, vdesktop) );
   test::printArea (vdesktop);
 
   for (auto i{0}; i < 6; i++)
@@ -2350,7 +2465,7 @@ void FVTermTest::FVTermScrollTest()
                                       { 5, { {80, space_char} } },
                                       { 1, { {80, one_char} } },
                                       { 2, { {80, space_char} } } } );
-  CPPUNIT_ASSERT ( test::isAreaEqual(test_vdesktop, vdesktop) );
+  CPPUNIT_ASSERT ( isScrolledAreaEqual(test_vdesktop, vdesktop) );
   test::printArea (vdesktop);
 }
 
@@ -2889,6 +3004,332 @@ void FVTermTest::FVTermReduceUpdatesTest()
   }
 }
 
+//----------------------------------------------------------------------
+void FVTermTest::FVTermLineShiftTest()
+{
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+
+  // unique virtual terminal
+  auto vterm = p_fvterm.p_getVirtualTerminal();
+
+  // virtual windows
+  auto vwin = p_fvterm.getVWin();
+
+  // Create the virtual windows for the p_fvterm objects
+  finalcut::FRect geometry {finalcut::FPoint{0, 0}, finalcut::FSize{15, 15}};
+  auto vwin_ptr = p_fvterm.p_createArea (geometry);
+  vwin = vwin_ptr.get();
+  p_fvterm.setVWin(std::move(vwin_ptr));
+
+  const auto print_lines = [&p_fvterm] (wchar_t first_char)
+  {
+    p_fvterm.print() << finalcut::FPoint{1, 1};
+
+    for (auto i{0}; i < 15; i++)
+      p_fvterm.print() << std::wstring(15, wchar_t(first_char + i));
+  };
+
+  print_lines (L'A');  // Lines "AAA..." to "OOO..."
+  vwin->visible = true;
+  p_fvterm.p_addLayer(vwin);
+  p_fvterm.p_processTerminalUpdate();
+
+  finalcut::FApplication::start();
+  finalcut::FApplication fapp(0, nullptr);
+  p_fvterm.p_finishDrawing();
+  p_fvterm.updateTerminal();
+
+  const auto reset_changes = [&vterm] ()
+  {
+    for (auto y{0}; y < vterm->size.height; y++)
+    {
+      vterm->changes[y].xmin = uInt(vterm->size.width);
+      vterm->changes[y].xmax = 0;
+    }
+  };
+
+  // No moved lines
+  reset_changes();
+  auto shift = finalcut::FVTerm::findTerminalLineShift(4);
+  CPPUNIT_ASSERT ( shift.distance == 0 );
+
+  // Scroll up by one line
+  print_lines (L'B');  // Lines "BBB..." to "PPP..."
+  p_fvterm.p_addLayer(vwin);
+  shift = finalcut::FVTerm::findTerminalLineShift(4);
+  CPPUNIT_ASSERT ( shift.top == 0 );
+  CPPUNIT_ASSERT ( shift.bottom == 14 );
+  CPPUNIT_ASSERT ( shift.distance == 1 );
+  CPPUNIT_ASSERT ( shift.savings > 0 );
+
+  finalcut::FVTerm::shiftTerminalLines(shift);
+
+  for (auto y{0}; y < 15; y++)
+  {
+    CPPUNIT_ASSERT ( vterm->changes[y].xmin == 0 );
+    CPPUNIT_ASSERT ( vterm->changes[y].xmax == 79 );
+  }
+
+  for (auto y{15}; y < vterm->size.height; y++)
+    CPPUNIT_ASSERT ( vterm->changes[y].xmin > vterm->changes[y].xmax );
+
+  // The shifted terminal lines are now in place
+  shift = finalcut::FVTerm::findTerminalLineShift(4);
+  CPPUNIT_ASSERT ( shift.distance == 0 );
+
+  p_fvterm.updateTerminal();
+  reset_changes();
+
+  // Scroll down by two lines in the lower part
+  p_fvterm.print() << finalcut::FPoint{1, 6};
+
+  for (auto i{0}; i < 10; i++)
+    p_fvterm.print() << std::wstring(15, wchar_t(L'a' + i));
+
+  p_fvterm.p_addLayer(vwin);
+  p_fvterm.updateTerminal();
+  reset_changes();
+  p_fvterm.print() << finalcut::FPoint{1, 6}
+                   << std::wstring(15, L'-')
+                   << std::wstring(15, L'-');
+
+  for (auto i{0}; i < 8; i++)
+    p_fvterm.print() << std::wstring(15, wchar_t(L'a' + i));
+
+  p_fvterm.p_addLayer(vwin);
+  shift = finalcut::FVTerm::findTerminalLineShift(4);
+  CPPUNIT_ASSERT ( shift.top == 5 );
+  CPPUNIT_ASSERT ( shift.bottom == 14 );
+  CPPUNIT_ASSERT ( shift.distance == -2 );
+  CPPUNIT_ASSERT ( shift.savings > 0 );
+
+  finalcut::FVTerm::shiftTerminalLines(shift);
+  shift = finalcut::FVTerm::findTerminalLineShift(4);
+  CPPUNIT_ASSERT ( shift.distance == 0 );
+
+  // A small change is cheaper to print than to scroll
+  p_fvterm.updateTerminal();
+  reset_changes();
+  p_fvterm.print() << finalcut::FPoint{1, 1}
+                   << std::wstring(1, L'C')
+                   << finalcut::FPoint{1, 2}
+                   << std::wstring(1, L'D');
+  p_fvterm.p_addLayer(vwin);
+  shift = finalcut::FVTerm::findTerminalLineShift(4);
+  CPPUNIT_ASSERT ( shift.distance == 0 );
+
+  // A scrolled area records the distance instead of changed lines
+  p_fvterm.updateTerminal();
+  reset_changes();
+  p_fvterm.p_scrollAreaForward(vwin);
+  CPPUNIT_ASSERT ( vwin->row_offset == 1 );
+  CPPUNIT_ASSERT ( vwin->scroll_distance == 1 );
+
+  for (auto y{0}; y < 14; y++)
+    CPPUNIT_ASSERT ( vwin->changes[y].xmin > vwin->changes[y].xmax );
+
+  CPPUNIT_ASSERT ( vwin->changes[14].xmin == 0 );
+  CPPUNIT_ASSERT ( vwin->changes[14].xmax == 14 );
+
+  p_fvterm.p_addLayer(vwin);
+  CPPUNIT_ASSERT ( vwin->scroll_distance == 0 );
+  CPPUNIT_ASSERT ( vterm->scroll_distance == 1 );
+  shift = finalcut::FVTerm::findTerminalLineShift(4);
+  CPPUNIT_ASSERT ( vterm->scroll_distance == 0 );
+  CPPUNIT_ASSERT ( shift.top == 0 );
+  CPPUNIT_ASSERT ( shift.bottom == 14 );
+  CPPUNIT_ASSERT ( shift.distance == 1 );
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermOcclusionTest()
+{
+  FVTerm_protected p_fvterm_1(finalcut::outputClass<FTermOutputTest>{});
+  FVTerm_protected p_fvterm_2(finalcut::outputClass<FTermOutputTest>{});
+
+  // unique virtual terminal and virtual desktop
+  auto vterm = p_fvterm_1.p_getVirtualTerminal();
+  auto vdesktop = p_fvterm_1.p_getVirtualDesktop();
+
+  // Create the virtual windows for the p_fvterm_1..2 objects
+  finalcut::FRect geometry_1 {finalcut::FPoint{0, 0}, finalcut::FSize{20, 10}};
+  finalcut::FRect geometry_2 {finalcut::FPoint{10, 5}, finalcut::FSize{20, 10}};
+  auto vwin_1_ptr = p_fvterm_1.p_createArea (geometry_1);
+  auto vwin_2_ptr = p_fvterm_2.p_createArea (geometry_2);
+  auto vwin_1 = vwin_1_ptr.get();
+  auto vwin_2 = vwin_2_ptr.get();
+  p_fvterm_1.setVWin(std::move(vwin_1_ptr));
+  p_fvterm_2.setVWin(std::move(vwin_2_ptr));
+  auto win_list = finalcut::FVTerm::getWindowList();
+  CPPUNIT_ASSERT ( win_list->empty() );
+  win_list->push_back(&p_fvterm_1);
+  win_list->push_back(&p_fvterm_2);
+  p_fvterm_1.p_determineWindowLayers();
+
+  p_fvterm_1.print() << finalcut::FPoint{1, 1};
+
+  for (auto i{0}; i < 10; i++)
+    p_fvterm_1.print() << std::wstring(20, L'A');
+
+  p_fvterm_2.print() << finalcut::FPoint{11, 6};
+
+  for (auto i{0}; i < 10; i++)
+    p_fvterm_2.print() << std::wstring(20, L'B');
+
+  vwin_1->visible = true;
+  vwin_2->visible = true;
+  p_fvterm_1.p_restoreVTerm ({finalcut::FPoint{1, 1}, finalcut::FSize{80, 24}});
+  CPPUNIT_ASSERT ( vterm->getFChar(5, 2).ch[0] == L'A' );
+  CPPUNIT_ASSERT ( vterm->getFChar(15, 7).ch[0] == L'B' );
+  CPPUNIT_ASSERT ( vterm->getFChar(25, 12).ch[0] == L'B' );
+  CPPUNIT_ASSERT ( vterm->getFChar(35, 2).ch[0] == L' ' );
+
+  // Only the top-most opaque window is reprinted
+  vdesktop->has_changes = false;
+  vwin_1->has_changes = false;
+  vwin_2->has_changes = false;
+  p_fvterm_1.p_restoreVTerm ({finalcut::FPoint{11, 6}, finalcut::FSize{10, 5}});
+  CPPUNIT_ASSERT ( ! vdesktop->has_changes );
+  CPPUNIT_ASSERT ( ! vwin_1->has_changes );
+  CPPUNIT_ASSERT ( vwin_2->has_changes );
+  CPPUNIT_ASSERT ( vterm->getFChar(15, 7).ch[0] == L'B' );
+
+  // A transparent cell also reprints the layers below
+  p_fvterm_2.print() << finalcut::FPoint{16, 8}
+                     << finalcut::FStyle {finalcut::Style::Transparent}
+                     << L' '
+                     << finalcut::FStyle {finalcut::Style::None};
+  vwin_2->has_changes = false;
+  p_fvterm_1.p_restoreVTerm ({finalcut::FPoint{11, 6}, finalcut::FSize{10, 5}});
+  CPPUNIT_ASSERT ( vdesktop->has_changes );
+  CPPUNIT_ASSERT ( vwin_1->has_changes );
+  CPPUNIT_ASSERT ( vwin_2->has_changes );
+  CPPUNIT_ASSERT ( vterm->getFChar(15, 7).ch[0] == L'A' );
+  CPPUNIT_ASSERT ( vterm->getFChar(16, 7).ch[0] == L'B' );
+
+  // Raised window
+  win_list->clear();
+  win_list->push_back(&p_fvterm_2);
+  win_list->push_back(&p_fvterm_1);
+  p_fvterm_1.p_determineWindowLayers();
+  p_fvterm_1.p_restoreVTerm ({finalcut::FPoint{11, 6}, finalcut::FSize{10, 5}});
+  CPPUNIT_ASSERT ( vterm->getFChar(16, 7).ch[0] == L'A' );
+  CPPUNIT_ASSERT ( vterm->getFChar(20, 7).ch[0] == L'B' );
+
+  // Moved window
+  const finalcut::FRect old_geometry {finalcut::FPoint{1, 1}, finalcut::FSize{20, 10}};
+  vwin_1->position.x = 50;
+  p_fvterm_1.p_restoreVTerm (old_geometry);
+  p_fvterm_1.p_restoreVTerm ({finalcut::FPoint{51, 1}, finalcut::FSize{20, 10}});
+  CPPUNIT_ASSERT ( vterm->getFChar(5, 2).ch[0] == L' ' );
+  CPPUNIT_ASSERT ( vterm->getFChar(16, 7).ch[0] == L'B' );
+  CPPUNIT_ASSERT ( vterm->getFChar(55, 2).ch[0] == L'A' );
+
+  // Hidden window
+  vwin_2->visible = false;
+  p_fvterm_1.p_restoreVTerm ({finalcut::FPoint{11, 6}, finalcut::FSize{20, 10}});
+  CPPUNIT_ASSERT ( vterm->getFChar(16, 7).ch[0] == L' ' );
+  win_list->clear();
+}
+
+//----------------------------------------------------------------------
+void FVTermTest::FVTermCellPlanesTest()
+{
+  finalcut::FVTerm::FCellPlanes planes{};
+  CPPUNIT_ASSERT ( planes.getSize() == 0 );
+  planes.resize(4);
+  CPPUNIT_ASSERT ( planes.getSize() == 4 );
+  CPPUNIT_ASSERT ( planes.code.size() == 4 );
+  CPPUNIT_ASSERT ( planes.color.size() == 4 );
+  CPPUNIT_ASSERT ( planes.attr.size() == 4 );
+  CPPUNIT_ASSERT ( planes.graphemes.empty() );
+
+  finalcut::FChar space_char =
+  {
+    { { L' ',  L'\0', L'\0', L'\0', L'\0' } },
+    { { L'\0', L'\0', L'\0', L'\0', L'\0' } },
+    { { finalcut::FColor::Default, finalcut::FColor::Default } },
+    { { 0x00, 0x00, 0x08, 0x00} }  // byte 0..3
+  };
+  planes.fill (space_char);
+
+  for (std::size_t i{0}; i < planes.getSize(); i++)
+  {
+    CPPUNIT_ASSERT ( planes.isEqual(i, space_char) );
+    CPPUNIT_ASSERT ( planes.getFChar(i) == space_char );
+  }
+
+  // Single code point
+  finalcut::FChar a_char = space_char;
+  a_char.ch[0] = L'A';
+  a_char.color.pair.fg = finalcut::FColor::Red;
+  a_char.color.pair.bg = finalcut::FColor::Blue;
+  a_char.attr.bit.bold = true;
+  CPPUNIT_ASSERT ( ! planes.isEqual(1, a_char) );
+  planes.setFChar (1, a_char);
+  CPPUNIT_ASSERT ( planes.isEqual(1, a_char) );
+  CPPUNIT_ASSERT ( ! planes.isEqual(0, a_char) );
+  CPPUNIT_ASSERT ( planes.code[1] == uInt32(L'A') );
+  CPPUNIT_ASSERT ( planes.graphemes.empty() );
+  CPPUNIT_ASSERT ( planes.getFChar(1) == a_char );
+  CPPUNIT_ASSERT ( planes.getFChar(1).attr.bit.bold );
+
+  // The encoded character is not part of the comparison
+  a_char.encoded_char[0] = L'B';
+  CPPUNIT_ASSERT ( planes.isEqual(1, a_char) );
+
+  // Attributes that are not relevant for the comparison
+  a_char.attr.bit.printed = true;
+  a_char.attr.bit.no_changes = true;
+  CPPUNIT_ASSERT ( planes.isEqual(1, a_char) );
+  a_char.attr.bit.underline = true;
+  CPPUNIT_ASSERT ( ! planes.isEqual(1, a_char) );
+  a_char.attr.bit.underline = false;
+  a_char.color.pair.bg = finalcut::FColor::Green;
+  CPPUNIT_ASSERT ( ! planes.isEqual(1, a_char) );
+
+  // Combining character sequence in the side table
+  finalcut::FChar combined_char = space_char;
+  combined_char.ch[0] = L'e';
+  combined_char.ch[1] = L'\U00000301';  // Combining acute accent
+  planes.setFChar (2, combined_char);
+  CPPUNIT_ASSERT ( planes.graphemes.size() == 1 );
+  CPPUNIT_ASSERT ( planes.code[2] & finalcut::FVTerm::FCellPlanes::GRAPHEME_INDEX );
+  CPPUNIT_ASSERT ( planes.isEqual(2, combined_char) );
+  CPPUNIT_ASSERT ( planes.getFChar(2) == combined_char );
+  finalcut::FChar e_char = space_char;
+  e_char.ch[0] = L'e';
+  CPPUNIT_ASSERT ( ! planes.isEqual(2, e_char) );
+  planes.setFChar (3, e_char);
+  CPPUNIT_ASSERT ( planes.isEqual(3, e_char) );
+  CPPUNIT_ASSERT ( ! planes.isEqual(3, combined_char) );
+
+  // Replace the entire content
+  std::vector<finalcut::FChar> line(4, e_char);
+  line[0] = combined_char;
+  planes.setFChars (line);
+  CPPUNIT_ASSERT ( planes.graphemes.size() == 1 );
+  CPPUNIT_ASSERT ( planes.isEqual(0, combined_char) );
+
+  for (std::size_t i{1}; i < planes.getSize(); i++)
+    CPPUNIT_ASSERT ( planes.isEqual(i, e_char) );
+
+  // The virtual terminal snapshot uses the compact layout
+  FVTerm_protected p_fvterm(finalcut::outputClass<FTermOutputTest>{});
+  const finalcut::FRect geometry {finalcut::FPoint{0, 0}, finalcut::FSize{8, 3}};
+  auto area = p_fvterm.p_createCompactArea(geometry);
+  CPPUNIT_ASSERT ( area->layout == finalcut::FVTerm::FTermArea::Layout::Planes );
+  CPPUNIT_ASSERT ( area->data.empty() );
+  CPPUNIT_ASSERT ( area->planes.getSize() == 24 );
+  CPPUNIT_ASSERT ( area->changes.size() == 3 );
+  CPPUNIT_ASSERT ( area->getIndex(2, 1) == 10 );
+  CPPUNIT_ASSERT ( area->planes.isEqual(area->getIndex(7, 2), space_char) );
+  p_fvterm.p_resizeArea ({finalcut::FPoint{0, 0}, finalcut::FSize{10, 4}}, area.get());
+  CPPUNIT_ASSERT ( area->data.empty() );
+  CPPUNIT_ASSERT ( area->planes.getSize() == 40 );
+  CPPUNIT_ASSERT ( area->planes.isEqual(area->getIndex(9, 3), space_char) );
+}
+
 //----------------------------------------------------------------------
 void FVTermTest::getFVTermAreaTest()
 {
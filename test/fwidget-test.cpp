@@ -20,6 +20,8 @@
 * <http://www.gnu.org/licenses/>.                                      *
 ***********************************************************************/
 
+#include <sys/uio.h>
+
 #include <limits>
 
 #include <cppunit/BriefTestProgressListener.h>
@@ -389,6 +391,7 @@ class FWidgetTest : public CPPUNIT_NS::TestFixture
     void PosAndSizeTest();
     void focusableChildrenTest();
     void closeWidgetTest();
+    void updateWidgetTest();
     void adjustSizeTest();
     void callbackTest();
 
@@ -407,6 +410,7 @@ class FWidgetTest : public CPPUNIT_NS::TestFixture
     CPPUNIT_TEST (PosAndSizeTest);
     CPPUNIT_TEST (focusableChildrenTest);
     CPPUNIT_TEST (closeWidgetTest);
+    CPPUNIT_TEST (updateWidgetTest);
     CPPUNIT_TEST (adjustSizeTest);
     CPPUNIT_TEST (callbackTest);
 
@@ -502,6 +506,11 @@ class FWidgetTest::FSystemTest : public finalcut::FSystem
 #endif
     }
 
+    auto writev (int fd, const struct iovec* iov, int iovcnt) -> ssize_t override
+    {
+      return ::writev(fd, iov, iovcnt);
+    }
+
     auto sigaction (int, const struct sigaction*, struct sigaction*) -> int override
     {
       return 0;
@@ -798,6 +807,14 @@ void FWidgetTest::noArgumentTest()
   CPPUNIT_ASSERT ( wdgt.getFlags().feature.no_border == false );
   CPPUNIT_ASSERT ( wdgt.getFlags().feature.no_underline == false );
   CPPUNIT_ASSERT ( wdgt.getFlags().feature.ignore_padding == false );
+  CPPUNIT_ASSERT ( wdgt.getFlags().feature.no_coalescing == false );
+  CPPUNIT_ASSERT ( wdgt.hasMoveCoalescing() );
+
+  wdgt.unsetMoveCoalescing();
+  CPPUNIT_ASSERT ( wdgt.getFlags().feature.no_coalescing == true );
+  CPPUNIT_ASSERT ( ! wdgt.hasMoveCoalescing() );
+  wdgt.setMoveCoalescing();
+  CPPUNIT_ASSERT ( wdgt.hasMoveCoalescing() );
 
   wdgt.setVisible(false);
   CPPUNIT_ASSERT ( wdgt.getFlags().visibility.visible == false );
@@ -2648,6 +2665,107 @@ void FWidgetTest::closeWidgetTest()
   CPPUNIT_ASSERT ( main_wdgt.getFlags().visibility.shown );
 }
 
+//----------------------------------------------------------------------
+void FWidgetTest::updateWidgetTest()
+{
+  finalcut::FWidget root_wdgt{};  // Root widget
+  finalcut::FWidget main_wdgt{&root_wdgt};  // Child / main widget
+  finalcut::FWidget::setMainWidget(&main_wdgt);
+  main_wdgt.setFlags().visibility.shown = true;
+
+  class TestWidget : public finalcut::FWidget
+  {
+    public:
+      explicit TestWidget (finalcut::FWidget* parent = nullptr)
+        : finalcut::FWidget{parent}
+      { }
+
+      TestWidget (const TestWidget&) = delete;
+
+      TestWidget (TestWidget&&) noexcept = delete;
+
+      ~TestWidget() override
+      { }
+
+      auto p_getWidgetUpdateList() -> finalcut::FWidget::FWidgetList*&
+      {
+        return finalcut::FWidget::getWidgetUpdateList();
+      }
+
+      void p_processUpdates()
+      {
+        finalcut::FWidget::processUpdates();
+      }
+
+      void draw() override
+      {
+        draw_count++;
+      }
+
+      // Data member
+      std::size_t draw_count{0};
+  };
+
+  TestWidget wdgt{&main_wdgt};  // Subchild
+  TestWidget sub_wdgt{&wdgt};  // Sub-subchild
+  wdgt.setGeometry (finalcut::FPoint{1, 1}, finalcut::FSize{20, 5});
+  sub_wdgt.setGeometry (finalcut::FPoint{2, 2}, finalcut::FSize{10, 1});
+  wdgt.setFlags().visibility.shown = true;
+  sub_wdgt.setFlags().visibility.shown = true;
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->empty() );
+
+  // Multiple updates are painted only once
+  wdgt.update();
+  wdgt.update();
+  wdgt.update (finalcut::FRect{finalcut::FPoint{3, 2}, finalcut::FSize{4, 2}});
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->size() == 1 );
+  CPPUNIT_ASSERT ( wdgt.draw_count == 0 );
+  CPPUNIT_ASSERT ( sub_wdgt.draw_count == 0 );
+  wdgt.p_processUpdates();
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->empty() );
+  CPPUNIT_ASSERT ( wdgt.draw_count == 1 );
+  CPPUNIT_ASSERT ( sub_wdgt.draw_count == 1 );
+
+  // The parent repaint includes the child
+  sub_wdgt.update();
+  wdgt.update();
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->size() == 2 );
+  wdgt.p_processUpdates();
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->empty() );
+  CPPUNIT_ASSERT ( wdgt.draw_count == 2 );
+  CPPUNIT_ASSERT ( sub_wdgt.draw_count == 2 );
+
+  // An immediate redraw satisfies the pending update
+  sub_wdgt.update();
+  sub_wdgt.redraw();
+  CPPUNIT_ASSERT ( sub_wdgt.draw_count == 3 );
+  wdgt.p_processUpdates();
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->empty() );
+  CPPUNIT_ASSERT ( sub_wdgt.draw_count == 3 );
+
+  // Regions outside the widget are ignored
+  sub_wdgt.update (finalcut::FRect{finalcut::FPoint{11, 1}, finalcut::FSize{5, 1}});
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->empty() );
+
+  // Hidden widgets are not painted
+  sub_wdgt.update();
+  sub_wdgt.setFlags().visibility.shown = false;
+  wdgt.p_processUpdates();
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->empty() );
+  CPPUNIT_ASSERT ( sub_wdgt.draw_count == 3 );
+  sub_wdgt.setFlags().visibility.shown = true;
+
+  // A deleted widget leaves the update list
+  {
+    TestWidget tmp_wdgt{&wdgt};
+    tmp_wdgt.setFlags().visibility.shown = true;
+    tmp_wdgt.update();
+    CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->size() == 1 );
+  }
+
+  CPPUNIT_ASSERT ( wdgt.p_getWidgetUpdateList()->empty() );
+}
+
 //----------------------------------------------------------------------
 void FWidgetTest::adjustSizeTest()
 {